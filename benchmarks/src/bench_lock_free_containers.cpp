@@ -3,6 +3,7 @@
  * @date 2025-08-08
  */
 
+#include <algorithm>
 #include <thread>
 
 #include <benchmark/benchmark.h>
@@ -10,13 +11,17 @@
 #include <folly/MPMCQueue.h>
 
 #include "config/server_config.hpp"
+#include "container_types.hpp"
+#include "containers/packed_spsc.hpp"
 #include "containers/sequenced_spsc.hpp"
 #include "containers/turbo_spsc.hpp"
 #include "containers/vyukov_mpmc.hpp"
 #include "primitive_types.hpp"
 #include "ptr_types.hpp"
+#include "transport/shm/shm_queue.hpp"
 #include "utils/spin_wait.hpp"
 #include "utils/string_utils.hpp"
+#include "utils/sync_utils.hpp"
 #include "utils/test_utils.hpp"
 #include "utils/thread_utils.hpp"
 
@@ -46,6 +51,15 @@ struct QueueAdapter<SequencedSPSC<N>> {
   static bool pop(Queue &q, T &val) { return q.read(val) > 0; }
 };
 
+template <>
+struct QueueAdapter<PackedSPSC<N * 64>> {
+  using Queue = PackedSPSC<N * 64>;
+
+  static UPtr<Queue> create() { return std::make_unique<Queue>(); }
+  static bool push(Queue &q, T val) { return q.write(val); }
+  static bool pop(Queue &q, T &val) { return q.read(val) > 0; }
+};
+
 template <>
 struct QueueAdapter<VyukovMPMC<T, N>> {
   using Queue = VyukovMPMC<T, N>;
@@ -132,9 +146,133 @@ static void BM_GenericQueue(benchmark::State &state) {
   benchmark::DoNotOptimize(produced);
 }
 
+/**
+ * @brief Same stream as BM_GenericQueue, but moved with writeBatch/readBatch of range(0) messages
+ */
+static void BM_SequencedSPSCBatch(benchmark::State &state) {
+  using Queue = SequencedSPSC<N>;
+  const size_t batchSize = state.range(0);
+  auto queue = std::make_unique<Queue>();
+
+  size_t produced{0};
+  std::atomic_size_t consumed = 0;
+
+  utils::pinThreadToCore(tests::getCore(cfg.data, 0));
+
+  std::jthread consumerThread{[&](std::stop_token token) {
+    utils::pinThreadToCore(tests::getCore(cfg.data, 1));
+
+    Vector<T> values(batchSize);
+    SpinWait waiter;
+    while (!token.stop_requested()) {
+      const size_t count = queue->readBatch(Span<T>{values});
+      if (count != 0) {
+        waiter.reset();
+        consumed.fetch_add(count, std::memory_order_release);
+      } else if (!++waiter) {
+        LOG_ERROR_SYSTEM("Failed to consume");
+        break;
+      }
+    }
+  }};
+
+  Vector<T> values(batchSize);
+  while (state.KeepRunningBatch(batchSize)) {
+    for (auto &value : values) {
+      value = produced++;
+    }
+    size_t written = 0;
+    SpinWait waiter;
+    while (written < batchSize) {
+      const size_t count =
+          queue->writeBatch(Span<const T>{values.data() + written, batchSize - written});
+      if (count != 0) {
+        written += count;
+      } else if (!++waiter) {
+        LOG_ERROR_SYSTEM("Failed to produce");
+        break;
+      }
+    }
+  }
+  SpinWait waiter;
+  while (consumed.load(std::memory_order_acquire) < produced) {
+    if (!++waiter) {
+      LOG_ERROR_SYSTEM("Failed to consume {}<{}", consumed.load(std::memory_order_acquire),
+                       produced);
+      break;
+    }
+  }
+  consumerThread.request_stop();
+  benchmark::DoNotOptimize(produced);
+}
+
+/**
+ * @brief Wake up latency of a consumer sleeping on range(0) shm queues, only the last one is written
+ * WaitAll sleeps on all the futexes with futex_waitv, otherwise only on the first one
+ * with a bounded wait, like ShmReactor did before
+ */
+template <bool WaitAll>
+static void BM_ShmQueueWakeup(benchmark::State &state) {
+  constexpr uint64_t BOUNDED_WAIT_NS = 100'000;
+  const size_t count = state.range(0);
+
+  Vector<UPtr<ShmQueue>> queues;
+  for (size_t i = 0; i < count; ++i) {
+    queues.push_back(std::make_unique<ShmQueue>());
+  }
+  ShmQueue &active = *queues.back();
+  std::atomic_size_t consumed = 0;
+
+  utils::pinThreadToCore(tests::getCore(cfg.data, 0));
+
+  std::jthread consumerThread{[&](std::stop_token token) {
+    utils::pinThreadToCore(tests::getCore(cfg.data, 1));
+
+    Vector<futex_waitv> waitv(count);
+    uint8_t buffer[ShmQueue::Queue::MAX_DATA_SIZE];
+    while (!token.stop_requested()) {
+      for (size_t i = 0; i < count; ++i) {
+        waitv[i] = makeWaitv(queues[i]->futex, queues[i]->prepareWait());
+      }
+      const bool pending =
+          std::ranges::any_of(queues, [](auto &q) { return !q->queue.empty(); });
+      if (!pending) {
+        if constexpr (WaitAll) {
+          waitForAny(Span<futex_waitv>{waitv});
+        } else {
+          futexWait(queues[0]->futex, waitv[0].val, BOUNDED_WAIT_NS);
+        }
+      }
+      for (auto &q : queues) {
+        q->cancelWait();
+        while (q->queue.readBatch(buffer, sizeof(buffer)) != 0) {
+          consumed.fetch_add(1, std::memory_order_release);
+        }
+      }
+    }
+  }};
+
+  size_t produced{0};
+  for (auto _ : state) {
+    active.queue.write(produced++);
+    active.notify();
+    while (consumed.load(std::memory_order_acquire) < produced) {
+      asm volatile("pause" ::: "memory");
+    }
+  }
+  consumerThread.request_stop();
+  active.queue.write(produced);
+  active.notify();
+  benchmark::DoNotOptimize(produced);
+}
+
 BENCHMARK_TEMPLATE(BM_GenericQueue, SequencedSPSC<N>);
+BENCHMARK_TEMPLATE(BM_GenericQueue, PackedSPSC<N * 64>);
 BENCHMARK_TEMPLATE(BM_GenericQueue, VyukovMPMC<T, N>);
 BENCHMARK_TEMPLATE(BM_GenericQueue, TurboSPSC<N>);
 BENCHMARK_TEMPLATE(BM_GenericQueue, boost::lockfree::queue<T>);
+BENCHMARK(BM_SequencedSPSCBatch)->Arg(1)->Arg(8)->Arg(32)->Arg(128);
+BENCHMARK_TEMPLATE(BM_ShmQueueWakeup, true)->Arg(2)->Arg(8)->Arg(16)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_ShmQueueWakeup, false)->Arg(2)->Arg(8)->Arg(16)->UseRealTime();
 
 } // namespace hft::benchmarks
@@ -8,6 +8,7 @@
 #include "bus/busable.hpp"
 #include "config/server_config.hpp"
 #include "container_types.hpp"
+#include "containers/hierarchical_bitmap.hpp"
 #include "domain/server_order_messages.hpp"
 #include "execution/orderbook/flat_order_book.hpp"
 #include "execution/orderbook/price_level_order_book.hpp"
@@ -17,6 +18,7 @@
 #include "traits.hpp"
 #include "utils/data_generator.hpp"
 #include "utils/rng.hpp"
+#include "utils/time_utils.hpp"
 
 namespace hft::benchmarks {
 
@@ -27,6 +29,7 @@ using namespace tests;
 class BM_OrderBookFix : public benchmark::Fixture {
 public:
   ServerConfig cfg;
+  NodePool pool{MAX_BOOK_ORDERS};
   uint64_t counter;
 
   inline static Vector<InternalOrderEvent> orders;
@@ -58,9 +61,10 @@ void BM_OrderBookFix::post<InternalOrderStatus>(CRef<InternalOrderStatus> s) {
 }
 
 BENCHMARK_F(BM_OrderBookFix, AddOrder)(benchmark::State &state) {
-  OrderBook book;
+  OrderBook book{pool};
   while (state.KeepRunningBatch(orders.size())) {
     book.clear();
+    pool.clear();
 
     for (auto &order : orders) {
       book.add(order, *this);
@@ -69,4 +73,108 @@ BENCHMARK_F(BM_OrderBookFix, AddOrder)(benchmark::State &state) {
   }
 }
 
+namespace {
+InternalOrderEvent makeEvent(Quantity qty, Price price, OrderAction action) {
+  return {{SystemOrderId::make(1, 1), BookOrderId{}, qty, price}, nullptr, 0, action};
+}
+
+void reportPercentiles(benchmark::State &state, Vector<uint64_t> &samples) {
+  if (samples.empty()) {
+    return;
+  }
+  std::sort(samples.begin(), samples.end());
+  state.counters["p50_cycles"] = samples[samples.size() / 2];
+  state.counters["p99_cycles"] = samples[samples.size() * 99 / 100];
+  state.counters["max_cycles"] = samples.back();
+}
+} // namespace
+
+/**
+ * @brief Sparse book with a single far level behind the top, every aggressor empties the top
+ * level so the next best ask has to be discovered across the whole tick range
+ */
+BENCHMARK_F(BM_OrderBookFix, SparseSweep)(benchmark::State &state) {
+  OrderBook book{pool};
+  const Price nearAsk = 1;
+  const Price farAsk = MAX_TICKS - 1;
+
+  book.add(makeEvent(1000000, farAsk, OrderAction::Sell), *this);
+
+  const auto topAsk = makeEvent(1, nearAsk, OrderAction::Sell);
+  const auto sweep = makeEvent(1, nearAsk, OrderAction::Buy);
+
+  Vector<uint64_t> samples;
+  samples.reserve(1 << 20);
+  for (auto _ : state) {
+    book.add(topAsk, *this);
+
+    const auto start = getCycles();
+    book.add(sweep, *this);
+    const auto end = getCycles();
+
+    if (samples.size() < samples.capacity()) {
+      samples.push_back(end - start);
+    }
+  }
+  benchmark::DoNotOptimize(counter);
+  reportPercentiles(state, samples);
+}
+
+namespace {
+/**
+ * @brief Reference word-by-word scan the order book used before the hierarchical mask
+ */
+template <uint32_t Bits>
+uint32_t linearFindNext(const uint64_t *mask, uint32_t from) {
+  constexpr uint32_t words = (Bits + 63) / 64;
+  const uint32_t startWord = from >> 6;
+  for (uint32_t i = startWord; i < words; ++i) {
+    uint64_t word = mask[i];
+    if (i == startWord) {
+      word &= ~0ULL << (from & 63);
+    }
+    if (word != 0) {
+      return (i << 6) + __builtin_ctzll(word);
+    }
+  }
+  return UINT32_MAX;
+}
+} // namespace
+
+/**
+ * @brief Next-best lookup on a sparse mask, one bit at each end of the range
+ */
+template <uint32_t Bits>
+static void BM_OccupancyLinearScan(benchmark::State &state) {
+  auto mask = std::make_unique<uint64_t[]>((Bits + 63) / 64);
+  mask[0] |= 1;
+  mask[(Bits - 1) >> 6] |= 1ULL << ((Bits - 1) & 63);
+
+  uint32_t from = 1;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(from);
+    auto result = linearFindNext<Bits>(mask.get(), from);
+    benchmark::DoNotOptimize(result);
+  }
+}
+
+template <uint32_t Bits>
+static void BM_OccupancyHierarchical(benchmark::State &state) {
+  auto mask = std::make_unique<HierarchicalBitmap<Bits>>();
+  mask->set(0);
+  mask->set(Bits - 1);
+
+  uint32_t from = 1;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(from);
+    auto result = mask->findNext(from);
+    benchmark::DoNotOptimize(result);
+  }
+}
+
+BENCHMARK_TEMPLATE(BM_OccupancyLinearScan, MAX_TICKS);
+BENCHMARK_TEMPLATE(BM_OccupancyHierarchical, MAX_TICKS);
+BENCHMARK_TEMPLATE(BM_OccupancyLinearScan, 1 << 18);
+BENCHMARK_TEMPLATE(BM_OccupancyHierarchical, 1 << 18);
+
 } // namespace hft::benchmarks
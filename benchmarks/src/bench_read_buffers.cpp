@@ -0,0 +1,101 @@
+/**
+ * @author Vladimir Pavliv
+ * @date 2026-02-21
+ */
+
+#include <algorithm>
+#include <cstring>
+
+#include <benchmark/benchmark.h>
+
+#include "container_types.hpp"
+#include "containers/mirrored_buffer.hpp"
+#include "containers/sliding_buffer.hpp"
+#include "primitive_types.hpp"
+#include "utils/rng.hpp"
+
+namespace hft::benchmarks {
+using namespace utils;
+
+namespace {
+constexpr size_t STREAM_SIZE{1ULL << 22};
+constexpr size_t CHUNK_COUNT{1ULL << 14};
+
+/**
+ * @brief Stream of u16 size prefixed frames, cut into chunks the way tcp reads come in
+ */
+struct FragmentedStream {
+  FragmentedStream(size_t maxFrame, size_t maxChunk) : stream(STREAM_SIZE) {
+    size_t pos = 0;
+    while (pos + sizeof(uint16_t) + maxFrame < STREAM_SIZE) {
+      const auto size = RNG::generate<uint16_t>(16, static_cast<uint16_t>(maxFrame));
+      std::memcpy(stream.data() + pos, &size, sizeof(size));
+      pos += sizeof(size) + size;
+    }
+    stream.resize(pos);
+    chunks.reserve(CHUNK_COUNT);
+    for (size_t i = 0; i < CHUNK_COUNT; ++i) {
+      chunks.push_back(RNG::generate<size_t>(1, maxChunk));
+    }
+  }
+
+  ByteBuffer stream;
+  Vector<size_t> chunks;
+};
+
+/**
+ * @brief Consumes whole frames only, same as Framer::unframe does
+ */
+inline size_t unframe(CByteSpan data) {
+  size_t pos = 0;
+  uint16_t size = 0;
+  while (data.size() - pos >= sizeof(size)) {
+    std::memcpy(&size, data.data() + pos, sizeof(size));
+    if (data.size() - pos - sizeof(size) < size) {
+      break;
+    }
+    benchmark::DoNotOptimize(data[pos + sizeof(size)]);
+    pos += sizeof(size) + size;
+  }
+  return pos;
+}
+
+template <typename BufferT>
+void readFragmented(benchmark::State &state) {
+  const FragmentedStream input(state.range(0), state.range(1));
+  BufferT buffer;
+  size_t streamPos = 0;
+  size_t chunkIdx = 0;
+  size_t bytes = 0;
+
+  for (auto _ : state) {
+    auto free = buffer.buffer();
+    const size_t chunk = std::min({input.chunks[chunkIdx], free.size(),
+                                   input.stream.size() - streamPos});
+    std::memcpy(free.data(), input.stream.data() + streamPos, chunk);
+    buffer.commitWrite(chunk);
+    buffer.commitRead(unframe(buffer.data()));
+
+    bytes += chunk;
+    streamPos += chunk;
+    chunkIdx = (chunkIdx + 1) & (CHUNK_COUNT - 1);
+    if (streamPos == input.stream.size()) {
+      streamPos = 0;
+      buffer.reset();
+    }
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(bytes));
+}
+} // namespace
+
+static void BM_ReadBufferSliding(benchmark::State &state) {
+  readFragmented<SlidingBuffer>(state);
+}
+BENCHMARK(BM_ReadBufferSliding)->Args({64, 1500})->Args({256, 4096})->Args({1024, 16384});
+
+static void BM_ReadBufferMirrored(benchmark::State &state) {
+  readFragmented<MirroredBuffer>(state);
+}
+BENCHMARK(BM_ReadBufferMirrored)->Args({64, 1500})->Args({256, 4096})->Args({1024, 16384});
+
+} // namespace hft::benchmarks
@@ -13,6 +13,7 @@
 #include "execution/orderbook/flat_order_book.hpp"
 #include "primitive_types.hpp"
 #include "serialization/fbs/fbs_domain_serializer.hpp"
+#include "serialization/raw/raw_domain_serializer.hpp"
 #include "serialization/sbe/sbe_domain_serializer.hpp"
 #include "traits.hpp"
 #include "utils/data_generator.hpp"
@@ -43,6 +44,47 @@ static void DISABLED_BM_FbsSerialize(benchmark::State &state) {
 }
 BENCHMARK(DISABLED_BM_FbsSerialize);
 
+static void DISABLED_BM_FbsSerializeStatus(benchmark::State &state) {
+  const OrderStatus status{genId(), genId(), 10, 500, OrderState::Partial};
+  ByteBuffer buffer(128);
+  size_t size{0};
+
+  for (auto _ : state) {
+    size = fbs::FbsDomainSerializer::serialize(status, buffer.data());
+  }
+
+  benchmark::DoNotOptimize(size);
+  benchmark::DoNotOptimize(&status);
+  benchmark::DoNotOptimize(&buffer);
+}
+BENCHMARK(DISABLED_BM_FbsSerializeStatus);
+
+/**
+ * @brief Former serialize path, builder per message, released and copied out
+ */
+static void DISABLED_BM_FbsSerializeStatusFreshBuilder(benchmark::State &state) {
+  using namespace serialization::gen::fbs::domain;
+  const OrderStatus status{genId(), genId(), 10, 500, OrderState::Partial};
+  ByteBuffer buffer(128);
+  size_t size{0};
+
+  for (auto _ : state) {
+    flatbuffers::FlatBufferBuilder builder;
+    const auto msg = CreateOrderStatus(builder, status.orderId, status.systemOrderId,
+                                       status.quantity, status.fillPrice,
+                                       fbs::convert(status.state));
+    builder.Finish(CreateMessage(builder, MessageUnion_OrderStatus, msg.Union()));
+    const auto serializedMsg = builder.Release();
+    std::memcpy(buffer.data(), serializedMsg.data(), serializedMsg.size());
+    size = serializedMsg.size();
+  }
+
+  benchmark::DoNotOptimize(size);
+  benchmark::DoNotOptimize(&status);
+  benchmark::DoNotOptimize(&buffer);
+}
+BENCHMARK(DISABLED_BM_FbsSerializeStatusFreshBuilder);
+
 static void DISABLED_BM_FbsDeserialize(benchmark::State &state) {
   using BusType = BusHub<MessageBus<Order>>;
 
@@ -98,4 +140,40 @@ static void DISABLED_BM_SbeDeserialize(benchmark::State &state) {
 }
 BENCHMARK(DISABLED_BM_SbeDeserialize);
 
+static void DISABLED_BM_RawSerialize(benchmark::State &state) {
+  const Order order = genOrder();
+  ByteBuffer buffer(128);
+  size_t size{0};
+
+  for (auto _ : state) {
+    size = raw::RawDomainSerializer::serialize(order, buffer.data());
+  }
+
+  benchmark::DoNotOptimize(size);
+  benchmark::DoNotOptimize(&order);
+  benchmark::DoNotOptimize(&buffer);
+}
+BENCHMARK(DISABLED_BM_RawSerialize);
+
+static void DISABLED_BM_RawDeserialize(benchmark::State &state) {
+  using BusType = BusHub<MessageBus<Order>>;
+
+  const Order order = genOrder();
+  ByteBuffer buffer(128);
+
+  BusType bus{cfg.data};
+  bus.subscribe(CRefHandler<Order>{});
+
+  size_t size = raw::RawDomainSerializer::serialize(order, buffer.data());
+
+  for (auto _ : state) {
+    auto res = raw::RawDomainSerializer::deserialize(buffer.data(), buffer.size(), bus);
+    assert(res);
+    size = *res;
+  }
+  benchmark::DoNotOptimize(&buffer);
+  benchmark::DoNotOptimize(size);
+}
+BENCHMARK(DISABLED_BM_RawDeserialize);
+
 } // namespace hft::benchmarks
@@ -46,6 +46,12 @@ void BM_ServerFix::SetUp(const ::benchmark::State &state) {
   if (workerCount > 4) {
     throw std::runtime_error("Too many workers");
   }
+  // zero keeps the configured ticker count, large counts show the routing cost
+  const size_t count = state.range(1) == 0 ? tickerCount : state.range(1);
+  if (count != tickers.tickers.size()) {
+    tickers.gen(count);
+    orders.gen(MAX_BOOK_ORDERS);
+  }
 
   cfg.coresApp.clear();
   cfg.coreNetwork = getCore(cfg.data, 0);
@@ -72,16 +78,11 @@ void BM_ServerFix::startBus() {
 }
 
 void BM_ServerFix::setupCoordinator() {
-  ThreadId id = 0;
-  for (auto &tkrData : marketData.marketData) {
-    tkrData.second.workerId = id;
-    if (++id == workerCount) {
-      id = 0;
-    }
-  }
+  // books of a worker share its node pool, so regenerate data for the new worker count
+  marketData.gen(workerCount);
 
   flag.clear();
-  coordinator = std::make_unique<Coordinator>(ctx, marketData.marketData);
+  coordinator = std::make_unique<Coordinator>(ctx, marketData.marketData, marketData.nodePools);
   coordinator->start();
   flag.wait(false);
 }
@@ -105,11 +106,30 @@ void BM_ServerFix::post(CRef<InternalOrderStatus> s) {
   }
 }
 
+void BM_ServerFix::post(CRef<InternalFillBatch> b) {
+  fillBatches.fetch_add(1, std::memory_order_relaxed);
+  makerFills.fetch_add(b.count, std::memory_order_relaxed);
+}
+
+void BM_ServerFix::post(CRef<LevelUpdateBurst> burst) {
+  levelUpdates.fetch_add(burst.levels.size(), std::memory_order_relaxed);
+}
+
 BENCHMARK_DEFINE_F(BM_ServerFix, InternalThroughput)(benchmark::State &state) {
-  state.SetLabel(std::to_string(state.range(0)) + " worker(s)");
+  // burst above one posts orders the way the gateway forwards an order batch
+  const size_t burst = state.range(2);
+  state.SetLabel(std::format("{} worker(s) {} tickers burst {}", state.range(0),
+                             tickers.tickers.size(), burst));
   const uint64_t ordersCount = orders.orders.size();
+  const Span<const InternalOrderEvent> allOrders{orders.orders};
 
   bus.subscribe(CRefHandler<InternalOrderStatus>::bind<BM_ServerFix, &BM_ServerFix::post>(this));
+  bus.subscribe(CRefHandler<InternalFillBatch>::bind<BM_ServerFix, &BM_ServerFix::post>(this));
+  bus.subscribe(CRefHandler<LevelUpdateBurst>::bind<BM_ServerFix, &BM_ServerFix::post>(this));
+
+  fillBatches.store(0, std::memory_order_relaxed);
+  makerFills.store(0, std::memory_order_relaxed);
+  levelUpdates.store(0, std::memory_order_relaxed);
 
   SpinWait waiter{SPIN_RETRIES_YIELD};
   while (state.KeepRunningBatch(ordersCount)) {
@@ -119,9 +139,16 @@ BENCHMARK_DEFINE_F(BM_ServerFix, InternalThroughput)(benchmark::State &state) {
     }
     processed.store(0, std::memory_order_release);
 
-    for (const auto &order : orders.orders) {
-      benchmark::DoNotOptimize(&order);
-      bus.post(order);
+    if (burst <= 1) {
+      for (const auto &order : orders.orders) {
+        benchmark::DoNotOptimize(&order);
+        bus.post(order);
+      }
+    } else {
+      for (size_t pos = 0; pos < allOrders.size(); pos += burst) {
+        const size_t count = std::min(burst, allOrders.size() - pos);
+        bus.post(InternalOrderBurst{allOrders.subspan(pos, count)});
+      }
     }
     benchmark::ClobberMemory();
 
@@ -147,14 +174,23 @@ BENCHMARK_DEFINE_F(BM_ServerFix, InternalThroughput)(benchmark::State &state) {
 
     waiter.reset();
   }
+  // maker fills are reported with batches, so this shows the extra gateway traffic per sweep
+  state.counters["maker_fills"] = benchmark::Counter(makerFills.load(), benchmark::Counter::kIsRate);
+  state.counters["fill_batches"] =
+      benchmark::Counter(fillBatches.load(), benchmark::Counter::kIsRate);
+  // depth updates are conflated per drained batch, so this is below the volume change rate
+  state.counters["level_updates"] =
+      benchmark::Counter(levelUpdates.load(), benchmark::Counter::kIsRate);
 }
 
 BENCHMARK_DEFINE_F(BM_ServerFix, InternalLatency)(benchmark::State &state) {
-  state.SetLabel(std::to_string(state.range(0)) + " worker(s)");
+  state.SetLabel(std::format("{} worker(s) {} tickers", state.range(0), tickers.tickers.size()));
 
   const uint64_t ordersCount = orders.orders.size();
 
   bus.subscribe(CRefHandler<InternalOrderStatus>::bind<BM_ServerFix, &BM_ServerFix::post>(this));
+  bus.subscribe(CRefHandler<InternalFillBatch>::bind<BM_ServerFix, &BM_ServerFix::post>(this));
+  bus.subscribe(CRefHandler<LevelUpdateBurst>::bind<BM_ServerFix, &BM_ServerFix::post>(this));
 
   SpinWait waiter;
   auto iter = orders.orders.begin();
@@ -189,17 +225,11 @@ BENCHMARK_DEFINE_F(BM_ServerFix, InternalLatency)(benchmark::State &state) {
 }
 
 BENCHMARK_REGISTER_F(BM_ServerFix, InternalThroughput)
-    ->Arg(1)
-    ->Arg(2)
-    ->Arg(3)
-    ->Arg(4)
+    ->ArgsProduct({{1, 2, 3, 4}, {0, 10000}, {1, ORDER_BATCH_CAPACITY}})
     ->Unit(benchmark::kNanosecond);
 
 BENCHMARK_REGISTER_F(BM_ServerFix, InternalLatency)
-    ->Arg(1)
-    ->Arg(2)
-    ->Arg(3)
-    ->Arg(4)
+    ->ArgsProduct({{1, 2, 3, 4}, {0, 10000}})
     ->Unit(benchmark::kNanosecond);
 
 } // namespace hft::benchmarks
@@ -41,6 +41,9 @@ public:
   tests::GenMarketData marketData;
 
   ALIGN_CL AtomicUInt64 processed;
+  ALIGN_CL AtomicUInt64 fillBatches;
+  ALIGN_CL AtomicUInt64 makerFills;
+  ALIGN_CL AtomicUInt64 levelUpdates;
   ALIGN_CL AtomicBool error;
   ALIGN_CL std::atomic_flag flag{ATOMIC_FLAG_INIT};
 
@@ -55,6 +58,8 @@ public:
 
   void post(const server::ComponentReady &s);
   void post(const server::InternalOrderStatus &s);
+  void post(const server::InternalFillBatch &b);
+  void post(const server::LevelUpdateBurst &b);
 };
 
 } // namespace hft::benchmarks
@@ -22,6 +22,18 @@ for arg in "$@"; do
     s|sock)
       CMAKE_ARGS="$CMAKE_ARGS -DCOMM_TYPE_SHM=OFF"
       ;;
+    u|uring)
+      CMAKE_ARGS="$CMAKE_ARGS -DCOMM_TYPE=URING"
+      ;;
+    sqpoll)
+      CMAKE_ARGS="$CMAKE_ARGS -DURING_SQPOLL=ON"
+      ;;
+    r|raw)
+      CMAKE_ARGS="$CMAKE_ARGS -DSERIALIZATION=RAW"
+      ;;
+    slots)
+      CMAKE_ARGS="$CMAKE_ARGS -DSHM_PACKED_QUEUE=OFF"
+      ;;
     p|profile)
       CMAKE_ARGS="$CMAKE_ARGS -DPROFILING=ON"
       ;;
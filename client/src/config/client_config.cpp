@@ -4,6 +4,7 @@
  */
 
 #include "client_config.hpp"
+#include "domain_types.hpp"
 #include "logging.hpp"
 #include "ptr_types.hpp"
 #include "utils/parse_utils.hpp"
@@ -51,6 +52,10 @@ ClientConfig::ClientConfig(CRef<String> fileName) : data{fileName} {
   tradeRate = data.get<size_t>("rates.trade_rate_us");
   monitorRate = data.get<size_t>("rates.monitor_rate_ms");
   telemetryTate = data.get<size_t>("rates.telemetry_ms");
+  orderBatch = data.get_optional<size_t>("rates.order_batch").value_or(1);
+  if (orderBatch == 0 || orderBatch > ORDER_BATCH_CAPACITY) {
+    throw std::runtime_error("Invalid order batch size");
+  }
 
   // Credentials
   name = data.get<String>("credentials.name");
@@ -64,6 +69,7 @@ void ClientConfig::print() const {
   LOG_INFO_SYSTEM("Url:{} TcpUp:{} TcpDown:{} Udp:{}", url, portTcpUp, portTcpDown, portUdp);
   LOG_INFO_SYSTEM("SystemCore:{} NetworkCore:{} AppCores:{} TradeRate:{}us", coreSystem.value_or(0),
                   coreNetwork.value_or(0), toString(coresApp), tradeRate);
+  LOG_INFO_SYSTEM("OrderBatch: {}", orderBatch);
   LOG_INFO_SYSTEM("LogOutput: {}", logOutput);
   LOG_INFO_SYSTEM("Name: {} Password: {}", name, password);
 }
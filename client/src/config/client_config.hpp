@@ -33,6 +33,8 @@ struct ClientConfig {
   uint32_t tradeRate;
   uint32_t monitorRate;
   uint32_t telemetryTate;
+  // new orders sent in one message, 1 sends them one by one
+  uint32_t orderBatch;
 
   // Credentials
   String name;
@@ -15,6 +15,7 @@
 #include "traits.hpp"
 #include "transport/channel.hpp"
 #include "transport/connection_status.hpp"
+#include "transport/price_batch.hpp"
 #include "types/functional_types.hpp"
 #include "utils/handler.hpp"
 #include "utils/id_utils.hpp"
@@ -30,7 +31,6 @@ class NetworkConnectionManager {
 
   using UpStreamChannel = Channel<StreamTransport, UpstreamBus>;
   using DownStreamChannel = Channel<StreamTransport, DownstreamBus>;
-  using DatagramChannel = Channel<DatagramTransport, DatagramBus>;
 
 public:
   NetworkConnectionManager(Context &ctx, IpcClient &ipcClient) : ctx_{ctx}, ipcClient_{ipcClient} {
@@ -40,6 +40,7 @@ public:
     ipcClient_.setDatagramClb(DatagramTHandler::bind<SelfT, &SelfT::onDatagram>(this));
 
     ctx_.bus.subscribe(CRefHandler<Order>::bind<SelfT, &SelfT::post>(this));
+    ctx_.bus.subscribe(CRefHandler<OrderBatch>::bind<SelfT, &SelfT::post>(this));
     ctx_.bus.subscribe(CRefHandler<LoginResponse>::bind<SelfT, &SelfT::post>(this));
     ctx_.bus.subscribe(CRefHandler<ConnectionStatusEvent>::bind<SelfT, &SelfT::post>(this));
   }
@@ -74,10 +75,45 @@ private:
   }
 
   void onDatagram(DatagramTransport &&transport) {
-    const auto id = utils::genConnectionId();
-    pricesChannel_ =
-        std::make_shared<DatagramChannel>(std::move(transport), id, DatagramBus{ctx_.bus});
-    pricesChannel_->read();
+    pricesTransport_ = std::make_unique<DatagramTransport>(std::move(transport));
+    readPrices();
+  }
+
+  void readPrices() {
+    ByteSpan span(reinterpret_cast<uint8_t *>(&feed_), sizeof(FeedDatagram));
+    pricesTransport_->asyncRx(span, [this](IoResult res) { onPrices(res); });
+  }
+
+  /**
+   * @brief Every datagram is a PriceBatch or a LevelBatch, prices go to the trade engine that
+   * keeps only the latest one per ticker, levels to its depth, lost batches of both kinds
+   * are counted by the sequencer
+   */
+  void onPrices(IoResult res) {
+    if (res.code == IoStatus::Closed) {
+      return;
+    }
+    if (res.code != IoStatus::Ok) {
+      LOG_ERROR_SYSTEM("Failed to read prices");
+    } else if (feed_.kind() == FeedKind::Levels) {
+      publish(feed_.levels, res.bytes);
+    } else {
+      publish(feed_.prices, res.bytes);
+    }
+    if (pricesTransport_) {
+      readPrices();
+    }
+  }
+
+  template <typename BatchT>
+  void publish(CRef<BatchT> batch, size_t bytes) {
+    if (!batch.valid(bytes)) {
+      LOG_ERROR("Malformed feed batch of {} bytes", bytes);
+    } else if (sequencer_.accept(batch.header.seq)) {
+      for (uint32_t idx = 0; idx < batch.header.count; ++idx) {
+        ctx_.bus.post(batch.items[idx]);
+      }
+    }
   }
 
   void post(CRef<ConnectionStatusEvent> event) {
@@ -127,7 +163,11 @@ private:
     token_.reset();
     upstreamChannel_.reset();
     downstreamChannel_.reset();
-    pricesChannel_.reset();
+    if (pricesTransport_) {
+      LOG_INFO_SYSTEM("Price batches lost: {}", sequencer_.lost());
+      pricesTransport_->close();
+      pricesTransport_.reset();
+    }
     state_ = ConnectionState::Disconnected;
     ctx_.bus.post(ServerConnectionState::Disconnected);
   }
@@ -138,6 +178,12 @@ private:
     }
   }
 
+  void post(CRef<OrderBatch> batch) {
+    if (upstreamChannel_) {
+      upstreamChannel_->write(batch);
+    }
+  }
+
 private:
   Context &ctx_;
 
@@ -145,7 +191,10 @@ private:
 
   SPtr<UpStreamChannel> upstreamChannel_;
   SPtr<DownStreamChannel> downstreamChannel_;
-  SPtr<DatagramChannel> pricesChannel_;
+  UPtr<DatagramTransport> pricesTransport_;
+
+  FeedDatagram feed_;
+  PriceSequencer sequencer_;
 
   Optional<Token> token_;
   ConnectionState state_{ConnectionState::Disconnected};
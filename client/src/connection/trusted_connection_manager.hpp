@@ -43,6 +43,7 @@ public:
     networkClient_.setDatagramClb(StreamTHandler::bind<SelfT, &SelfT::onDatagram>(this));
 
     ctx_.bus.subscribe(CRefHandler<Order>::bind<SelfT, &SelfT::post>(this));
+    ctx_.bus.subscribe(CRefHandler<OrderBatch>::bind<SelfT, &SelfT::post>(this));
     ctx_.bus.subscribe(CRefHandler<ConnectionStatusEvent>::bind<SelfT, &SelfT::post>(this));
   }
 
@@ -79,6 +80,36 @@ private:
     }
     LOG_INFO_SYSTEM("Connected datagram");
     pricesChannel_ = std::make_unique<DatagramChannel>(std::move(transport));
+
+    ByteSpan span(feed_.data.data(), feed_.data.size());
+    pricesChannel_->asyncRx(span, CRefHandler<IoResult>::bind<SelfT, &SelfT::onPrice>(this));
+  }
+
+  /**
+   * @brief Buffer fits a single record of the broadcast, a tagged price or level update
+   */
+  void onPrice(CRef<IoResult> res) {
+    if (res.code != IoStatus::Ok) {
+      LOG_ERROR_SYSTEM("Failed to read prices from shm");
+      return;
+    }
+    switch (feed_.type()) {
+    case ShmFeedType::Price:
+      if (const auto price = feed_.unpack<TickerPrice>(res.bytes)) {
+        ctx_.bus.post(*price);
+        return;
+      }
+      break;
+    case ShmFeedType::Level:
+      if (const auto level = feed_.unpack<LevelUpdate>(res.bytes)) {
+        ctx_.bus.post(*level);
+        return;
+      }
+      break;
+    default:
+      break;
+    }
+    LOG_ERROR("Malformed broadcast record of {} bytes", res.bytes);
   }
 
   void post(CRef<IoResult> res) {
@@ -90,15 +121,31 @@ private:
     }
   }
 
-  void post(CRef<Order> order) {
+  void post(CRef<Order> order) { send(order); }
+
+  /**
+   * @brief Shm carries single stamped orders, so the batch goes out order by order
+   */
+  void post(CRef<OrderBatch> batch) {
+    for (const auto &order : batch.view()) {
+      if (!send(order)) {
+        break;
+      }
+    }
+  }
+
+  bool send(CRef<Order> order) {
     LOG_DEBUG("{}", toString(order));
-    auto *ptr = reinterpret_cast<const uint8_t *>(&order);
-    CByteSpan span(ptr, sizeof(Order));
+    const ShmOrder record{networkClient_.clientId(), order};
+    auto *ptr = reinterpret_cast<const uint8_t *>(&record);
+    CByteSpan span(ptr, sizeof(ShmOrder));
     auto res = upstreamChannel_->syncTx(span);
     if (!res) {
       LOG_ERROR_SYSTEM("Failed to write to shm, stopping");
       reset();
+      return false;
     }
+    return true;
   }
 
   void post(CRef<ConnectionStatusEvent> event) {
@@ -138,6 +185,7 @@ private:
   UPtr<DatagramChannel> pricesChannel_;
 
   OrderStatus status_;
+  ShmFeedRecord feed_;
 };
 } // namespace hft::client
 
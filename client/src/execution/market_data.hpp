@@ -7,34 +7,89 @@
 #define HFT_CLIENT_MARKETDATA_HPP
 
 #include <atomic>
+#include <functional>
+#include <map>
 
 #include <boost/unordered/unordered_flat_map.hpp>
 
 #include "constants.hpp"
 #include "domain_types.hpp"
 #include "primitive_types.hpp"
+#include "ptr_types.hpp"
 
 namespace hft::client {
 
 /**
- * @brief Holds only the price for now
+ * @brief Server order book depth rebuilt from level updates, touched by the feed thread only
+ * sequence is per ticker, an update older than the last one is dropped,
+ * a gap means lost updates, the levels they touched stay stale until updated again,
+ * sequence 1 is the first update of a fresh server book, so the depth starts over
+ */
+struct Depth {
+  std::map<Price, uint64_t, std::greater<>> bids;
+  std::map<Price, uint64_t> asks;
+  uint32_t seq{0};
+  uint64_t lost{0};
+
+  /**
+   * @return false if the update is stale
+   */
+  bool apply(CRef<LevelUpdate> update) {
+    if (update.seq == 1) {
+      bids.clear();
+      asks.clear();
+      seq = 0;
+    } else if (update.seq <= seq) {
+      return false;
+    }
+    lost += update.seq - seq - 1;
+    seq = update.seq;
+    if (update.side == OrderAction::Buy) {
+      set(bids, update);
+    } else {
+      set(asks, update);
+    }
+    return true;
+  }
+
+  inline Price bestBid() const { return bids.empty() ? 0 : bids.begin()->first; }
+  inline Price bestAsk() const { return asks.empty() ? 0 : asks.begin()->first; }
+
+private:
+  template <typename SideT>
+  static void set(SideT &side, CRef<LevelUpdate> update) {
+    if (update.volume == 0) {
+      side.erase(update.price);
+    } else {
+      side[update.price] = update.volume;
+    }
+  }
+};
+
+/**
+ * @brief Holds the price and the server book depth for now
  * @todo Later on would track all the opened orders
  */
 struct TickerData {
   explicit TickerData(Price price) : price_{price} {}
 
-  TickerData(TickerData &&other) noexcept : price_{other.price_.load(std::memory_order_acquire)} {};
+  TickerData(TickerData &&other) noexcept
+      : price_{other.price_.load(std::memory_order_acquire)}, depth_{std::move(other.depth_)} {};
 
   TickerData &operator=(TickerData &&other) noexcept {
     price_ = other.price_.load(std::memory_order_acquire);
+    depth_ = std::move(other.depth_);
     return *this;
   };
 
   inline void setPrice(Price price) const { price_.store(price, std::memory_order_release); }
   inline Price getPrice() const { return price_.load(std::memory_order_acquire); }
 
+  inline Depth &depth() const { return depth_; }
+
 private:
   alignas(CACHE_LINE_SIZE) mutable std::atomic<Price> price_;
+  mutable Depth depth_;
 
   TickerData() = delete;
   TickerData(const TickerData &) = delete;
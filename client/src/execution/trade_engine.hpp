@@ -31,6 +31,8 @@ namespace hft::client {
 /**
  * @brief Generates random orders for each ticker, tracks the statuses
  * randomly cancels some of the orders after they have been accepted by the server
+ * with order batch configured new orders go out in batches of that size
+ * keeps server book depth per ticker from the level updates
  * streams telemetry to the monitor
  */
 class TradeEngine {
@@ -53,6 +55,7 @@ public:
         timer_{ctx_.bus.systemIoCtx()} {
     ctx_.bus.subscribe(CRefHandler<OrderStatus>::bind<SelfT, &SelfT::post>(this));
     ctx_.bus.subscribe(CRefHandler<TickerPrice>::bind<SelfT, &SelfT::post>(this));
+    ctx_.bus.subscribe(CRefHandler<LevelUpdate>::bind<SelfT, &SelfT::post>(this));
   }
 
   void start() {
@@ -132,7 +135,7 @@ private:
         continue;
       }
 
-      if (!sendCancel() && !sendNew()) {
+      if (!sendCancel() && !(ctx_.config.orderBatch > 1 ? sendNewBatch() : sendNew())) {
         break;
       }
 
@@ -146,6 +149,29 @@ private:
   }
 
   bool sendNew() {
+    Order order;
+    if (!createNew(order)) {
+      return false;
+    }
+    LOG_DEBUG("Placing order {}", toString(order));
+    ctx_.bus.marketBus.post(order);
+    return true;
+  }
+
+  bool sendNewBatch() {
+    batch_.count = 0;
+    while (batch_.count < ctx_.config.orderBatch) {
+      if (!createNew(batch_.orders[batch_.count])) {
+        return false;
+      }
+      ++batch_.count;
+    }
+    LOG_DEBUG("Placing {}", toString(batch_));
+    ctx_.bus.marketBus.post(batch_);
+    return true;
+  }
+
+  bool createNew(Order &order) {
     using namespace utils;
     static auto cursor = marketData_.begin();
     if (cursor == marketData_.end()) {
@@ -163,13 +189,11 @@ private:
       return false;
     }
     const auto now = getCycles();
-    Order order{id.raw(), p.first, quantity, newPrice, action};
+    order = Order{id.raw(), p.first, quantity, newPrice, action};
 
     orders_[id.index()] = {order, now, id};
 
     placed_.fetch_add(1, std::memory_order_relaxed);
-    LOG_DEBUG("Placing order {}", toString(order));
-    ctx_.bus.marketBus.post(order);
     return true;
   }
 
@@ -252,6 +276,24 @@ private:
     dataIt->second.setPrice(price.price);
   }
 
+  void post(CRef<LevelUpdate> level) {
+    const auto dataIt = marketData_.find(level.ticker);
+    if (dataIt == marketData_.end()) {
+      LOG_ERROR("Ticker {} not found", toString(level.ticker));
+      return;
+    }
+    auto &depth = dataIt->second.depth();
+    const uint64_t lost = depth.lost;
+    if (!depth.apply(level)) {
+      LOG_WARN("Stale {}", toString(level));
+      return;
+    }
+    if (depth.lost != lost) {
+      LOG_WARN("{} level updates lost for {}", depth.lost - lost, toString(level.ticker));
+    }
+    LOG_TRACE("{} bid {} ask {}", toString(level), depth.bestBid(), depth.bestAsk());
+  }
+
   void scheduleStats() {
     using namespace utils;
     timer_.expires_after(Seconds(1));
@@ -290,6 +332,8 @@ private:
   ALIGN_CL AtomicBool trading_{false};
 
   ALIGN_CL SequencedSPSC<1024> toCancel_;
+  // touched by the trade thread only
+  ALIGN_CL OrderBatch batch_;
   ALIGN_CL SteadyTimer timer_;
 
   std::jthread worker_;
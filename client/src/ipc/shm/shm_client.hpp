@@ -11,14 +11,18 @@
 #include "events.hpp"
 #include "primitive_types.hpp"
 #include "traits.hpp"
+#include "transport/shm/shm_ptr.hpp"
+#include "transport/shm/shm_queue.hpp"
 #include "transport/shm/shm_reactor.hpp"
+#include "transport/shm/shm_session_registry.hpp"
 #include "transport/shm/shm_transport.hpp"
 #include "utils/memory_utils.hpp"
 
 namespace hft::client {
 
 /**
- * @brief
+ * @brief Claims a session slot in the server registry and talks over the queue pair of that slot
+ * prices come from the broadcast segment shared by all the clients
  */
 class ShmClient {
 public:
@@ -33,28 +37,67 @@ public:
 
   void setDownstreamClb(ShmHandler &&streamClb) { downstreamClb_ = std::move(streamClb); }
 
-  void setDatagramClb(ShmHandler &&datagramClb) {}
+  void setDatagramClb(ShmHandler &&datagramClb) { datagramClb_ = std::move(datagramClb); }
 
   void start() {
     initialize();
     reactor_.run([this]() { ctx_.bus.post(ComponentReady{Component::Ipc}); });
   }
 
+  /**
+   * @brief Stamped into every order, valid once started
+   */
+  auto clientId() const -> ClientId { return clientId_.value_or(0); }
+
   void stop() {
     LOG_INFO("ShmClient stop");
     reactor_.stop();
+    if (registry_ && clientId_) {
+      (*registry_)->release(ShmSessionRegistry::slotOf(*clientId_));
+      clientId_.reset();
+    }
   }
 
 private:
   void initialize() {
     LOG_DEBUG("ShmClient::initialize");
+    const auto &cfg = ctx_.config.data;
+    registry_.emplace(cfg.get<String>("shm.shm_registry"));
+    clientId_ = (*registry_)->claim();
+    if (!clientId_) {
+      throw std::runtime_error("No free shm session, server is down or all slots are taken");
+    }
+    const uint32_t slot = ShmSessionRegistry::slotOf(*clientId_);
+    LOG_INFO("Claimed shm session {} as client {}", slot, *clientId_);
+
+    const auto upstream =
+        ShmSessionRegistry::queueName(cfg.get<String>("shm.shm_upstream"), slot);
+    const auto downstream =
+        ShmSessionRegistry::queueName(cfg.get<String>("shm.shm_downstream"), slot);
+    drain(downstream);
     if (upstreamClb_) {
-      const auto name = ctx_.config.data.get<String>("shm.shm_upstream");
-      upstreamClb_(ShmTransport::makeWriter(name));
+      upstreamClb_(ShmTransport::makeWriter(upstream));
     }
     if (downstreamClb_) {
-      const auto name = ctx_.config.data.get<String>("shm.shm_downstream");
-      downstreamClb_(ShmTransport::makeReader(name));
+      downstreamClb_(ShmTransport::makeReader(downstream));
+    }
+    if (datagramClb_) {
+      datagramClb_(ShmTransport::makeSubscriber(cfg.get<String>("shm.shm_broadcast")));
+    }
+  }
+
+  /**
+   * @brief Drops statuses left in the slot by the previous owner
+   */
+  static void drain(CRef<String> name) {
+    ShmUPtr<ShmQueue> queue{name};
+    uint8_t buffer[ShmQueue::Queue::MAX_DATA_SIZE];
+    size_t bytes = 0;
+    while (const auto read = queue->queue.readBatch(buffer, sizeof(buffer))) {
+      bytes += read;
+    }
+    if (bytes != 0) {
+      LOG_WARN("Dropped {} stale bytes from {}", bytes, name);
     }
   }
 
@@ -62,6 +105,8 @@ private:
   Context &ctx_;
 
   ShmReactor reactor_;
+  Optional<ShmUPtr<ShmSessionRegistry>> registry_;
+  Optional<ClientId> clientId_;
 
   ShmHandler upstreamClb_;
   ShmHandler downstreamClb_;
@@ -0,0 +1,144 @@
+/**
+ * @author Vladimir Pavliv
+ * @date 2026-02-18
+ */
+
+#ifndef HFT_CLIENT_URINGNETWORKCLIENT_HPP
+#define HFT_CLIENT_URINGNETWORKCLIENT_HPP
+
+#include <array>
+#include <cstring>
+#include <format>
+#include <functional>
+
+#include "bus/bus_hub.hpp"
+#include "config/client_config.hpp"
+#include "events.hpp"
+#include "logging.hpp"
+#include "primitive_types.hpp"
+#include "traits.hpp"
+#include "transport/uring/uring_network_utils.hpp"
+#include "transport/uring/uring_reactor.hpp"
+#include "transport/uring/uring_tcp_transport.hpp"
+#include "transport/uring/uring_udp_transport.hpp"
+#include "utils/thread_utils.hpp"
+
+namespace hft::client {
+
+/**
+ * @brief Socket io on a single io_uring, same callbacks as BoostIpcClient
+ */
+class UringIpcClient {
+  enum Stream : uint8_t { Upstream, Downstream };
+
+public:
+  using StreamClb = std::function<void(UringTcpTransport &&)>;
+  using DatagramClb = std::function<void(UringUdpTransport &&)>;
+
+  explicit UringIpcClient(Context &ctx) : ctx_{ctx} {}
+
+  ~UringIpcClient() { stop(); }
+
+  void setUpstreamClb(StreamClb &&streamClb) { upStreamClb_ = std::move(streamClb); }
+
+  void setDownstreamClb(StreamClb &&streamClb) { downStreamClb_ = std::move(streamClb); }
+
+  void setDatagramClb(DatagramClb &&datagramClb) { datagramClb_ = std::move(datagramClb); }
+
+  void start() {
+    workerThread_ = std::jthread([this]() {
+      try {
+        utils::setThreadRealTime();
+        if (ctx_.config.coreNetwork.has_value()) {
+          const auto coreId = *ctx_.config.coreNetwork;
+          utils::pinThreadToCore(coreId);
+          LOG_DEBUG("Network thread started on the core {}", coreId);
+        } else {
+          LOG_DEBUG("Network thread started");
+        }
+        LOG_DEBUG("Connecting to the server");
+        asyncConnect(Upstream, ctx_.config.portTcpUp, upStreamClb_);
+        asyncConnect(Downstream, ctx_.config.portTcpDown, downStreamClb_);
+        createPrices();
+        reactor_.run();
+      } catch (const std::exception &e) {
+        LOG_ERROR_SYSTEM("Exception in network thread {}", e.what());
+        ctx_.bus.post(InternalError(StatusCode::Error, e.what()));
+      }
+    });
+  }
+
+  void stop() {
+    reactor_.stop();
+    utils::join(workerThread_);
+  }
+
+private:
+  /**
+   * @brief Address has to stay put until the connect is picked up by the kernel
+   */
+  void asyncConnect(Stream stream, Port port, CRef<StreamClb> callback) {
+    const int fd = openSocket(SOCK_STREAM);
+    endpoints_[stream] = makeAddress(ctx_.config.url, port);
+    const auto *addr = reinterpret_cast<const sockaddr *>(&endpoints_[stream]);
+
+    const bool submitted = reactor_.submit(
+        [fd, addr](io_uring_sqe *sqe) {
+          io_uring_prep_connect(sqe, fd, addr, sizeof(sockaddr_in));
+        },
+        [this, fd, port, &callback](CRef<io_uring_cqe> cqe) {
+          if (cqe.res < 0) [[unlikely]] {
+            LOG_ERROR_SYSTEM("Connection failed on port {}: {}", port, std::strerror(-cqe.res));
+            ::close(fd);
+            return;
+          }
+          try {
+            configureTcpSocket(fd);
+          } catch (const std::exception &e) {
+            LOG_ERROR_SYSTEM("{}", e.what());
+            ::close(fd);
+            return;
+          }
+          callback(UringTcpTransport{reactor_, fd});
+          LOG_INFO_SYSTEM("TCP connection established on port {}", port);
+        });
+    if (!submitted) {
+      ::close(fd);
+      throw std::runtime_error(std::format("Failed to connect on port {}", port));
+    }
+  }
+
+  void createPrices() {
+    try {
+      const int fd = openSocket(SOCK_DGRAM);
+      UringUdpTransport transport{reactor_, fd};
+      setSocketOption(fd, SOL_SOCKET, SO_REUSEADDR, 1);
+
+      const sockaddr_in addr = makeAddress(INADDR_ANY, ctx_.config.portUdp);
+      if (::bind(fd, reinterpret_cast<const sockaddr *>(&addr), sizeof(addr)) != 0) {
+        throw std::runtime_error(std::format("Failed to bind: {}", std::strerror(errno)));
+      }
+
+      datagramClb_(std::move(transport));
+      LOG_INFO_SYSTEM("UDP listener bound to port {}", ctx_.config.portUdp);
+    } catch (const std::exception &e) {
+      LOG_ERROR_SYSTEM("Failed to setup UDP pricing: {}", e.what());
+    }
+  }
+
+private:
+  Context &ctx_;
+
+  UringReactor reactor_;
+  std::array<sockaddr_in, 2> endpoints_{};
+
+  StreamClb upStreamClb_;
+  StreamClb downStreamClb_;
+  DatagramClb datagramClb_;
+
+  std::jthread workerThread_;
+};
+
+} // namespace hft::client
+
+#endif // HFT_CLIENT_URINGNETWORKCLIENT_HPP
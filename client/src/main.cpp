@@ -12,6 +12,9 @@
 #ifdef COMM_SHM
 #include "connection/trusted_connection_manager.hpp"
 #include "ipc/shm/shm_client.hpp"
+#elif defined(COMM_URING)
+#include "connection/network_connection_manager.hpp"
+#include "ipc/uring/uring_network_client.hpp"
 #else
 #include "ipc/boost/boost_network_client.hpp"
 
@@ -36,6 +36,8 @@ class DummyTelemetryAdapter;
 class ShmTransport;
 class BoostTcpTransport;
 class BoostUdpTransport;
+class UringTcpTransport;
+class UringUdpTransport;
 
 template <typename SerializerType>
 class FixedSizeFramer;
@@ -49,10 +51,16 @@ class FbsDomainSerializer;
 namespace sbe {
 class SbeDomainSerializer;
 }
+namespace raw {
+class RawDomainSerializer;
+}
 
 #ifdef SERIALIZATION_SBE
 using DomainSerializer = serialization::sbe::SbeDomainSerializer;
 using Framer = DummyFramer<DomainSerializer>;
+#elif defined(SERIALIZATION_RAW)
+using DomainSerializer = serialization::raw::RawDomainSerializer;
+using Framer = DummyFramer<DomainSerializer>;
 #else
 using DomainSerializer = serialization::fbs::FbsDomainSerializer;
 using Framer = FixedSizeFramer<DomainSerializer>;
@@ -74,6 +82,7 @@ namespace hft::client {
 class CommandParser;
 class ShmClient;
 class BoostIpcClient;
+class UringIpcClient;
 class NetworkConnectionManager;
 class TrustedConnectionManager;
 
@@ -86,6 +95,11 @@ using StreamTransport = ShmTransport;
 using DatagramTransport = ShmTransport;
 using IpcClient = ShmClient;
 using ConnectionManager = TrustedConnectionManager;
+#elif defined(COMM_URING)
+using StreamTransport = UringTcpTransport;
+using DatagramTransport = UringUdpTransport;
+using IpcClient = UringIpcClient;
+using ConnectionManager = NetworkConnectionManager;
 #else
 using StreamTransport = BoostTcpTransport;
 using DatagramTransport = BoostUdpTransport;
@@ -95,7 +109,7 @@ using ConnectionManager = NetworkConnectionManager;
 
 using ClientMessageBus = MessageBus<
     // directly routed events
-    Order, OrderStatus, TickerPrice, TelemetryMsg>;
+    Order, OrderBatch, OrderStatus, TickerPrice, LevelUpdate, TelemetryMsg>;
 
 using ClientBus = BusHub<ClientMessageBus>;
 using UpstreamBus = BusRestrictor<
@@ -112,7 +126,7 @@ using DatagramBus = BusRestrictor<
     // bus
     ClientBus,
     // events
-    TickerPrice, ChannelStatusEvent, ConnectionStatusEvent>;
+    TickerPrice, LevelUpdate, ChannelStatusEvent, ConnectionStatusEvent>;
 
 using ClientConsoleReader = ConsoleReader<CommandParser>;
 using DbAdapter = adapters::PostgresAdapter;
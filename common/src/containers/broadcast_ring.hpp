@@ -0,0 +1,158 @@
+/**
+ * @author Vladimir Pavliv
+ * @date 2026-02-14
+ */
+
+#ifndef HFT_COMMON_BROADCASTRING_HPP
+#define HFT_COMMON_BROADCASTRING_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "logging.hpp"
+#include "primitive_types.hpp"
+#include "ptr_types.hpp"
+
+namespace hft {
+
+/**
+ * @brief Slot based spmc broadcast ring, meant for shared memory
+ * writer never waits for readers, it just overwrites the oldest slot, every reader keeps
+ * its own cursor outside of the ring, so any number of them can attach without the writer
+ * knowing about them
+ * every slot is a seqlock: odd sequence while written, even one of the message when done,
+ * reader checks the sequence before and after the copy, so a slot overwritten under it
+ * is never taken, reader that finds a newer message than expected has been lapped,
+ * it skips to the newest message and counts what it has missed
+ */
+template <size_t SlotCount = 65536>
+class BroadcastRing {
+  static_assert((SlotCount & (SlotCount - 1)) == 0);
+
+public:
+  static constexpr uint32_t MAX_DATA_SIZE = 52;
+
+  /**
+   * @brief Reader position, lives in the reader process
+   */
+  struct Cursor {
+    uint64_t next{0};
+    uint64_t lapped{0}; // messages missed so far
+  };
+
+private:
+  static constexpr uint64_t MASK = SlotCount - 1;
+
+  struct alignas(64) Sloth {
+    AtomicUInt64 seq{0};
+    uint32_t size{};
+    uint8_t data[MAX_DATA_SIZE] = {};
+  };
+
+public:
+  template <typename T>
+  inline bool write(CRef<T> msg) {
+    return write(reinterpret_cast<const uint8_t *>(&msg), sizeof(T));
+  }
+
+  /**
+   * @brief Single writer only
+   */
+  inline bool write(const uint8_t *__restrict__ src, uint32_t size) noexcept {
+    if (size == 0 || size > MAX_DATA_SIZE) {
+      return false;
+    }
+    const uint64_t idx = head_.load(std::memory_order_relaxed);
+    Sloth &sloth = slots_[idx & MASK];
+
+    sloth.seq.store(2 * idx + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    sloth.size = size;
+    std::memcpy(sloth.data, src, size);
+    sloth.seq.store(2 * idx + 2, std::memory_order_release);
+
+    head_.store(idx + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * @brief Cursor at the next message to be written, history is not replayed
+   */
+  inline Cursor attach() const noexcept { return Cursor{head_.load(std::memory_order_acquire)}; }
+
+  inline bool empty(CRef<Cursor> cursor) const noexcept {
+    return head_.load(std::memory_order_acquire) == cursor.next;
+  }
+
+  template <typename T>
+  inline uint32_t read(Cursor &cursor, T &msg) {
+    return read(cursor, reinterpret_cast<uint8_t *>(&msg), sizeof(T));
+  }
+
+  /**
+   * @return size of the message read, 0 if there is none yet or the reader has been lapped
+   */
+  inline uint32_t read(Cursor &cursor, uint8_t *__restrict__ dst, uint32_t maxSize) noexcept {
+    const Sloth &sloth = slots_[cursor.next & MASK];
+    const uint64_t expected = 2 * cursor.next + 2;
+
+    const uint64_t seq = sloth.seq.load(std::memory_order_acquire);
+    if (seq < expected) {
+      return 0;
+    }
+    if (seq > expected) {
+      resync(cursor);
+      return 0;
+    }
+    const uint32_t size = std::min(sloth.size, MAX_DATA_SIZE);
+    if (size > maxSize) {
+      LOG_ERROR("Buffer is too small, data {} buffer {}", size, maxSize);
+      return 0;
+    }
+    std::memcpy(dst, sloth.data, size);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (sloth.seq.load(std::memory_order_relaxed) != seq) {
+      resync(cursor);
+      return 0;
+    }
+    ++cursor.next;
+    return size;
+  }
+
+  /**
+   * @brief Reads consecutive messages back to back while there is room for the largest one
+   * @return number of bytes read
+   */
+  inline uint32_t readBatch(Cursor &cursor, uint8_t *__restrict__ dst, uint32_t maxSize) noexcept {
+    uint32_t bytes = 0;
+    while (bytes == 0 || maxSize - bytes >= MAX_DATA_SIZE) {
+      const uint32_t size = read(cursor, dst + bytes, maxSize - bytes);
+      if (size == 0) {
+        break;
+      }
+      bytes += size;
+    }
+    return bytes;
+  }
+
+private:
+  inline void resync(Cursor &cursor) const noexcept {
+    const uint64_t newest = head_.load(std::memory_order_acquire) - 1;
+    LOG_WARN("Broadcast reader lapped, skipping {} messages", newest - cursor.next);
+    cursor.lapped += newest - cursor.next;
+    cursor.next = newest;
+  }
+
+private:
+  // data first so it fills up the huge pages nicely
+  alignas(64) Sloth slots_[SlotCount];
+
+  alignas(64) AtomicUInt64 head_{0};
+};
+
+} // namespace hft
+
+#endif // HFT_COMMON_BROADCASTRING_HPP
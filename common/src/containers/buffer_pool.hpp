@@ -6,13 +6,18 @@
 #ifndef HFT_COMMON_BUFFERPOOL_HPP
 #define HFT_COMMON_BUFFERPOOL_HPP
 
+#include <algorithm>
 #include <array>
 #include <atomic>
+#include <bit>
 #include <cassert>
 #include <memory>
+#include <thread>
 
+#include "container_types.hpp"
 #include "logging.hpp"
 #include "primitive_types.hpp"
+#include "ptr_types.hpp"
 #include "vyukov_mpmc.hpp"
 
 namespace hft {
@@ -37,16 +42,51 @@ struct BufferPtr {
 
 /**
  * @brief Pool of preallocated buffers for async network writes
+ * @details Every thread keeps a small cache of free indices, acquire and release only touch it.
+ * Caches trade full magazines of indices with the shared depot, so the shared queue is hit once
+ * per MAGAZINE_SIZE operations. Memory grows by slabs of PoolSize buffers up to MaxSlabs,
+ * the first slab is a member and stays at the same address for the kernel to register it.
+ * Each BufferCapacity is a separate pool, so size classes are just different instantiations
  */
-template <uint32_t BufferCapacity = 128, uint32_t PoolSize = 1024>
+template <uint32_t BufferCapacity = 128, uint32_t PoolSize = 1024, uint32_t MaxSlabs = 16>
 class BufferPool {
 public:
   static_assert(BufferCapacity % 64 == 0, "BufferCapacity should be cache-line aligned");
 
   static constexpr uint32_t BUFFER_CAPACITY = BufferCapacity;
   static constexpr uint32_t POOL_SIZE = PoolSize;
+  static constexpr uint32_t MAX_SLABS = MaxSlabs;
+  static constexpr uint32_t MAGAZINE_SIZE = 32;
 
-  inline static auto instance() -> BufferPool<BufferCapacity, PoolSize> & {
+  static_assert(PoolSize % MAGAZINE_SIZE == 0, "PoolSize should be a multiple of MAGAZINE_SIZE");
+
+private:
+  using Slab = std::array<uint8_t, BufferCapacity * PoolSize>;
+
+  struct Magazine {
+    std::array<uint32_t, MAGAZINE_SIZE> indices;
+    uint32_t count{0};
+  };
+
+  /**
+   * @brief Per thread free indices, up to two magazines, handed back to the depot on exit
+   */
+  struct Cache {
+    ~Cache() {
+      auto &pool = BufferPool::instance();
+      while (count != 0) {
+        const uint32_t batch = std::min(count, MAGAZINE_SIZE);
+        count -= batch;
+        pool.returnMagazine(indices.data() + count, batch);
+      }
+    }
+
+    std::array<uint32_t, MAGAZINE_SIZE * 2> indices;
+    uint32_t count{0};
+  };
+
+public:
+  inline static auto instance() -> BufferPool & {
     static std::unique_ptr<BufferPool> instance(new BufferPool());
     return *instance;
   }
@@ -55,29 +95,92 @@ public:
   BufferPool &operator=(const BufferPool &) = delete;
 
   inline auto acquire() -> BufferPtr {
-    uint32_t index = 0;
-    if (!indexQueue_.pop(index)) {
-      index = nextFreeIdx_.fetch_add(1, std::memory_order_relaxed);
-      if (index >= PoolSize) {
-        LOG_ERROR("BufferPool exhausted");
-        return BufferPtr{};
-      }
+    Cache &cache = cache_;
+    if (UNLIKELY(cache.count == 0) && !refill(cache)) {
+      LOG_ERROR("BufferPool exhausted");
+      return BufferPtr{};
     }
-    return {&storage_[index * BufferCapacity], index};
+    const uint32_t index = cache.indices[--cache.count];
+    return {address(index), index};
   }
 
   inline void release(uint32_t index) noexcept {
-    if (!indexQueue_.push(index)) {
-      LOG_ERROR_SYSTEM("Index double release in BufferPool");
+    Cache &cache = cache_;
+    if (UNLIKELY(cache.count == cache.indices.size())) {
+      cache.count -= MAGAZINE_SIZE;
+      returnMagazine(cache.indices.data() + cache.count, MAGAZINE_SIZE);
     }
+    cache.indices[cache.count++] = index;
   }
 
+  /**
+   * @brief First slab memory, for registering it with the kernel once
+   */
+  inline auto storage() noexcept -> Span<uint8_t> { return {storage_.data(), storage_.size()}; }
+
 private:
-  BufferPool() : nextFreeIdx_(0) {}
+  BufferPool() : nextFreeIdx_(0) {
+    slabs_[0].store(storage_.data(), std::memory_order_relaxed);
+  }
 
-  ALIGN_CL std::array<uint8_t, BufferCapacity * PoolSize> storage_;
-  ALIGN_CL VyukovMPMC<uint32_t, PoolSize> indexQueue_;
+  inline uint8_t *address(uint32_t index) const noexcept {
+    return slabs_[index / PoolSize].load(std::memory_order_acquire) +
+           (index % PoolSize) * BufferCapacity;
+  }
+
+  /**
+   * @brief Takes a full magazine from the depot, or carves a fresh one out of the slabs
+   */
+  bool refill(Cache &cache) {
+    Magazine magazine;
+    if (depot_.pop(magazine)) {
+      std::copy_n(magazine.indices.begin(), magazine.count, cache.indices.begin());
+      cache.count = magazine.count;
+      return true;
+    }
+    const uint32_t first = nextFreeIdx_.fetch_add(MAGAZINE_SIZE, std::memory_order_relaxed);
+    if (first >= PoolSize * MaxSlabs) {
+      nextFreeIdx_.store(PoolSize * MaxSlabs, std::memory_order_relaxed);
+      return false;
+    }
+    if (first % PoolSize == 0 && first != 0) {
+      addSlab(first / PoolSize);
+    }
+    while (slabs_[first / PoolSize].load(std::memory_order_acquire) == nullptr) {
+      // another thread carved the first batch of this slab and is still allocating it
+      std::this_thread::yield();
+    }
+    for (uint32_t idx = 0; idx < MAGAZINE_SIZE; ++idx) {
+      cache.indices[idx] = first + MAGAZINE_SIZE - 1 - idx;
+    }
+    cache.count = MAGAZINE_SIZE;
+    return true;
+  }
+
+  void addSlab(uint32_t slab) {
+    LOG_INFO_SYSTEM("BufferPool grows to {} buffers", (slab + 1) * PoolSize);
+    extraSlabs_[slab] = std::make_unique<Slab>();
+    slabs_[slab].store(extraSlabs_[slab]->data(), std::memory_order_release);
+  }
+
+  void returnMagazine(const uint32_t *indices, uint32_t count) noexcept {
+    Magazine magazine;
+    std::copy_n(indices, count, magazine.indices.begin());
+    magazine.count = count;
+    if (!depot_.push(magazine)) {
+      LOG_ERROR_SYSTEM("BufferPool depot overflow, {} buffers lost", count);
+    }
+  }
+
+private:
+  inline static thread_local Cache cache_;
+
+  ALIGN_CL Slab storage_;
+  ALIGN_CL VyukovMPMC<Magazine, std::bit_ceil(PoolSize * MaxSlabs / MAGAZINE_SIZE) * 2> depot_;
   ALIGN_CL AtomicUInt32 nextFreeIdx_;
+
+  std::array<Atomic<uint8_t *>, MaxSlabs> slabs_{};
+  std::array<UPtr<Slab>, MaxSlabs> extraSlabs_;
 };
 
 } // namespace hft
@@ -0,0 +1,134 @@
+/**
+ * @author Vladimir Pavliv
+ * @date 2026-02-02
+ */
+
+#ifndef HFT_COMMON_HIERARCHICALBITMAP_HPP
+#define HFT_COMMON_HIERARCHICALBITMAP_HPP
+
+#include <cstdint>
+#include <cstring>
+
+#include "primitive_types.hpp"
+
+namespace hft {
+
+/**
+ * @brief Three level 64-ary occupancy bitmap
+ * each bit of the upper level marks a non-empty word of the level below, so next/prev set bit
+ * lookup takes at most three ctz/clz steps up and three down regardless of the range
+ */
+template <uint32_t Bits>
+class HierarchicalBitmap {
+  static_assert(Bits > 0);
+  static_assert(Bits <= 64 * 64 * 64, "Range is too large for three levels");
+
+  static constexpr uint32_t L0_SIZE = (Bits + 63) / 64;
+  static constexpr uint32_t L1_SIZE = (L0_SIZE + 63) / 64;
+
+public:
+  static constexpr uint32_t NPOS = UINT32_MAX;
+
+  HierarchicalBitmap() { reset(); }
+
+  inline void set(uint32_t idx) noexcept {
+    const uint32_t w0 = idx >> 6;
+    const uint32_t w1 = w0 >> 6;
+    l0_[w0] |= bit(idx & 63);
+    l1_[w1] |= bit(w0 & 63);
+    l2_ |= bit(w1);
+  }
+
+  inline void clear(uint32_t idx) noexcept {
+    const uint32_t w0 = idx >> 6;
+    const uint32_t w1 = w0 >> 6;
+    l0_[w0] &= ~bit(idx & 63);
+    if (l0_[w0] == 0) {
+      l1_[w1] &= ~bit(w0 & 63);
+      if (l1_[w1] == 0) {
+        l2_ &= ~bit(w1);
+      }
+    }
+  }
+
+  [[nodiscard]] inline bool test(uint32_t idx) const noexcept {
+    return (l0_[idx >> 6] & bit(idx & 63)) != 0;
+  }
+
+  [[nodiscard]] inline bool empty() const noexcept { return l2_ == 0; }
+
+  /**
+   * @brief Smallest set index that is >= idx, NPOS if none
+   */
+  [[nodiscard]] inline uint32_t findNext(uint32_t idx) const noexcept {
+    if (UNLIKELY(idx >= Bits)) {
+      return NPOS;
+    }
+    uint32_t w0 = idx >> 6;
+    uint64_t word = l0_[w0] & (~0ULL << (idx & 63));
+    if (word != 0) {
+      return (w0 << 6) | __builtin_ctzll(word);
+    }
+    uint32_t w1 = w0 >> 6;
+    word = l1_[w1] & above(w0 & 63);
+    if (word == 0) {
+      word = l2_ & above(w1);
+      if (word == 0) {
+        return NPOS;
+      }
+      w1 = __builtin_ctzll(word);
+      word = l1_[w1];
+    }
+    w0 = (w1 << 6) | __builtin_ctzll(word);
+    return (w0 << 6) | __builtin_ctzll(l0_[w0]);
+  }
+
+  /**
+   * @brief Largest set index that is <= idx, NPOS if none
+   */
+  [[nodiscard]] inline uint32_t findPrev(uint32_t idx) const noexcept {
+    if (UNLIKELY(idx >= Bits)) {
+      idx = Bits - 1;
+    }
+    uint32_t w0 = idx >> 6;
+    uint64_t word = l0_[w0] & (~0ULL >> (63 - (idx & 63)));
+    if (word != 0) {
+      return (w0 << 6) | highest(word);
+    }
+    uint32_t w1 = w0 >> 6;
+    word = l1_[w1] & below(w0 & 63);
+    if (word == 0) {
+      word = l2_ & below(w1);
+      if (word == 0) {
+        return NPOS;
+      }
+      w1 = highest(word);
+      word = l1_[w1];
+    }
+    w0 = (w1 << 6) | highest(word);
+    return (w0 << 6) | highest(l0_[w0]);
+  }
+
+  void reset() noexcept {
+    std::memset(l0_, 0, sizeof(l0_));
+    std::memset(l1_, 0, sizeof(l1_));
+    l2_ = 0;
+  }
+
+  static constexpr uint32_t size() noexcept { return Bits; }
+
+private:
+  static constexpr uint64_t bit(uint32_t idx) noexcept { return 1ULL << idx; }
+  static constexpr uint64_t above(uint32_t idx) noexcept { return (~0ULL << idx) << 1; }
+  static constexpr uint64_t below(uint32_t idx) noexcept { return bit(idx) - 1; }
+  static constexpr uint32_t highest(uint64_t word) noexcept { return 63 - __builtin_clzll(word); }
+
+private:
+  ALIGN_CL uint64_t l0_[L0_SIZE];
+  uint64_t l1_[L1_SIZE];
+  uint64_t l2_;
+};
+
+} // namespace hft
+
+#endif // HFT_COMMON_HIERARCHICALBITMAP_HPP
@@ -43,6 +43,9 @@ public:
 
   [[nodiscard]] inline const T &operator[](size_t index) const noexcept { return data_[index]; }
 
+  [[nodiscard]] inline T *data() noexcept { return data_; }
+  [[nodiscard]] inline const T *data() const noexcept { return data_; }
+
   static constexpr size_t capacity() noexcept { return Capacity; }
   static constexpr size_t size_bytes() noexcept { return ByteSize; }
 
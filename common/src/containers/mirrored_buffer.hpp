@@ -0,0 +1,135 @@
+/**
+ * @author Vladimir Pavliv
+ * @date 2026-02-21
+ */
+
+#ifndef HFT_COMMON_MIRROREDBUFFER_HPP
+#define HFT_COMMON_MIRROREDBUFFER_HPP
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <sys/mman.h>
+#include <system_error>
+#include <unistd.h>
+#include <utility>
+
+#include "container_types.hpp"
+#include "primitive_types.hpp"
+
+namespace hft {
+
+/**
+ * @brief Byte ring mapped twice back to back in virtual memory, same interface as SlidingBuffer
+ * @details Bytes written past the end of the first mapping land at the start of the ring,
+ * so both the free space and the unread data are always one contiguous span. Nothing is moved
+ * around on reads and the whole free capacity is always handed out for the next read
+ */
+class MirroredBuffer {
+public:
+  explicit MirroredBuffer(size_t capacity = 1024 * 128) : capacity_{alignCapacity(capacity)} {
+    const int fd = ::memfd_create("hft_mirrored_buffer", MFD_CLOEXEC);
+    if (fd == -1) {
+      throw std::system_error(errno, std::generic_category(), "memfd_create failed");
+    }
+    if (::ftruncate(fd, capacity_) == -1) {
+      fail(fd, nullptr, "ftruncate failed");
+    }
+    // reserve both halves at once, so the second mapping sits right after the first one
+    void *base = ::mmap(nullptr, capacity_ * 2, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (base == MAP_FAILED) {
+      fail(fd, nullptr, "mmap reserve failed");
+    }
+    auto *bytes = static_cast<uint8_t *>(base);
+    for (uint8_t *half : {bytes, bytes + capacity_}) {
+      if (::mmap(half, capacity_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) ==
+          MAP_FAILED) {
+        fail(fd, bytes, "mmap mirror failed");
+      }
+    }
+    ::close(fd);
+    data_ = bytes;
+  }
+
+  MirroredBuffer(MirroredBuffer &&other) noexcept
+      : data_{std::exchange(other.data_, nullptr)}, capacity_{other.capacity_},
+        head_{std::exchange(other.head_, 0)}, tail_{std::exchange(other.tail_, 0)} {}
+
+  MirroredBuffer &operator=(MirroredBuffer &&other) noexcept {
+    if (this != &other) {
+      unmap();
+      data_ = std::exchange(other.data_, nullptr);
+      capacity_ = other.capacity_;
+      head_ = std::exchange(other.head_, 0);
+      tail_ = std::exchange(other.tail_, 0);
+    }
+    return *this;
+  }
+
+  MirroredBuffer(const MirroredBuffer &) = delete;
+  MirroredBuffer &operator=(const MirroredBuffer &) = delete;
+
+  ~MirroredBuffer() { unmap(); }
+
+  inline auto buffer() noexcept -> ByteSpan {
+    return ByteSpan(data_ + (head_ & (capacity_ - 1)), capacity_ - (head_ - tail_));
+  }
+
+  inline auto data() noexcept -> ByteSpan {
+    return ByteSpan(data_ + (tail_ & (capacity_ - 1)), head_ - tail_);
+  }
+
+  inline bool commitWrite(size_t bytes) noexcept {
+    if (head_ - tail_ + bytes > capacity_) [[unlikely]] {
+      return false;
+    }
+    head_ += bytes;
+    return true;
+  }
+
+  inline void commitRead(size_t bytes) noexcept {
+    assert(tail_ + bytes <= head_);
+    tail_ += bytes;
+  }
+
+  inline void reset() noexcept { tail_ = head_ = 0; }
+
+  inline size_t capacity() const noexcept { return capacity_; }
+
+private:
+  /**
+   * @brief Mapping needs whole pages, masking needs a power of two
+   */
+  static size_t alignCapacity(size_t capacity) {
+    const auto page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+    return std::bit_ceil(std::max(capacity, page));
+  }
+
+  [[noreturn]] void fail(int fd, uint8_t *base, const char *what) {
+    const int error = errno;
+    if (base != nullptr) {
+      ::munmap(base, capacity_ * 2);
+    }
+    ::close(fd);
+    throw std::system_error(error, std::generic_category(), what);
+  }
+
+  inline void unmap() noexcept {
+    if (data_ != nullptr) {
+      ::munmap(data_, capacity_ * 2);
+      data_ = nullptr;
+    }
+  }
+
+private:
+  uint8_t *data_{nullptr};
+  size_t capacity_;
+
+  // monotonic positions, only masked when turned into addresses
+  size_t head_{0};
+  size_t tail_{0};
+};
+
+} // namespace hft
+
+#endif // HFT_COMMON_MIRROREDBUFFER_HPP
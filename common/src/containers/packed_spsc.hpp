@@ -0,0 +1,169 @@
+/**
+ * @author Vladimir Pavliv
+ * @date 2026-02-11
+ */
+
+#ifndef HFT_COMMON_PACKEDSPSC_HPP
+#define HFT_COMMON_PACKEDSPSC_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+#include "logging.hpp"
+#include "primitive_types.hpp"
+#include "ptr_types.hpp"
+
+namespace hft {
+
+/**
+ * @brief Byte ring spsc queue of length-prefixed records, meant for shared memory
+ * records are packed back to back with 8 byte alignment, so small messages share cache lines
+ * instead of taking a 64 byte slot each, a record never wraps, the end of the ring is skipped
+ * with a padding record instead
+ * record becomes visible only when the tail is published after it is fully written,
+ * so a producer dying mid-write leaves nothing torn behind, consumer publishes the head
+ * after the records are copied, so a consumer dying mid-read gets them again on restart
+ * record sizes are checked against the published tail, garbage left by a crashed peer
+ * is dropped instead of being read past the end of the data
+ * both sides keep a cached copy of the other cursor, so they only meet when the cache runs out
+ */
+template <size_t Capacity = 8 * 1024 * 1024>
+class PackedSPSC {
+  static_assert((Capacity & (Capacity - 1)) == 0);
+
+  using Header = uint32_t;
+
+  static constexpr uint64_t MASK = Capacity - 1;
+  static constexpr uint32_t ALIGN = 8;
+  static constexpr Header PADDING = std::numeric_limits<Header>::max();
+
+public:
+  static constexpr uint32_t MAX_DATA_SIZE = 4096;
+  static_assert(Capacity >= 4 * MAX_DATA_SIZE);
+
+  template <typename T>
+  inline bool write(CRef<T> msg) {
+    return write(reinterpret_cast<const uint8_t *>(&msg), sizeof(T));
+  }
+
+  inline bool write(const uint8_t *__restrict__ src, uint32_t size) noexcept {
+    if (size == 0 || size > MAX_DATA_SIZE) {
+      return false;
+    }
+    const uint64_t tail = tail_.load(std::memory_order_relaxed);
+    const uint64_t pos = tail & MASK;
+    const uint64_t length = recordSize(size);
+    const uint64_t skip = (pos + length > Capacity) ? Capacity - pos : 0;
+
+    if (tail + skip + length > headCache_ + Capacity) {
+      headCache_ = head_.load(std::memory_order_acquire);
+      if (tail + skip + length > headCache_ + Capacity) {
+        return false;
+      }
+    }
+    if (skip != 0) {
+      storeHeader(pos, PADDING);
+    }
+    const uint64_t at = (tail + skip) & MASK;
+    storeHeader(at, size);
+    std::memcpy(buffer_ + at + sizeof(Header), src, size);
+
+    tail_.store(tail + skip + length, std::memory_order_release);
+    return true;
+  }
+
+  template <typename T>
+  inline uint32_t read(T &msg) {
+    return read(reinterpret_cast<uint8_t *>(&msg), sizeof(T));
+  }
+
+  inline uint32_t read(uint8_t *__restrict__ dst, uint32_t maxSize) noexcept {
+    return consume(dst, maxSize, 1);
+  }
+
+  /**
+   * @brief Reads consecutive records back to back while they fit into the buffer
+   * @return number of bytes read
+   */
+  inline uint32_t readBatch(uint8_t *__restrict__ dst, uint32_t maxSize) noexcept {
+    return consume(dst, maxSize, std::numeric_limits<uint32_t>::max());
+  }
+
+  /**
+   * @brief Consumer side check
+   */
+  inline bool empty() const noexcept {
+    return head_.load(std::memory_order_relaxed) == tail_.load(std::memory_order_acquire);
+  }
+
+private:
+  static constexpr uint64_t recordSize(uint32_t size) {
+    return (sizeof(Header) + size + ALIGN - 1) & ~static_cast<uint64_t>(ALIGN - 1);
+  }
+
+  inline void storeHeader(uint64_t pos, Header header) noexcept {
+    std::memcpy(buffer_ + pos, &header, sizeof(Header));
+  }
+
+  inline Header loadHeader(uint64_t pos) const noexcept {
+    Header header;
+    std::memcpy(&header, buffer_ + pos, sizeof(Header));
+    return header;
+  }
+
+  uint32_t consume(uint8_t *__restrict__ dst, uint32_t maxSize, uint32_t maxRecords) noexcept {
+    uint64_t head = head_.load(std::memory_order_relaxed);
+    if (head == tailCache_) {
+      tailCache_ = tail_.load(std::memory_order_acquire);
+      if (head == tailCache_) {
+        return 0;
+      }
+    }
+    uint32_t bytes = 0;
+    uint32_t records = 0;
+    while (head != tailCache_ && records < maxRecords) {
+      const uint64_t pos = head & MASK;
+      const Header size = loadHeader(pos);
+      if (size == PADDING && head + Capacity - pos <= tailCache_) {
+        head += Capacity - pos;
+        continue;
+      }
+      if (UNLIKELY(size == 0 || size > MAX_DATA_SIZE || head + recordSize(size) > tailCache_)) {
+        LOG_ERROR("Corrupted record of {} bytes, dropping queued data", size);
+        head = tailCache_;
+        break;
+      }
+      if (bytes + size > maxSize) {
+        if (bytes == 0) {
+          LOG_ERROR("Buffer is too small, data {} buffer {}", size, maxSize);
+        }
+        break;
+      }
+      std::memcpy(dst + bytes, buffer_ + pos + sizeof(Header), size);
+      bytes += size;
+      head += recordSize(size);
+      ++records;
+    }
+    head_.store(head, std::memory_order_release);
+    return bytes;
+  }
+
+private:
+  // data first so it fills up the huge pages nicely
+  ALIGN_CL uint8_t buffer_[Capacity];
+
+  // consumer side
+  ALIGN_CL AtomicUInt64 head_{0};
+  uint64_t tailCache_{0};
+
+  // producer side
+  ALIGN_CL AtomicUInt64 tail_{0};
+  uint64_t headCache_{0};
+};
+
+} // namespace hft
+
+#endif // HFT_COMMON_PACKEDSPSC_HPP
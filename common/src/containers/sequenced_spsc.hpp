@@ -6,6 +6,7 @@
 #ifndef HFT_COMMON_SLOTHSPSCQUEUE_HPP
 #define HFT_COMMON_SLOTHSPSCQUEUE_HPP
 
+#include <algorithm>
 #include <array>
 #include <atomic>
 #include <cassert>
@@ -13,6 +14,7 @@
 #include <cstdint>
 
 #include "constants.hpp"
+#include "container_types.hpp"
 #include "logging.hpp"
 #include "primitive_types.hpp"
 #include "ptr_types.hpp"
@@ -21,12 +23,18 @@ namespace hft {
 
 /**
  * @brief Slot based spsc queue for small messages
+ * batch write claims a run of slots with a single check of its last slot, slots are freed
+ * in order so the rest of the run is free as well, run is published first slot last,
+ * so the reader either sees the whole run or nothing of it
  */
 template <size_t SlotCount = 65536>
 class SequencedSPSC {
   static_assert((SlotCount & (SlotCount - 1)) == 0);
 
+public:
   static constexpr uint32_t MAX_DATA_SIZE = 52;
+
+private:
   static constexpr uint32_t MASK = SlotCount - 1;
 
   struct alignas(64) Sloth {
@@ -86,6 +94,95 @@ public:
     return sloth.size;
   }
 
+  /**
+   * @brief Writes a run of messages, run that does not fit is halved until it does
+   * @return number of messages written
+   */
+  template <typename T>
+  inline size_t writeBatch(Span<const T> msgs) noexcept {
+    static_assert(sizeof(T) <= MAX_DATA_SIZE);
+    size_t count = std::min(msgs.size(), SlotCount);
+    while (count != 0 && !isFree(writeIdx_ + count - 1)) {
+      count /= 2;
+    }
+    if (count == 0) {
+      return 0;
+    }
+    for (size_t idx = count; idx-- > 0;) {
+      Sloth &sloth = slots_[(writeIdx_ + idx) & MASK];
+      std::memcpy(sloth.data, &msgs[idx], sizeof(T));
+      sloth.size = sizeof(T);
+      sloth.seq.store(writeIdx_ + idx + 1, std::memory_order_release);
+    }
+    writeIdx_ += count;
+    return count;
+  }
+
+  /**
+   * @brief Reads up to out.size() messages, slots are freed once all of them are copied
+   * @return number of messages read
+   */
+  template <typename T>
+  inline size_t readBatch(Span<T> out) noexcept {
+    size_t count = 0;
+    while (count < out.size() && isReady(readIdx_ + count)) {
+      const Sloth &sloth = slots_[(readIdx_ + count) & MASK];
+      if (sloth.size > sizeof(T)) {
+        LOG_ERROR("Buffer is too small, data {} buffer {}", sloth.size, sizeof(T));
+        break;
+      }
+      std::memcpy(&out[count], sloth.data, sloth.size);
+      ++count;
+    }
+    release(count);
+    return count;
+  }
+
+  /**
+   * @brief Reads consecutive messages back to back while they fit into the buffer
+   * @return number of bytes read
+   */
+  inline uint32_t readBatch(uint8_t *__restrict__ dst, uint32_t maxSize) noexcept {
+    uint32_t bytes = 0;
+    size_t count = 0;
+    while (count < SlotCount && isReady(readIdx_ + count)) {
+      const Sloth &sloth = slots_[(readIdx_ + count) & MASK];
+      if (bytes + sloth.size > maxSize) {
+        if (count == 0) {
+          LOG_ERROR("Buffer is too small, data {} buffer {}", sloth.size, maxSize);
+        }
+        break;
+      }
+      std::memcpy(dst + bytes, sloth.data, sloth.size);
+      bytes += sloth.size;
+      ++count;
+    }
+    release(count);
+    return bytes;
+  }
+
+  /**
+   * @brief Consumer side check
+   */
+  inline bool empty() const noexcept { return !isReady(readIdx_); }
+
+private:
+  inline bool isFree(uint64_t idx) const noexcept {
+    return slots_[idx & MASK].seq.load(std::memory_order_acquire) == idx;
+  }
+
+  inline bool isReady(uint64_t idx) const noexcept {
+    return slots_[idx & MASK].seq.load(std::memory_order_acquire) == idx + 1;
+  }
+
+  inline void release(size_t count) noexcept {
+    for (size_t idx = 0; idx < count; ++idx) {
+      slots_[(readIdx_ + idx) & MASK].seq.store(readIdx_ + idx + SlotCount,
+                                                std::memory_order_release);
+    }
+    readIdx_ += count;
+  }
+
 private:
   // data first so it fills up the huge pages nicely
   alignas(64) Sloth slots_[SlotCount];
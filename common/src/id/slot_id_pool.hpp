@@ -7,6 +7,7 @@
 #define HFT_SERVER_SLOTIDPOOL_HPP
 
 #include "constants.hpp"
+#include "container_types.hpp"
 #include "containers/huge_array.hpp"
 #include "logging.hpp"
 #include "primitive_types.hpp"
@@ -46,6 +47,33 @@ public:
     tail_.store((t + 1) & MASK, std::memory_order_release);
   }
 
+  /**
+   * @brief Takes ids restored from a snapshot out of the pool, called before the first acquire
+   * fresh ids continue past the highest taken index, free indexes below it are queued as released
+   */
+  void reserve(Span<const IdType> taken) {
+    uint32_t top = 0;
+    for (const auto id : taken) {
+      top = std::max(top, id.index());
+    }
+    if (top < nextFreshIdx_) {
+      return;
+    }
+    Vector<bool> used(top + 1, false);
+    for (const auto id : taken) {
+      used[id.index()] = true;
+    }
+    uint32_t t = tail_.load(std::memory_order_relaxed);
+    for (uint32_t idx = nextFreshIdx_; idx <= top; ++idx) {
+      if (!used[idx]) {
+        sharedQueue_[t] = IdType::make(idx, 1);
+        t = (t + 1) & MASK;
+      }
+    }
+    tail_.store(t, std::memory_order_release);
+    nextFreshIdx_ = top + 1;
+  }
+
 private:
   IdType refill() noexcept {
     LOG_DEBUG("refilling");
@@ -9,6 +9,9 @@
 #ifdef SERIALIZATION_SBE
 #include "serialization/sbe/sbe_domain_serializer.hpp"
 #include "transport/framing/dummy_framer.hpp"
+#elif defined(SERIALIZATION_RAW)
+#include "serialization/raw/raw_domain_serializer.hpp"
+#include "transport/framing/dummy_framer.hpp"
 #else
 #include "serialization/fbs/fbs_domain_serializer.hpp"
 #include "transport/framing/fixed_size_framer.hpp"
@@ -18,6 +21,9 @@ namespace hft {
 #ifdef SERIALIZATION_SBE
 using DomainSerializer = serialization::sbe::SbeDomainSerializer;
 using Framer = DummyFramer<DomainSerializer>;
+#elif defined(SERIALIZATION_RAW)
+using DomainSerializer = serialization::raw::RawDomainSerializer;
+using Framer = DummyFramer<DomainSerializer>;
 #else
 using DomainSerializer = serialization::fbs::FbsDomainSerializer;
 using Framer = FixedSizeFramer<DomainSerializer>;
@@ -6,6 +6,8 @@
 #ifndef HFT_COMMON_LFQRUNNER_HPP
 #define HFT_COMMON_LFQRUNNER_HPP
 
+#include <array>
+#include <concepts>
 #include <memory>
 #include <thread>
 
@@ -26,13 +28,31 @@
 namespace hft {
 
 /**
- * @brief
+ * @brief Runs consumer on a dedicated thread, spins and then sleeps on a futex when idle
+ * consumer may provide flush(), it is called after each drained batch so it could
+ * publish whatever it conflated while processing the batch, notify() wakes the runner up
+ * to reach that point even if there are no messages
+ * consumer may also provide prefetch(), then messages are drained in batches of BATCH_SIZE,
+ * consumer gets to prefetch the whole batch before any of it is processed,
+ * processing order stays the same
+ * consumer may also provide poll(), it takes work from sources of the consumer's own
+ * after each drained batch and whenever the queue is empty, returns whether it found any,
+ * producers of those sources call wakeUp() after writing
  */
 template <typename MessageT, typename ConsumerT, typename BusT, size_t Capacity = 65536>
 class LfqRunner {
   using SelfT = LfqRunner<MessageT, ConsumerT, BusT, Capacity>;
   using Queue = SequencedSPSC<Capacity>;
 
+  static constexpr size_t DRAIN_LIMIT = 1024;
+  static constexpr size_t BATCH_SIZE = 16;
+  static constexpr bool PREFETCHING = requires(ConsumerT &consumer, CRef<MessageT> message) {
+    consumer.prefetch(message);
+  };
+  static constexpr bool POLLING = requires(ConsumerT &consumer) {
+    { consumer.poll() } -> std::same_as<bool>;
+  };
+
 public:
   LfqRunner(ConsumerT &consumer, BusT &bus, std::stop_token stopToken, String name,
             Optional<CoreId> coreId = std::nullopt, bool feedFromBus = false)
@@ -88,6 +108,11 @@ public:
     LOG_DEBUG("LfqRunner {} stopped", name_);
   }
 
+  void notify() {
+    ftx_.fetch_add(1, std::memory_order_release);
+    utils::futexWake(ftx_);
+  }
+
   inline void post(CRef<MessageT> message) {
     LOG_DEBUG("{}", toString(message));
     if (stopToken_.stop_requested()) {
@@ -104,6 +129,39 @@ public:
         break;
       }
     }
+    wakeUp();
+  }
+
+  /**
+   * @brief Writes the whole burst before waking the consumer up, so it is woken once
+   */
+  inline void post(Span<const MessageT> messages) {
+    LOG_DEBUG("LfqRunner {} burst of {}", name_, messages.size());
+    if (stopToken_.stop_requested()) {
+      return;
+    }
+    SpinWait waiter;
+    while (!messages.empty()) {
+      const size_t written = queue_.writeBatch(messages);
+      if (written != 0) {
+        messages = messages.subspan(written);
+        continue;
+      }
+      // queue is full, consumer has to drain it
+      wakeUp();
+      if (!++waiter) {
+        bus_.post(
+            InternalError{StatusCode::Error, std::format("Failed to post to LfqRunner {}", name_)});
+        break;
+      }
+    }
+    wakeUp();
+  }
+
+  /**
+   * @brief Wakes the runner up if it sleeps, cheap enough to call after every write
+   */
+  inline void wakeUp() {
     if (sleeping_.load(std::memory_order_seq_cst)) [[unlikely]] {
       ftx_.fetch_add(1, std::memory_order_release);
       utils::futexWake(ftx_);
@@ -119,11 +177,27 @@ private:
 
     SpinWait waiter;
     while (!stopToken_.stop_requested()) {
-      if (queue_.read(msgPtr, msgSize)) {
+      if constexpr (PREFETCHING) {
+        if (drainBatches()) {
+          waiter.reset();
+          poll();
+          flush();
+          continue;
+        }
+      } else if (queue_.read(msgPtr, msgSize)) {
         waiter.reset();
+        size_t drained = 0;
         do {
           consumer_.post(message);
-        } while (queue_.read(msgPtr, msgSize) && !stopToken_.stop_requested());
+        } while (++drained < DRAIN_LIMIT && queue_.read(msgPtr, msgSize) &&
+                 !stopToken_.stop_requested());
+        poll();
+        flush();
+        continue;
+      }
+      if (poll()) {
+        waiter.reset();
+        flush();
         continue;
       }
       if (++waiter || stopToken_.stop_requested()) {
@@ -135,6 +209,13 @@ private:
       if (queue_.read(msgPtr, msgSize)) {
         sleeping_.store(false, std::memory_order_release);
         consumer_.post(message);
+        flush();
+        waiter.reset();
+        continue;
+      }
+      if (poll()) {
+        sleeping_.store(false, std::memory_order_release);
+        flush();
         waiter.reset();
         continue;
       }
@@ -142,16 +223,54 @@ private:
       if (stopToken_.stop_requested()) {
         break;
       }
+      flush();
 
       LOG_DEBUG("futex sleep {} {}", name_, ftxVal);
       utils::futexWait(ftx_, ftxVal);
       LOG_DEBUG("futex awake {} {}", name_, ftxVal);
       sleeping_.store(false, std::memory_order_release);
+      flush();
       waiter.reset();
     }
     LOG_DEBUG_SYSTEM("LfqRunner::lfqLoop {} leave", name_);
   }
 
+  /**
+   * @brief Reads up to DRAIN_LIMIT messages batch by batch, a short batch means queue is empty
+   */
+  bool drainBatches() {
+    std::array<MessageT, BATCH_SIZE> batch;
+    size_t drained = 0;
+    while (drained < DRAIN_LIMIT && !stopToken_.stop_requested()) {
+      const size_t count = queue_.readBatch(Span<MessageT>{batch});
+      for (size_t idx = 0; idx < count; ++idx) {
+        consumer_.prefetch(batch[idx]);
+      }
+      for (size_t idx = 0; idx < count; ++idx) {
+        consumer_.post(batch[idx]);
+      }
+      drained += count;
+      if (count < BATCH_SIZE) {
+        break;
+      }
+    }
+    return drained != 0;
+  }
+
+  inline bool poll() {
+    if constexpr (POLLING) {
+      return consumer_.poll();
+    } else {
+      return false;
+    }
+  }
+
+  inline void flush() {
+    if constexpr (requires(ConsumerT &consumer) { consumer.flush(); }) {
+      consumer_.flush();
+    }
+  }
+
 private:
   ConsumerT &consumer_;
   BusT &bus_;
@@ -10,16 +10,21 @@
 #include "fbs/cpp/domain_messages_generated.h"
 #include "logging.hpp"
 #include "primitive_types.hpp"
+#include "ptr_types.hpp"
 
 namespace hft::serialization::fbs {
 
-inline Ticker fbStringToTicker(const flatbuffers::String *str) {
+inline Ticker fbStructToTicker(const gen::fbs::domain::TickerCode *code) {
   Ticker ticker{};
-  const auto size = std::min((size_t)str->size(), TICKER_SIZE);
-  std::memcpy(ticker.data(), str->data(), size);
+  std::memcpy(ticker.data(), code->code()->Data(), TICKER_SIZE);
   return ticker;
 }
 
+inline gen::fbs::domain::TickerCode tickerToFbStruct(CRef<Ticker> ticker) {
+  return gen::fbs::domain::TickerCode{flatbuffers::span<const uint8_t, TICKER_SIZE>(
+      reinterpret_cast<const uint8_t *>(ticker.data()), TICKER_SIZE)};
+}
+
 inline String fbStringToString(const flatbuffers::String *str) {
   return String(str->c_str(), str->size());
 }
@@ -58,6 +63,39 @@ inline gen::fbs::domain::OrderAction convert(OrderAction action) {
   }
 }
 
+inline OrderType convert(gen::fbs::domain::OrderType type) {
+  switch (type) {
+  case gen::fbs::domain::OrderType::OrderType_LIMIT:
+    return OrderType::Limit;
+  case gen::fbs::domain::OrderType::OrderType_MARKET:
+    return OrderType::Market;
+  case gen::fbs::domain::OrderType::OrderType_IOC:
+    return OrderType::Ioc;
+  case gen::fbs::domain::OrderType::OrderType_FOK:
+    return OrderType::Fok;
+  case gen::fbs::domain::OrderType::OrderType_POST_ONLY:
+    return OrderType::PostOnly;
+  default:
+    throw std::runtime_error(std::format("Unknown gen::fbs::domain::OrderType {}", (uint8_t)type));
+  }
+}
+inline gen::fbs::domain::OrderType convert(OrderType type) {
+  switch (type) {
+  case OrderType::Limit:
+    return gen::fbs::domain::OrderType::OrderType_LIMIT;
+  case OrderType::Market:
+    return gen::fbs::domain::OrderType::OrderType_MARKET;
+  case OrderType::Ioc:
+    return gen::fbs::domain::OrderType::OrderType_IOC;
+  case OrderType::Fok:
+    return gen::fbs::domain::OrderType::OrderType_FOK;
+  case OrderType::PostOnly:
+    return gen::fbs::domain::OrderType::OrderType_POST_ONLY;
+  default:
+    throw std::runtime_error(std::format("Unknown OrderType {}", (uint8_t)type));
+  }
+}
+
 inline OrderState convert(gen::fbs::domain::OrderState state) {
   switch (state) {
   case gen::fbs::domain::OrderState::OrderState_Accepted:
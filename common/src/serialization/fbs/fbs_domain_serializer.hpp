@@ -6,6 +6,8 @@
 #ifndef HFT_COMMON_SERIALIZATION_FBSSERIALIZER_HPP
 #define HFT_COMMON_SERIALIZATION_FBSSERIALIZER_HPP
 
+#include <cstring>
+
 #include "bus/busable.hpp"
 #include "constants.hpp"
 #include "domain_types.hpp"
@@ -21,6 +23,11 @@ namespace hft::serialization::fbs {
 
 /**
  * @brief Flat buffers serializer
+ * @details Each thread reuses one builder, it is given the caller buffer as storage,
+ * so serializing does not allocate as long as the message fits MAX_MESSAGE_SIZE,
+ * batches have a builder of their own sized for MAX_BATCH_MESSAGE_SIZE.
+ * Order batch is posted whole, so the gateway sees where the burst ends,
+ * status batch is unpacked into consecutive OrderStatus posts
  */
 class FbsDomainSerializer {
 public:
@@ -28,12 +35,19 @@ public:
   using MessageType = gen::fbs::domain::MessageUnion;
   using BufferType = flatbuffers::DetachedBuffer;
 
-  using SupportedTypes =
-      std::tuple<LoginRequest, TokenBindRequest, LoginResponse, Order, OrderStatus, TickerPrice>;
+  using SupportedTypes = std::tuple<LoginRequest, TokenBindRequest, LoginResponse, Order,
+                                    OrderStatus, TickerPrice, OrderBatch, OrderStatusBatch>;
 
   template <typename EventType>
   static constexpr bool Serializable = utils::IsTypeInTuple<EventType, SupportedTypes>;
 
+  /**
+   * @brief Storage handed to the builder, framed message has to fit the pool buffer
+   */
+  static constexpr size_t MAX_MESSAGE_SIZE = 120;
+  static constexpr size_t MAX_BATCH_MESSAGE_SIZE = 4088;
+  static constexpr size_t MIN_ALIGN = 8;
+
   static auto deserialize(const uint8_t *data, size_t size,
                           Busable auto &consumer) -> Expected<size_t> {
     if (!flatbuffers::Verifier(data, size).VerifyBuffer<Message>()) {
@@ -79,12 +93,13 @@ public:
     }
     case MessageType::MessageUnion_Order: {
       const auto orderMsg = message->message_as_Order();
-      if (orderMsg == nullptr) {
+      if (orderMsg == nullptr || orderMsg->ticker() == nullptr) {
         LOG_ERROR("Failed to extract Order");
         return std::unexpected(StatusCode::Error);
       }
-      const Order order{orderMsg->id(), fbStringToTicker(orderMsg->ticker()), orderMsg->quantity(),
-                        orderMsg->price(), convert(orderMsg->action())};
+      const Order order{orderMsg->id(), fbStructToTicker(orderMsg->ticker()), orderMsg->quantity(),
+                        orderMsg->price(), convert(orderMsg->action()),
+                        convert(orderMsg->type())};
       consumer.post(order);
       break;
     }
@@ -102,14 +117,43 @@ public:
     }
     case MessageType::MessageUnion_TickerPrice: {
       const auto priceMsg = message->message_as_TickerPrice();
-      if (priceMsg == nullptr) {
+      if (priceMsg == nullptr || priceMsg->ticker() == nullptr) {
         LOG_ERROR("Failed to extract TickerPrice");
         return std::unexpected(StatusCode::Error);
       }
-      const TickerPrice price{fbStringToTicker(priceMsg->ticker()), priceMsg->price()};
+      const TickerPrice price{fbStructToTicker(priceMsg->ticker()), priceMsg->price()};
       consumer.post(price);
       break;
     }
+    case MessageType::MessageUnion_OrderBatch: {
+      const auto batchMsg = message->message_as_OrderBatch();
+      if (batchMsg == nullptr || batchMsg->orders() == nullptr ||
+          batchMsg->orders()->size() > ORDER_BATCH_CAPACITY) {
+        LOG_ERROR("Failed to extract OrderBatch");
+        return std::unexpected(StatusCode::Error);
+      }
+      OrderBatch batch;
+      for (const auto *entry : *batchMsg->orders()) {
+        const Order order{entry->id(), fbStructToTicker(&entry->ticker()), entry->quantity(),
+                          entry->price(), convert(entry->action()), convert(entry->type())};
+        batch.orders[batch.count++] = order;
+      }
+      consumer.post(batch);
+      break;
+    }
+    case MessageType::MessageUnion_OrderStatusBatch: {
+      const auto batchMsg = message->message_as_OrderStatusBatch();
+      if (batchMsg == nullptr || batchMsg->statuses() == nullptr) {
+        LOG_ERROR("Failed to extract OrderStatusBatch");
+        return std::unexpected(StatusCode::Error);
+      }
+      for (const auto *entry : *batchMsg->statuses()) {
+        const OrderStatus status{entry->order_id(), entry->system_order_id(), entry->quantity(),
+                                 entry->fill_price(), convert(entry->state())};
+        consumer.post(status);
+      }
+      break;
+    }
     default:
       LOG_ERROR("Unknown message type {}", static_cast<uint8_t>(type));
       return std::unexpected(StatusCode::Error);
@@ -119,76 +163,148 @@ public:
 
   static size_t serialize(CRef<LoginRequest> request, uint8_t *buffer) {
     using namespace gen::fbs::domain;
-    flatbuffers::FlatBufferBuilder builder;
-    const auto msg = CreateLoginRequest(
-        builder, builder.CreateString(request.name.c_str(), request.name.length()),
-        builder.CreateString(request.password.c_str(), request.password.length()));
-    builder.Finish(CreateMessage(builder, MessageUnion_LoginRequest, msg.Union()));
-    const auto serializedMsg = builder.Release();
-
-    std::memcpy(buffer, serializedMsg.data(), serializedMsg.size());
-    return serializedMsg.size();
+    return build(buffer, [&request](flatbuffers::FlatBufferBuilder &builder) {
+      const auto msg = CreateLoginRequest(
+          builder, builder.CreateString(request.name.c_str(), request.name.length()),
+          builder.CreateString(request.password.c_str(), request.password.length()));
+      builder.Finish(CreateMessage(builder, MessageUnion_LoginRequest, msg.Union()));
+    });
   }
 
   static size_t serialize(CRef<TokenBindRequest> request, uint8_t *buffer) {
     using namespace gen::fbs::domain;
-    flatbuffers::FlatBufferBuilder builder;
-    const auto msg = CreateTokenBindRequest(builder, request.token);
-    builder.Finish(CreateMessage(builder, MessageUnion_TokenBindRequest, msg.Union()));
-    const auto serializedMsg = builder.Release();
-
-    std::memcpy(buffer, serializedMsg.data(), serializedMsg.size());
-    return serializedMsg.size();
+    return build(buffer, [&request](flatbuffers::FlatBufferBuilder &builder) {
+      const auto msg = CreateTokenBindRequest(builder, request.token);
+      builder.Finish(CreateMessage(builder, MessageUnion_TokenBindRequest, msg.Union()));
+    });
   }
 
   static size_t serialize(CRef<LoginResponse> response, uint8_t *buffer) {
     using namespace gen::fbs::domain;
-    flatbuffers::FlatBufferBuilder builder;
-    const auto msg =
-        CreateLoginResponse(builder, response.token, response.ok,
-                            builder.CreateString(response.error.c_str(), response.error.length()));
-    builder.Finish(CreateMessage(builder, MessageUnion_LoginResponse, msg.Union()));
-    const auto serializedMsg = builder.Release();
-
-    std::memcpy(buffer, serializedMsg.data(), serializedMsg.size());
-    return serializedMsg.size();
+    return build(buffer, [&response](flatbuffers::FlatBufferBuilder &builder) {
+      const auto msg = CreateLoginResponse(
+          builder, response.token, response.ok,
+          builder.CreateString(response.error.c_str(), response.error.length()));
+      builder.Finish(CreateMessage(builder, MessageUnion_LoginResponse, msg.Union()));
+    });
   }
 
   static size_t serialize(CRef<Order> order, uint8_t *buffer) {
     using namespace gen::fbs::domain;
-    flatbuffers::FlatBufferBuilder builder;
-    const auto msg =
-        CreateOrder(builder, order.id, builder.CreateString(order.ticker.data(), TICKER_SIZE),
-                    order.quantity, order.price, convert(order.action));
-    builder.Finish(CreateMessage(builder, MessageUnion_Order, msg.Union()));
-    const auto serializedMsg = builder.Release();
-
-    std::memcpy(buffer, serializedMsg.data(), serializedMsg.size());
-    return serializedMsg.size();
+    return build(buffer, [&order](flatbuffers::FlatBufferBuilder &builder) {
+      const TickerCode ticker = tickerToFbStruct(order.ticker);
+      const auto msg = CreateOrder(builder, order.id, &ticker, order.quantity, order.price,
+                                   convert(order.action), convert(order.type));
+      builder.Finish(CreateMessage(builder, MessageUnion_Order, msg.Union()));
+    });
   }
 
   static size_t serialize(CRef<OrderStatus> status, uint8_t *buffer) {
     using namespace gen::fbs::domain;
-    flatbuffers::FlatBufferBuilder builder;
-    const auto msg = CreateOrderStatus(builder, status.orderId, status.systemOrderId,
-                                       status.quantity, status.fillPrice, convert(status.state));
-    builder.Finish(CreateMessage(builder, MessageUnion_OrderStatus, msg.Union()));
-    const auto serializedMsg = builder.Release();
-
-    std::memcpy(buffer, serializedMsg.data(), serializedMsg.size());
-    return serializedMsg.size();
+    return build(buffer, [&status](flatbuffers::FlatBufferBuilder &builder) {
+      const auto msg = CreateOrderStatus(builder, status.orderId, status.systemOrderId,
+                                         status.quantity, status.fillPrice, convert(status.state));
+      builder.Finish(CreateMessage(builder, MessageUnion_OrderStatus, msg.Union()));
+    });
   }
 
   static size_t serialize(CRef<TickerPrice> price, uint8_t *buffer) {
     using namespace gen::fbs::domain;
-    flatbuffers::FlatBufferBuilder builder;
-    const auto msg = CreateTickerPrice(
-        builder, builder.CreateString(price.ticker.data(), TICKER_SIZE), price.price);
-    builder.Finish(CreateMessage(builder, MessageUnion_TickerPrice, msg.Union()));
-    const auto serializedMsg = builder.Release();
-
-    std::memcpy(buffer, serializedMsg.data(), serializedMsg.size());
-    return serializedMsg.size();
+    return build(buffer, [&price](flatbuffers::FlatBufferBuilder &builder) {
+      const TickerCode ticker = tickerToFbStruct(price.ticker);
+      const auto msg = CreateTickerPrice(builder, &ticker, price.price);
+      builder.Finish(CreateMessage(builder, MessageUnion_TickerPrice, msg.Union()));
+    });
+  }
+
+  static size_t serialize(CRef<OrderBatch> batch, uint8_t *buffer) {
+    using namespace gen::fbs::domain;
+    return build<MAX_BATCH_MESSAGE_SIZE>(
+        buffer, [&batch](flatbuffers::FlatBufferBuilder &builder) {
+          OrderEntry *entries = nullptr;
+          const auto orders = builder.CreateUninitializedVectorOfStructs(batch.count, &entries);
+          for (const auto &o : batch.view()) {
+            *entries++ = OrderEntry{o.id, tickerToFbStruct(o.ticker), o.quantity, o.price,
+                                    convert(o.action), convert(o.type)};
+          }
+          const auto msg = CreateOrderBatch(builder, orders);
+          builder.Finish(CreateMessage(builder, MessageUnion_OrderBatch, msg.Union()));
+        });
+  }
+
+  static size_t serialize(CRef<OrderStatusBatch> batch, uint8_t *buffer) {
+    using namespace gen::fbs::domain;
+    return build<MAX_BATCH_MESSAGE_SIZE>(
+        buffer, [&batch](flatbuffers::FlatBufferBuilder &builder) {
+          OrderStatusEntry *entries = nullptr;
+          const auto statuses = builder.CreateUninitializedVectorOfStructs(batch.count, &entries);
+          for (const auto &s : batch.view()) {
+            *entries++ = OrderStatusEntry{s.orderId, s.systemOrderId, s.quantity, s.fillPrice,
+                                          convert(s.state)};
+          }
+          const auto msg = CreateOrderStatusBatch(builder, statuses);
+          builder.Finish(CreateMessage(builder, MessageUnion_OrderStatusBatch, msg.Union()));
+        });
+  }
+
+private:
+  /**
+   * @brief Hands the caller buffer to the builder as its storage
+   * @details Anything bigger than the target goes to the heap, the way the default allocator does
+   */
+  template <size_t Capacity>
+  class TargetAllocator : public flatbuffers::Allocator {
+  public:
+    inline void target(uint8_t *buffer) noexcept { target_ = buffer; }
+
+    uint8_t *allocate(size_t size) override {
+      if (target_ != nullptr && size <= Capacity) {
+        return target_;
+      }
+      return new uint8_t[size];
+    }
+
+    void deallocate(uint8_t *ptr, size_t) override {
+      if (ptr != target_) {
+        delete[] ptr;
+      }
+    }
+
+  private:
+    uint8_t *target_{nullptr};
+  };
+
+  /**
+   * @brief Builder and its allocator reused by every serialize call of a thread
+   */
+  template <size_t Capacity>
+  struct ThreadBuilder {
+    TargetAllocator<Capacity> allocator;
+    flatbuffers::FlatBufferBuilder builder{Capacity, &allocator, false, MIN_ALIGN};
+  };
+
+  /**
+   * @brief Builds the message right in the buffer, flatbuffers fill the storage from its end,
+   * so the finished bytes are shifted to the buffer start
+   * @return Message size, 0 if the message outgrew the buffer and went to the heap
+   */
+  template <size_t Capacity = MAX_MESSAGE_SIZE, typename BuildFn>
+  static size_t build(uint8_t *buffer, BuildFn &&buildFn) {
+    static thread_local ThreadBuilder<Capacity> local;
+    local.allocator.target(buffer);
+    buildFn(local.builder);
+
+    const uint8_t *data = local.builder.GetBufferPointer();
+    const size_t size = local.builder.GetSize();
+    if (LIKELY(size <= Capacity)) {
+      std::memmove(buffer, data, size);
+    } else {
+      LOG_ERROR("Message of {} bytes does not fit {}", size, Capacity);
+    }
+    // drops the storage, so the builder never holds on to a buffer it was given
+    local.builder.Reset();
+    local.allocator.target(nullptr);
+    return size <= Capacity ? size : 0;
   }
 };
 
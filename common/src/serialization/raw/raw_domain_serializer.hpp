@@ -0,0 +1,354 @@
+/**
+ * @author Vladimir Pavliv
+ * @date 2026-02-23
+ */
+
+#ifndef HFT_COMMON_SERIALIZATION_RAWSERIALIZER_HPP
+#define HFT_COMMON_SERIALIZATION_RAWSERIALIZER_HPP
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+#include "bus/busable.hpp"
+#include "constants.hpp"
+#include "containers/buffer_pool.hpp"
+#include "domain_types.hpp"
+#include "functional_types.hpp"
+#include "logging.hpp"
+#include "primitive_types.hpp"
+#include "ptr_types.hpp"
+#include "ticker.hpp"
+#include "utils/trait_utils.hpp"
+
+namespace hft::serialization::raw {
+
+static_assert(std::endian::native == std::endian::little, "Raw wire layout is little endian");
+
+constexpr size_t RAW_STRING_SIZE = 32;
+
+enum class RawType : uint8_t {
+  LoginRequest,
+  TokenBindRequest,
+  LoginResponse,
+  Order,
+  OrderStatus,
+  TickerPrice,
+  OrderBatch,
+  OrderStatusBatch,
+  Count
+};
+
+#pragma pack(push, 1)
+struct RawLoginRequest {
+  RawType type;
+  char name[RAW_STRING_SIZE];
+  char password[RAW_STRING_SIZE];
+};
+
+struct RawTokenBindRequest {
+  RawType type;
+  Token token;
+};
+
+struct RawLoginResponse {
+  RawType type;
+  Token token;
+  uint8_t ok;
+  char error[RAW_STRING_SIZE];
+};
+
+struct RawOrder {
+  RawType type;
+  OrderId id;
+  Ticker ticker;
+  Quantity quantity;
+  Price price;
+  OrderAction action;
+  OrderType orderType;
+};
+
+struct RawOrderStatus {
+  RawType type;
+  OrderId orderId;
+  OrderId systemOrderId;
+  Quantity quantity;
+  Price fillPrice;
+  OrderState state;
+};
+
+struct RawTickerPrice {
+  RawType type;
+  Ticker ticker;
+  Price price;
+};
+
+/**
+ * @brief Batch is the header followed by count untagged entries
+ */
+struct RawBatchHeader {
+  RawType type;
+  uint16_t count;
+};
+
+struct RawOrderEntry {
+  OrderId id;
+  Ticker ticker;
+  Quantity quantity;
+  Price price;
+  OrderAction action;
+  OrderType orderType;
+};
+
+struct RawOrderStatusEntry {
+  OrderId orderId;
+  OrderId systemOrderId;
+  Quantity quantity;
+  Price fillPrice;
+  OrderState state;
+};
+#pragma pack(pop)
+
+static_assert(sizeof(RawLoginRequest) == 65);
+static_assert(sizeof(RawTokenBindRequest) == 9);
+static_assert(sizeof(RawLoginResponse) == 42);
+static_assert(sizeof(RawOrder) == 19);
+static_assert(offsetof(RawOrder, ticker) == 5 && offsetof(RawOrder, action) == 17);
+static_assert(sizeof(RawOrderStatus) == 18);
+static_assert(offsetof(RawOrderStatus, state) == 17);
+static_assert(sizeof(RawTickerPrice) == 9);
+static_assert(sizeof(RawBatchHeader) == 3);
+static_assert(sizeof(RawOrderEntry) == 18);
+static_assert(sizeof(RawOrderStatusEntry) == 17);
+static_assert(std::is_trivially_copyable_v<RawOrder>);
+static_assert(std::is_trivially_copyable_v<RawOrderStatus>);
+
+/**
+ * @brief Packed little endian structs with a one byte type tag, no schema and no versioning
+ * @details Meant for trusted links where both sides are built from the same tree.
+ * Every message but a batch has a fixed size, batch size follows from its count,
+ * so the stream is split by the tag alone and DummyFramer does.
+ * Incomplete message yields 0 bytes consumed, so the rest is read on the next pass.
+ * Order batch is posted whole, status batch is unpacked into consecutive OrderStatus posts
+ */
+class RawDomainSerializer {
+public:
+  using SupportedTypes = std::tuple<LoginRequest, TokenBindRequest, LoginResponse, Order,
+                                    OrderStatus, TickerPrice, OrderBatch, OrderStatusBatch>;
+
+  template <typename EventType>
+  static constexpr bool Serializable = utils::IsTypeInTuple<EventType, SupportedTypes>;
+
+  /**
+   * @brief Full order batch is the biggest message, it is framed into a BufferPool<4096> buffer
+   */
+  static constexpr size_t MAX_MESSAGE_SIZE =
+      sizeof(RawBatchHeader) + ORDER_BATCH_CAPACITY * sizeof(RawOrderEntry);
+  static_assert(MAX_MESSAGE_SIZE <= BufferPool<4096, 64>::BUFFER_CAPACITY);
+
+  /**
+   * @brief Dispatches through a table indexed by the type tag, unknown tags land on an error entry
+   */
+  template <Busable Consumer>
+  static auto deserialize(const uint8_t *buffer, size_t size,
+                          Consumer &consumer) -> Expected<size_t> {
+    if (UNLIKELY(size == 0)) {
+      return 0;
+    }
+    return DECODERS<Consumer>[buffer[0]](buffer, size, consumer);
+  }
+
+  static size_t serialize(CRef<LoginRequest> r, uint8_t *buffer) {
+    RawLoginRequest msg{RawType::LoginRequest, {}, {}};
+    putString(msg.name, r.name);
+    putString(msg.password, r.password);
+    return write(msg, buffer);
+  }
+
+  static size_t serialize(CRef<TokenBindRequest> r, uint8_t *buffer) {
+    return write(RawTokenBindRequest{RawType::TokenBindRequest, r.token}, buffer);
+  }
+
+  static size_t serialize(CRef<LoginResponse> r, uint8_t *buffer) {
+    RawLoginResponse msg{RawType::LoginResponse, r.token, r.ok, {}};
+    putString(msg.error, r.error);
+    return write(msg, buffer);
+  }
+
+  static size_t serialize(CRef<Order> r, uint8_t *buffer) {
+    return write(
+        RawOrder{RawType::Order, r.id, r.ticker, r.quantity, r.price, r.action, r.type}, buffer);
+  }
+
+  static size_t serialize(CRef<OrderStatus> r, uint8_t *buffer) {
+    return write(RawOrderStatus{RawType::OrderStatus, r.orderId, r.systemOrderId, r.quantity,
+                                r.fillPrice, r.state},
+                 buffer);
+  }
+
+  static size_t serialize(CRef<TickerPrice> r, uint8_t *buffer) {
+    return write(RawTickerPrice{RawType::TickerPrice, r.ticker, r.price}, buffer);
+  }
+
+  static size_t serialize(CRef<OrderBatch> r, uint8_t *buffer) {
+    size_t pos = write(RawBatchHeader{RawType::OrderBatch, r.count}, buffer);
+    for (const auto &o : r.view()) {
+      pos += write(RawOrderEntry{o.id, o.ticker, o.quantity, o.price, o.action, o.type},
+                   buffer + pos);
+    }
+    return pos;
+  }
+
+  static size_t serialize(CRef<OrderStatusBatch> r, uint8_t *buffer) {
+    size_t pos = write(RawBatchHeader{RawType::OrderStatusBatch, r.count}, buffer);
+    for (const auto &s : r.view()) {
+      pos += write(
+          RawOrderStatusEntry{s.orderId, s.systemOrderId, s.quantity, s.fillPrice, s.state},
+          buffer + pos);
+    }
+    return pos;
+  }
+
+private:
+  template <typename Consumer>
+  using Decoder = Expected<size_t> (*)(const uint8_t *, size_t, Consumer &);
+
+  template <typename Consumer>
+  static constexpr auto makeDecoders() {
+    std::array<Decoder<Consumer>, 256> decoders{};
+    decoders.fill(&decodeUnknown<Consumer>);
+    decoders[static_cast<uint8_t>(RawType::LoginRequest)] = &decode<RawLoginRequest, Consumer>;
+    decoders[static_cast<uint8_t>(RawType::TokenBindRequest)] =
+        &decode<RawTokenBindRequest, Consumer>;
+    decoders[static_cast<uint8_t>(RawType::LoginResponse)] = &decode<RawLoginResponse, Consumer>;
+    decoders[static_cast<uint8_t>(RawType::Order)] = &decode<RawOrder, Consumer>;
+    decoders[static_cast<uint8_t>(RawType::OrderStatus)] = &decode<RawOrderStatus, Consumer>;
+    decoders[static_cast<uint8_t>(RawType::TickerPrice)] = &decode<RawTickerPrice, Consumer>;
+    decoders[static_cast<uint8_t>(RawType::OrderBatch)] = &decodeOrderBatch<Consumer>;
+    decoders[static_cast<uint8_t>(RawType::OrderStatusBatch)] = &decodeStatusBatch<Consumer>;
+    return decoders;
+  }
+
+  template <typename Consumer>
+  static constexpr std::array<Decoder<Consumer>, 256> DECODERS = makeDecoders<Consumer>();
+
+  template <typename RawT, typename Consumer>
+  static auto decode(const uint8_t *buffer, size_t size, Consumer &consumer) -> Expected<size_t> {
+    if (size < sizeof(RawT)) {
+      return 0;
+    }
+    RawT msg;
+    std::memcpy(&msg, buffer, sizeof(RawT));
+    consumer.post(convert(msg));
+    return sizeof(RawT);
+  }
+
+  template <typename Consumer>
+  static auto decodeOrderBatch(const uint8_t *buffer, size_t size,
+                               Consumer &consumer) -> Expected<size_t> {
+    const auto total = batchSize<RawOrderEntry>(buffer, size);
+    if (!total || *total == 0) {
+      return total;
+    }
+    OrderBatch batch;
+    const uint8_t *cursor = buffer + sizeof(RawBatchHeader);
+    for (; cursor < buffer + *total; cursor += sizeof(RawOrderEntry)) {
+      RawOrderEntry entry;
+      std::memcpy(&entry, cursor, sizeof(RawOrderEntry));
+      batch.orders[batch.count++] = convert(entry);
+    }
+    consumer.post(batch);
+    return total;
+  }
+
+  template <typename Consumer>
+  static auto decodeStatusBatch(const uint8_t *buffer, size_t size,
+                                Consumer &consumer) -> Expected<size_t> {
+    const auto total = batchSize<RawOrderStatusEntry>(buffer, size);
+    if (!total || *total == 0) {
+      return total;
+    }
+    const uint8_t *cursor = buffer + sizeof(RawBatchHeader);
+    for (; cursor < buffer + *total; cursor += sizeof(RawOrderStatusEntry)) {
+      RawOrderStatusEntry entry;
+      std::memcpy(&entry, cursor, sizeof(RawOrderStatusEntry));
+      consumer.post(convert(entry));
+    }
+    return total;
+  }
+
+  /**
+   * @brief Whole batch size in bytes, 0 if it has not fully arrived yet
+   */
+  template <typename EntryT>
+  static auto batchSize(const uint8_t *buffer, size_t size) -> Expected<size_t> {
+    if (size < sizeof(RawBatchHeader)) {
+      return 0;
+    }
+    RawBatchHeader header;
+    std::memcpy(&header, buffer, sizeof(RawBatchHeader));
+    if (UNLIKELY(header.count > ORDER_BATCH_CAPACITY)) {
+      LOG_ERROR("Raw batch is too big {}", header.count);
+      return std::unexpected(StatusCode::Error);
+    }
+    const size_t total = sizeof(RawBatchHeader) + header.count * sizeof(EntryT);
+    return size < total ? 0 : total;
+  }
+
+  template <typename Consumer>
+  static auto decodeUnknown(const uint8_t *buffer, size_t, Consumer &) -> Expected<size_t> {
+    LOG_ERROR("Unknown raw message type {}", buffer[0]);
+    return std::unexpected(StatusCode::Error);
+  }
+
+  static LoginRequest convert(CRef<RawLoginRequest> m) {
+    return LoginRequest{getString(m.name), getString(m.password)};
+  }
+
+  static TokenBindRequest convert(CRef<RawTokenBindRequest> m) {
+    return TokenBindRequest{m.token};
+  }
+
+  static LoginResponse convert(CRef<RawLoginResponse> m) {
+    return LoginResponse{m.token, m.ok != 0, getString(m.error)};
+  }
+
+  static Order convert(CRef<RawOrder> m) {
+    return Order{m.id, m.ticker, m.quantity, m.price, m.action, m.orderType};
+  }
+
+  static OrderStatus convert(CRef<RawOrderStatus> m) {
+    return OrderStatus{m.orderId, m.systemOrderId, m.quantity, m.fillPrice, m.state};
+  }
+
+  static TickerPrice convert(CRef<RawTickerPrice> m) { return TickerPrice{m.ticker, m.price}; }
+
+  static Order convert(CRef<RawOrderEntry> m) {
+    return Order{m.id, m.ticker, m.quantity, m.price, m.action, m.orderType};
+  }
+
+  static OrderStatus convert(CRef<RawOrderStatusEntry> m) {
+    return OrderStatus{m.orderId, m.systemOrderId, m.quantity, m.fillPrice, m.state};
+  }
+
+  template <typename RawT>
+  static size_t write(CRef<RawT> msg, uint8_t *buffer) {
+    std::memcpy(buffer, &msg, sizeof(RawT));
+    return sizeof(RawT);
+  }
+
+  static void putString(char (&dst)[RAW_STRING_SIZE], CRef<String> src) {
+    std::memcpy(dst, src.data(), std::min(src.size(), RAW_STRING_SIZE));
+  }
+
+  static String getString(const char (&src)[RAW_STRING_SIZE]) {
+    return String(src, ::strnlen(src, RAW_STRING_SIZE));
+  }
+};
+
+} // namespace hft::serialization::raw
+
+#endif // HFT_COMMON_SERIALIZATION_RAWSERIALIZER_HPP
@@ -12,6 +12,7 @@
 
 #include "sbe/cpp/hft_serialization_gen_sbe_domain/OrderAction.h"
 #include "sbe/cpp/hft_serialization_gen_sbe_domain/OrderState.h"
+#include "sbe/cpp/hft_serialization_gen_sbe_domain/OrderType.h"
 
 namespace hft::serialization::sbe {
 
@@ -21,6 +22,10 @@ OrderAction convert(gen::sbe::domain::OrderAction::Value action) {
     return OrderAction::Buy;
   case gen::sbe::domain::OrderAction::Value::SELL:
     return OrderAction::Sell;
+  case gen::sbe::domain::OrderAction::Value::MODIFY:
+    return OrderAction::Modify;
+  case gen::sbe::domain::OrderAction::Value::CANCEL:
+    return OrderAction::Cancel;
   case gen::sbe::domain::OrderAction::Value::DUMMY:
     return OrderAction::Dummy;
   default:
@@ -34,6 +39,10 @@ gen::sbe::domain::OrderAction::Value convert(OrderAction action) {
     return gen::sbe::domain::OrderAction::Value::BUY;
   case OrderAction::Sell:
     return gen::sbe::domain::OrderAction::Value::SELL;
+  case OrderAction::Modify:
+    return gen::sbe::domain::OrderAction::Value::MODIFY;
+  case OrderAction::Cancel:
+    return gen::sbe::domain::OrderAction::Value::CANCEL;
   case OrderAction::Dummy:
     return gen::sbe::domain::OrderAction::Value::DUMMY;
   default:
@@ -41,6 +50,40 @@ gen::sbe::domain::OrderAction::Value convert(OrderAction action) {
   }
 }
 
+OrderType convert(gen::sbe::domain::OrderType::Value type) {
+  switch (type) {
+  case gen::sbe::domain::OrderType::Value::LIMIT:
+    return OrderType::Limit;
+  case gen::sbe::domain::OrderType::Value::MARKET:
+    return OrderType::Market;
+  case gen::sbe::domain::OrderType::Value::IOC:
+    return OrderType::Ioc;
+  case gen::sbe::domain::OrderType::Value::FOK:
+    return OrderType::Fok;
+  case gen::sbe::domain::OrderType::Value::POST_ONLY:
+    return OrderType::PostOnly;
+  default:
+    throw std::runtime_error("Unknown gen::sbe::domain::OrderType::Value type");
+  }
+}
+
+gen::sbe::domain::OrderType::Value convert(OrderType type) {
+  switch (type) {
+  case OrderType::Limit:
+    return gen::sbe::domain::OrderType::Value::LIMIT;
+  case OrderType::Market:
+    return gen::sbe::domain::OrderType::Value::MARKET;
+  case OrderType::Ioc:
+    return gen::sbe::domain::OrderType::Value::IOC;
+  case OrderType::Fok:
+    return gen::sbe::domain::OrderType::Value::FOK;
+  case OrderType::PostOnly:
+    return gen::sbe::domain::OrderType::Value::POST_ONLY;
+  default:
+    throw std::runtime_error("OrderType type");
+  }
+}
+
 OrderState convert(gen::sbe::domain::OrderState::Value action) {
   switch (action) {
   case gen::sbe::domain::OrderState::Value::Accepted:
@@ -8,14 +8,17 @@
 
 #include "sbe/cpp/hft_serialization_gen_sbe_domain/Char32.h"
 #include "sbe/cpp/hft_serialization_gen_sbe_domain/Char4.h"
+#include "sbe/cpp/hft_serialization_gen_sbe_domain/GroupSizeEncoding.h"
 #include "sbe/cpp/hft_serialization_gen_sbe_domain/LoginRequest.h"
 #include "sbe/cpp/hft_serialization_gen_sbe_domain/LoginResponse.h"
 #include "sbe/cpp/hft_serialization_gen_sbe_domain/Message.h"
 #include "sbe/cpp/hft_serialization_gen_sbe_domain/MessageHeader.h"
 #include "sbe/cpp/hft_serialization_gen_sbe_domain/Order.h"
 #include "sbe/cpp/hft_serialization_gen_sbe_domain/OrderAction.h"
+#include "sbe/cpp/hft_serialization_gen_sbe_domain/OrderBatch.h"
 #include "sbe/cpp/hft_serialization_gen_sbe_domain/OrderState.h"
 #include "sbe/cpp/hft_serialization_gen_sbe_domain/OrderStatus.h"
+#include "sbe/cpp/hft_serialization_gen_sbe_domain/OrderStatusBatch.h"
 #include "sbe/cpp/hft_serialization_gen_sbe_domain/TickerPrice.h"
 #include "sbe/cpp/hft_serialization_gen_sbe_domain/TokenBindRequest.h"
 
@@ -30,10 +33,16 @@
 
 namespace hft::serialization::sbe {
 
+/**
+ * @brief Simple binary encoding serializer
+ * @details Incomplete message yields 0 bytes consumed, so the rest is read on the next pass.
+ * Batches are repeating groups. Order batch is posted whole, so the gateway sees
+ * where the burst ends, status batch is unpacked into consecutive OrderStatus posts
+ */
 class SbeDomainSerializer {
 public:
-  using SupportedTypes =
-      std::tuple<LoginRequest, TokenBindRequest, LoginResponse, Order, OrderStatus, TickerPrice>;
+  using SupportedTypes = std::tuple<LoginRequest, TokenBindRequest, LoginResponse, Order,
+                                    OrderStatus, TickerPrice, OrderBatch, OrderStatusBatch>;
 
   template <typename EventType>
   static constexpr bool Serializable = utils::IsTypeInTuple<EventType, SupportedTypes>;
@@ -44,8 +53,7 @@ public:
     char *data = reinterpret_cast<char *>(const_cast<uint8_t *>(buffer));
 
     if (size < domain::MessageHeader::encodedLength()) {
-      LOG_ERROR("Not enough data");
-      return std::unexpected(StatusCode::Error);
+      return 0;
     }
 
     domain::MessageHeader header(data, size);
@@ -56,8 +64,7 @@ public:
     switch (header.templateId()) {
     case domain::LoginRequest::sbeTemplateId(): {
       if (size < domain::LoginRequest::sbeBlockAndHeaderLength()) {
-        LOG_ERROR("Not enough LoginRequest data");
-        return std::unexpected(StatusCode::Error);
+        return 0;
       }
       domain::LoginRequest msg(data + headerSize, messageSize);
       consumer.post(
@@ -66,8 +73,7 @@ public:
     }
     case domain::TokenBindRequest::sbeTemplateId(): {
       if (size < domain::TokenBindRequest::sbeBlockAndHeaderLength()) {
-        LOG_ERROR("Not enough TokenBindRequest data");
-        return std::unexpected(StatusCode::Error);
+        return 0;
       }
       domain::TokenBindRequest msg(data + headerSize, messageSize);
       consumer.post(TokenBindRequest{msg.token()});
@@ -75,8 +81,7 @@ public:
     }
     case domain::LoginResponse::sbeTemplateId(): {
       if (size < domain::LoginResponse::sbeBlockAndHeaderLength()) {
-        LOG_ERROR("Not enough LoginResponse data");
-        return std::unexpected(StatusCode::Error);
+        return 0;
       }
       domain::LoginResponse msg(data + headerSize, messageSize);
       consumer.post(LoginResponse{msg.token(), msg.ok() == 1, msg.error_msg().getChar32AsString()});
@@ -84,18 +89,16 @@ public:
     }
     case domain::Order::sbeTemplateId(): {
       if (size < domain::Order::sbeBlockAndHeaderLength()) {
-        LOG_ERROR("Not enough Order data");
-        return std::unexpected(StatusCode::Error);
+        return 0;
       }
       domain::Order msg(data + headerSize, messageSize);
       consumer.post(Order{msg.id(), makeTicker(msg.ticker().getChar4AsString()), msg.quantity(),
-                          msg.price(), convert(msg.action())});
+                          msg.price(), convert(msg.action()), convert(msg.type())});
       return domain::Order::sbeBlockAndHeaderLength();
     }
     case domain::OrderStatus::sbeTemplateId(): {
       if (size < domain::OrderStatus::sbeBlockAndHeaderLength()) {
-        LOG_ERROR("Not enough OrderStatus data");
-        return std::unexpected(StatusCode::Error);
+        return 0;
       }
       domain::OrderStatus msg(data + headerSize, messageSize);
       consumer.post(OrderStatus{msg.order_id(), msg.system_order_id(), msg.quantity(),
@@ -104,13 +107,58 @@ public:
     }
     case domain::TickerPrice::sbeTemplateId(): {
       if (size < domain::TickerPrice::sbeBlockAndHeaderLength()) {
-        LOG_ERROR("Not enough TickerPrice data");
-        return std::unexpected(StatusCode::Error);
+        return 0;
       }
       domain::TickerPrice msg(data + headerSize, messageSize);
       consumer.post(TickerPrice{makeTicker(msg.ticker().getChar4AsString()), msg.price()});
       return domain::TickerPrice::sbeBlockAndHeaderLength();
     }
+    case domain::OrderBatch::sbeTemplateId(): {
+      using Group = domain::OrderBatch::Orders;
+      if (size < domain::OrderBatch::sbeBlockAndHeaderLength() + Group::sbeHeaderSize()) {
+        return 0;
+      }
+      domain::OrderBatch msg(data + headerSize, messageSize);
+      auto &group = msg.orders();
+      if (UNLIKELY(group.count() > ORDER_BATCH_CAPACITY)) {
+        LOG_ERROR("OrderBatch is too big {}", group.count());
+        return std::unexpected(StatusCode::Error);
+      }
+      const size_t batchSize = headerSize + msg.encodedLength() +
+                               static_cast<size_t>(group.count()) * Group::sbeBlockLength();
+      if (size < batchSize) {
+        return 0;
+      }
+      OrderBatch batch;
+      while (group.hasNext()) {
+        group.next();
+        const Order order{group.id(), makeTicker(group.ticker().getChar4AsString()),
+                          group.quantity(), group.price(), convert(group.action()),
+                          convert(group.type())};
+        batch.orders[batch.count++] = order;
+      }
+      consumer.post(batch);
+      return batchSize;
+    }
+    case domain::OrderStatusBatch::sbeTemplateId(): {
+      using Group = domain::OrderStatusBatch::Statuses;
+      if (size < domain::OrderStatusBatch::sbeBlockAndHeaderLength() + Group::sbeHeaderSize()) {
+        return 0;
+      }
+      domain::OrderStatusBatch msg(data + headerSize, messageSize);
+      auto &group = msg.statuses();
+      const size_t batchSize = headerSize + msg.encodedLength() +
+                               static_cast<size_t>(group.count()) * Group::sbeBlockLength();
+      if (size < batchSize) {
+        return 0;
+      }
+      while (group.hasNext()) {
+        group.next();
+        consumer.post(OrderStatus{group.order_id(), group.system_order_id(), group.quantity(),
+                                  group.fill_price(), convert(group.state())});
+      }
+      return batchSize;
+    }
     default:
       LOG_ERROR("Unknown sbe message type {}", header.templateId());
       return std::unexpected(StatusCode::Error);
@@ -155,7 +203,7 @@ public:
     domain::Order msg;
     msg.wrapAndApplyHeader(reinterpret_cast<char *>(buffer), 0, msgSize);
     msg.id(r.id).ticker().putChar4(r.ticker.data());
-    msg.quantity(r.quantity).price(r.price).action(convert(r.action));
+    msg.quantity(r.quantity).price(r.price).action(convert(r.action)).type(convert(r.type));
     return msgSize;
   }
 
@@ -180,6 +228,38 @@ public:
     msg.price(r.price);
     return msgSize;
   }
+
+  static size_t serialize(CRef<OrderBatch> r, uint8_t *buffer) {
+    using namespace hft::serialization::gen::sbe;
+    using Group = domain::OrderBatch::Orders;
+    const size_t msgSize = domain::OrderBatch::sbeBlockAndHeaderLength() + Group::sbeHeaderSize() +
+                           r.count * Group::sbeBlockLength();
+
+    domain::OrderBatch msg;
+    msg.wrapAndApplyHeader(reinterpret_cast<char *>(buffer), 0, msgSize);
+    auto &group = msg.ordersCount(r.count);
+    for (const auto &o : r.view()) {
+      group.next().id(o.id).ticker().putChar4(o.ticker.data());
+      group.quantity(o.quantity).price(o.price).action(convert(o.action)).type(convert(o.type));
+    }
+    return msgSize;
+  }
+
+  static size_t serialize(CRef<OrderStatusBatch> r, uint8_t *buffer) {
+    using namespace hft::serialization::gen::sbe;
+    using Group = domain::OrderStatusBatch::Statuses;
+    const size_t msgSize = domain::OrderStatusBatch::sbeBlockAndHeaderLength() +
+                           Group::sbeHeaderSize() + r.count * Group::sbeBlockLength();
+
+    domain::OrderStatusBatch msg;
+    msg.wrapAndApplyHeader(reinterpret_cast<char *>(buffer), 0, msgSize);
+    auto &group = msg.statusesCount(r.count);
+    for (const auto &s : r.view()) {
+      group.next().order_id(s.orderId).system_order_id(s.systemOrderId).quantity(s.quantity);
+      group.fill_price(s.fillPrice).state(convert(s.state));
+    }
+    return msgSize;
+  }
 };
 
 } // namespace hft::serialization::sbe
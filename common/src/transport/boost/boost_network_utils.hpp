@@ -13,7 +13,7 @@
 #include "logging.hpp"
 
 namespace hft {
-IoStatus toIoStatus(BoostErrorCode ec) noexcept {
+inline IoStatus toIoStatus(BoostErrorCode ec) noexcept {
   if (!ec) {
     return IoStatus::Ok;
   }
@@ -9,6 +9,7 @@
 #include <boost/asio/buffer.hpp>
 #include <boost/asio/ip/udp.hpp>
 
+#include "boost_network_utils.hpp"
 #include "container_types.hpp"
 #include "io_result.hpp"
 #include "logging.hpp"
@@ -44,9 +45,20 @@ public:
     socket_.async_send(buffer(buf.data(), buf.size()), std::move(handler));
   }
 
-  IoResult syncRx(ByteSpan buf) { return IoResult{}; }
+  IoResult syncRx(ByteSpan buf) {
+    BoostErrorCode ec;
+    const size_t bytes = socket_.receive(boost::asio::buffer(buf.data(), buf.size()), 0, ec);
+    return {(uint32_t)bytes, toIoStatus(ec)};
+  }
 
-  IoResult syncTx(CByteSpan buf) { return IoResult{}; }
+  /**
+   * @brief Single send of the whole datagram
+   */
+  IoResult syncTx(CByteSpan buf) {
+    BoostErrorCode ec;
+    const size_t bytes = socket_.send(boost::asio::buffer(buf.data(), buf.size()), 0, ec);
+    return {(uint32_t)bytes, toIoStatus(ec)};
+  }
 
   void close() {
     BoostErrorCode ec;
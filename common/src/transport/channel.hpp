@@ -6,9 +6,13 @@
 #ifndef HFT_COMMON_CHANNEL_HPP
 #define HFT_COMMON_CHANNEL_HPP
 
+#include <type_traits>
+#include <utility>
+
 #include "bus/busable.hpp"
+#include "container_types.hpp"
 #include "containers/buffer_pool.hpp"
-#include "containers/sliding_buffer.hpp"
+#include "containers/mirrored_buffer.hpp"
 #include "domain_types.hpp"
 #include "logging.hpp"
 #include "network_traits.hpp"
@@ -16,18 +20,33 @@
 #include "transport/connection_status.hpp"
 #include "transport/transportable.hpp"
 #include "utils/string_utils.hpp"
+#include "utils/sync_utils.hpp"
 
 namespace hft {
 
 /**
  * @brief performs framing, serializing, and routing messages network <-> system
+ * @details Single write is sent as is, messages framed while a write is in flight are
+ * appended to the pending buffer and sent together with one write once it completes
  */
 template <Transportable TransportT, Busable BusT>
 class Channel : public std::enable_shared_from_this<Channel<TransportT, BusT>> {
+  static constexpr size_t WRITE_BATCH_SIZE = 16 * 1024;
+  static constexpr size_t MAX_PENDING_SIZE = 1024 * 1024;
+
+  /**
+   * @brief Batches do not fit the default buffer, they are framed into a bigger size class
+   */
+  template <typename Type>
+  using WritePool = std::conditional_t<(sizeof(Type) > BufferPool<>::BUFFER_CAPACITY),
+                                       BufferPool<4096, 64>, BufferPool<>>;
+
 public:
   Channel(TransportT &&transport, ConnectionId id, BusT &&bus)
       : transport_{std::move(transport)}, id_{id}, bus_{std::move(bus)} {
     LOG_DEBUG("Channel ctor");
+    pending_.reserve(WRITE_BATCH_SIZE);
+    flushing_.reserve(WRITE_BATCH_SIZE);
   }
 
   ~Channel() {
@@ -58,19 +77,39 @@ public:
       return;
     }
 
-    BufferPtr netBuff{BufferPool<>::instance().acquire()};
+    using Pool = WritePool<Type>;
+    BufferPtr netBuff{Pool::instance().acquire()};
     if (!netBuff) {
       LOG_ERROR_SYSTEM("Failed to acquire network buffer, message dropped");
       return;
     }
     const auto size = Framer::frame(msg, netBuff.data);
-    assert(size < BufferPool<>::BUFFER_CAPACITY);
+    if (UNLIKELY(size == 0)) {
+      LOG_ERROR_SYSTEM("Channel {} failed to serialize message, message dropped", id_);
+      Pool::instance().release(netBuff.index);
+      return;
+    }
+    assert(size < Pool::BUFFER_CAPACITY);
+
+    writeLock_.lock();
+    if (writing_) {
+      if (LIKELY(pending_.size() + size <= MAX_PENDING_SIZE)) {
+        pending_.insert(pending_.end(), netBuff.data, netBuff.data + size);
+      } else {
+        LOG_ERROR_SYSTEM("Channel {} write backlog is full, message dropped", id_);
+      }
+      writeLock_.unlock();
+      Pool::instance().release(netBuff.index);
+      return;
+    }
+    writing_ = true;
+    writeLock_.unlock();
 
     const auto dataSpan = ByteSpan{netBuff.data, size};
     LOG_TRACE("sending {} bytes", size);
     transport_.asyncTx( // format
         dataSpan, [self = this->weak_from_this(), idx = netBuff.index](IoResult res) {
-          BufferPool<>::instance().release(idx);
+          Pool::instance().release(idx);
           auto sharedSelf = self.lock();
           if (!sharedSelf) {
             LOG_ERROR("Channel vanished");
@@ -120,9 +159,41 @@ private:
   }
 
   void writeHandler(IoResult res) {
-    if (res.code != IoStatus::Ok && res.code != IoStatus::Closed) {
-      onStatus(ConnectionStatus::Error);
+    if (res.code != IoStatus::Ok) {
+      if (res.code != IoStatus::Closed) {
+        onStatus(ConnectionStatus::Error);
+      }
+      return; // writing_ stays set, nothing goes out after a failed write
+    }
+    flush();
+  }
+
+  /**
+   * @brief Sends everything framed while the previous write was in flight
+   */
+  void flush() {
+    writeLock_.lock();
+    if (pending_.empty() || status_ != ConnectionStatus::Connected) {
+      pending_.clear();
+      writing_ = false;
+      writeLock_.unlock();
+      return;
     }
+    std::swap(pending_, flushing_);
+    pending_.clear();
+    writeLock_.unlock();
+
+    LOG_TRACE("sending {} bytes batch", flushing_.size());
+    transport_.asyncTx( // format
+        CByteSpan{flushing_.data(), flushing_.size()},
+        [self = this->weak_from_this()](IoResult res) {
+          auto sharedSelf = self.lock();
+          if (!sharedSelf) {
+            LOG_ERROR("Channel vanished");
+            return;
+          }
+          sharedSelf->writeHandler(res);
+        });
   }
 
   void onStatus(ConnectionStatus status) {
@@ -135,7 +206,13 @@ private:
 
   BusT bus_;
   TransportT transport_;
-  SlidingBuffer buffer_;
+  MirroredBuffer buffer_;
+
+  // guards pending_ and writing_, writers come from system threads, flushes from network one
+  utils::SpinLock writeLock_;
+  bool writing_{false};
+  ByteBuffer pending_;
+  ByteBuffer flushing_;
 
   Atomic<ConnectionStatus> status_{ConnectionStatus::Connected};
 };
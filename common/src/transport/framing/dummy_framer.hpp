@@ -39,6 +39,9 @@ public:
       if (!msgSize) {
         return msgSize;
       }
+      if (*msgSize == 0) {
+        break; // incomplete message, rest comes with the next read
+      }
       processedSize += *msgSize;
     }
     return processedSize;
@@ -27,10 +27,15 @@ public:
   static constexpr bool Framable = Serializer::template Serializable<EventType>;
 
   static constexpr size_t HEADER_SIZE = sizeof(MessageSize);
+  // fits a full order batch
+  static constexpr size_t MAX_BODY_SIZE = 4096;
 
   template <typename Type>
   static size_t frame(CRef<Type> message, uint8_t *buffer) {
     const auto msgSize = Serializer::serialize(message, buffer + HEADER_SIZE);
+    if (UNLIKELY(msgSize == 0)) {
+      return 0;
+    }
 
     const utils::LittleEndianUInt16 bodySize = static_cast<MessageSize>(msgSize);
     std::memcpy(buffer, &bodySize, sizeof(bodySize));
@@ -49,7 +54,7 @@ public:
       const MessageSize bodySize = lilBodySize.value();
       LOG_DEBUG("Trying to parse {} bytes", bodySize);
       // Check if there is enough data to deserialize message
-      if (bodySize == 0 || bodySize > 1024) {
+      if (bodySize == 0 || bodySize > MAX_BODY_SIZE) {
         LOG_ERROR("Invalid body size {}", bodySize);
         return std::unexpected(StatusCode::Error);
       }
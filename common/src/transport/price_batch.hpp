@@ -0,0 +1,118 @@
+/**
+ * @author Vladimir Pavliv
+ * @date 2026-02-16
+ */
+
+#ifndef HFT_COMMON_PRICEBATCH_HPP
+#define HFT_COMMON_PRICEBATCH_HPP
+
+#include <type_traits>
+
+#include "container_types.hpp"
+#include "domain_types.hpp"
+#include "logging.hpp"
+#include "primitive_types.hpp"
+#include "ptr_types.hpp"
+
+namespace hft {
+
+enum class FeedKind : uint32_t { Prices, Levels };
+
+struct FeedHeader {
+  uint64_t seq;
+  uint32_t count;
+  FeedKind kind;
+};
+
+/**
+ * @brief Datagram of market feed updates, sent as is, header followed by count items
+ * sized to fit into a single ethernet frame, so it is never fragmented
+ * sequence is shared by all the batches of a publisher and grows by one with every datagram,
+ * receiver spots lost ones by it, kind tells what the items are
+ */
+template <typename ItemT, FeedKind Kind>
+struct FeedBatch {
+  static constexpr size_t MAX_DATAGRAM_SIZE = 1472; // 1500 MTU - 20 IP - 8 UDP
+
+  using Header = FeedHeader;
+
+  static constexpr size_t CAPACITY = (MAX_DATAGRAM_SIZE - sizeof(Header)) / sizeof(ItemT);
+
+  Header header{0, 0, Kind};
+  ItemT items[CAPACITY];
+
+  inline bool full() const noexcept { return header.count == CAPACITY; }
+  inline bool empty() const noexcept { return header.count == 0; }
+
+  inline void add(CRef<ItemT> item) noexcept { items[header.count++] = item; }
+
+  inline size_t size() const noexcept { return sizeof(Header) + header.count * sizeof(ItemT); }
+
+  inline CByteSpan bytes() const noexcept {
+    return CByteSpan{reinterpret_cast<const uint8_t *>(this), size()};
+  }
+
+  /**
+   * @brief Checks the received datagram is a whole batch of this kind
+   */
+  inline bool valid(size_t bytes) const noexcept {
+    return bytes >= sizeof(Header) && header.kind == Kind && header.count <= CAPACITY &&
+           bytes == size();
+  }
+};
+
+using PriceBatch = FeedBatch<TickerPrice, FeedKind::Prices>;
+using LevelBatch = FeedBatch<LevelUpdate, FeedKind::Levels>;
+
+static_assert(std::is_trivially_copyable_v<PriceBatch>);
+static_assert(std::is_trivially_copyable_v<LevelBatch>);
+static_assert(sizeof(PriceBatch) <= PriceBatch::MAX_DATAGRAM_SIZE);
+static_assert(sizeof(LevelBatch) <= LevelBatch::MAX_DATAGRAM_SIZE);
+
+/**
+ * @brief Receive buffer for any feed datagram, kind is read from the common header
+ */
+union FeedDatagram {
+  FeedDatagram() : prices{} {}
+
+  PriceBatch prices;
+  LevelBatch levels;
+
+  inline FeedKind kind() const noexcept { return prices.header.kind; }
+};
+
+/**
+ * @brief Tracks feed batch sequence on the receiving side
+ * first batch sets the sequence, lost batches are counted, late ones are dropped,
+ * sequence 0 is a restarted publisher
+ */
+class PriceSequencer {
+public:
+  /**
+   * @return false if the batch is older than the last accepted one
+   */
+  inline bool accept(uint64_t seq) noexcept {
+    if (UNLIKELY(!synced_ || seq == 0)) {
+      synced_ = true;
+    } else if (seq < next_) {
+      LOG_WARN("Stale price batch #{}, expected #{}", seq, next_);
+      return false;
+    } else if (seq > next_) {
+      LOG_WARN("Price batches #{}-#{} lost", next_, seq - 1);
+      lost_ += seq - next_;
+    }
+    next_ = seq + 1;
+    return true;
+  }
+
+  inline uint64_t lost() const noexcept { return lost_; }
+
+private:
+  uint64_t next_{0};
+  uint64_t lost_{0};
+  bool synced_{false};
+};
+
+} // namespace hft
+
+#endif // HFT_COMMON_PRICEBATCH_HPP
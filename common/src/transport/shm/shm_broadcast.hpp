@@ -0,0 +1,75 @@
+/**
+ * @author Vladimir Pavliv
+ * @date 2026-02-14
+ */
+
+#ifndef HFT_COMMON_SHMBROADCAST_HPP
+#define HFT_COMMON_SHMBROADCAST_HPP
+
+#include <climits>
+
+#include "containers/broadcast_ring.hpp"
+#include "logging.hpp"
+#include "primitive_types.hpp"
+#include "ptr_types.hpp"
+#include "utils/memory_utils.hpp"
+#include "utils/sync_utils.hpp"
+
+namespace hft {
+
+/**
+ * @brief broadcast ring + control block for a one-to-many message stream via shm
+ * readers sleep on a shared futex, writer wakes all of them, but only if someone sleeps
+ */
+struct alignas(utils::HUGE_PAGE_SIZE) ShmBroadcast {
+  using Ring = BroadcastRing<128 * 1024>;
+
+  // 8mb + control block, place at the start so data fills up 4 full huge pages
+  ALIGN_CL Ring ring;
+
+  ALIGN_CL AtomicUInt32 futex{0};    // futex
+  ALIGN_CL AtomicUInt32 waiters{0};  // sleeping readers, futex is hit only when there are any
+  ALIGN_CL AtomicUInt32 refCount{0}; // counter for shm cleanup
+
+  void notify() {
+    // pairs with the increment in prepareWait, either the reader sees the data or we see it
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiters.load(std::memory_order_relaxed) != 0) {
+      LOG_DEBUG("ShmBroadcast notify");
+      futex.fetch_add(1, std::memory_order_release);
+      utils::futexWake(futex, INT_MAX);
+    }
+  }
+
+  /**
+   * @brief Registers a sleeping reader, ring has to be checked afterwards before going to sleep
+   * @return futex value to sleep on
+   */
+  uint32_t prepareWait() {
+    const auto ftxVal = futex.load(std::memory_order_acquire);
+    waiters.fetch_add(1, std::memory_order_seq_cst);
+    return ftxVal;
+  }
+
+  void cancelWait() { waiters.fetch_sub(1, std::memory_order_release); }
+
+  void increment() { refCount.fetch_add(1, std::memory_order_release); }
+
+  bool decrement() noexcept {
+    uint32_t old = refCount.load(std::memory_order_acquire);
+    while (old > 0) {
+      if (refCount.compare_exchange_weak( // format
+              old, old - 1, std::memory_order_acq_rel, std::memory_order_acquire)) {
+        return old == 1;
+      }
+    }
+    LOG_ERROR("Attempted to decrement refCount already at 0");
+    return false;
+  }
+
+  size_t count() const { return refCount.load(std::memory_order_acquire); }
+};
+
+} // namespace hft
+
+#endif // HFT_COMMON_SHMBROADCAST_HPP
@@ -0,0 +1,58 @@
+/**
+ * @author Vladimir Pavliv
+ * @date 2026-02-14
+ */
+
+#ifndef HFT_COMMON_SHMPUBLISHER_HPP
+#define HFT_COMMON_SHMPUBLISHER_HPP
+
+#include "container_types.hpp"
+#include "functional_types.hpp"
+#include "io_result.hpp"
+#include "logging.hpp"
+#include "primitive_types.hpp"
+#include "shm_broadcast.hpp"
+#include "shm_ptr.hpp"
+#include "utils/handler.hpp"
+
+namespace hft {
+
+/**
+ * @brief Writing side of ShmBroadcast, never waits for readers
+ */
+class ShmPublisher {
+public:
+  explicit ShmPublisher(CRef<String> name) : closed_{false}, shm_{name} {}
+  ShmPublisher(ShmPublisher &&other) noexcept
+      : closed_{other.closed_.load(std::memory_order_acquire)}, shm_{std::move(other.shm_)} {
+    other.closed_.store(true, std::memory_order_release);
+  }
+  ~ShmPublisher() = default;
+
+  ShmPublisher(const ShmPublisher &) = delete;
+
+  auto syncTx(CByteSpan buffer) -> IoResult {
+    if (closed_.load(std::memory_order_acquire)) {
+      LOG_WARN_SYSTEM("ShmPublisher is already closed");
+      return IoResult{0, IoStatus::Error};
+    }
+    if (!shm_->ring.write(buffer.data(), buffer.size())) {
+      LOG_ERROR("Failed to publish {} bytes", buffer.size());
+      return {0, IoStatus::Error};
+    }
+    shm_->notify();
+    return {(uint32_t)buffer.size(), IoStatus::Ok};
+  }
+
+  void asyncTx(CByteSpan buffer, CRefHandler<IoResult> &&clb) { clb(syncTx(buffer)); }
+
+  void close() { closed_.store(true, std::memory_order_release); }
+
+private:
+  AtomicBool closed_;
+  ShmUPtr<ShmBroadcast> shm_;
+};
+
+} // namespace hft
+
+#endif // HFT_COMMON_SHMPUBLISHER_HPP
@@ -6,6 +6,7 @@
 #ifndef HFT_COMMON_SHMQUEUE_HPP
 #define HFT_COMMON_SHMQUEUE_HPP
 
+#include "containers/packed_spsc.hpp"
 #include "containers/sequenced_spsc.hpp"
 #include "logging.hpp"
 #include "primitive_types.hpp"
@@ -17,10 +18,18 @@ namespace hft {
 
 /**
  * @brief lock-free queue + control block for a one-side message stream via shm
+ * SHM_PACKED_QUEUE packs messages as length-prefixed records instead of a 64 byte slot each,
+ * both sides of the stream have to be built with the same layout
  */
 struct alignas(utils::HUGE_PAGE_SIZE) ShmQueue {
+#ifdef SHM_PACKED_QUEUE
+  using Queue = PackedSPSC<8 * 1024 * 1024>;
+#else
+  using Queue = SequencedSPSC<128 * 1024>;
+#endif
+
   // 8mb + control block, place at the start so data fills up 4 full huge pages
-  ALIGN_CL SequencedSPSC<128 * 1024> queue;
+  ALIGN_CL Queue queue;
 
   ALIGN_CL AtomicUInt32 futex{0};      // futex
   ALIGN_CL uint32_t futexCounter{0};   // optimization to avoid fetch_add
@@ -28,18 +37,34 @@ struct alignas(utils::HUGE_PAGE_SIZE) ShmQueue {
   ALIGN_CL AtomicUInt32 refCount{0};   // counter for shm cleanup
 
   void notify() {
-    if (waitFlag.load(std::memory_order_acquire)) {
+    // pairs with the fence in prepareWait, either the reader sees the data or we see the flag
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waitFlag.load(std::memory_order_relaxed)) {
       LOG_DEBUG("ShmQueue notify");
       futex.store(++futexCounter, std::memory_order_release);
       utils::futexWake(futex);
     }
   }
 
-  void wait() {
+  /**
+   * @brief Raises waitFlag, queue has to be checked for data afterwards before going to sleep
+   * @return futex value to sleep on
+   */
+  uint32_t prepareWait() {
     const auto ftxVal = futex.load(std::memory_order_acquire);
-    waitFlag.store(true, std::memory_order_release);
-    utils::futexWait(futex, ftxVal);
-    waitFlag.store(false, std::memory_order_release);
+    waitFlag.store(true, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    return ftxVal;
+  }
+
+  void cancelWait() { waitFlag.store(false, std::memory_order_release); }
+
+  void wait(uint64_t timeoutNs = 0) {
+    const auto ftxVal = prepareWait();
+    if (queue.empty()) {
+      utils::futexWait(futex, ftxVal, timeoutNs);
+    }
+    cancelWait();
   }
 
   void increment() { refCount.fetch_add(1, std::memory_order_release); }
@@ -3,10 +3,13 @@
  * @date 2026-01-15
  */
 
+#include <algorithm>
+
 #include "shm_reactor.hpp"
 #include "config/config.hpp"
 #include "logging.hpp"
 #include "shm_reader.hpp"
+#include "shm_subscriber.hpp"
 #include "utils/thread_utils.hpp"
 
 namespace hft {
@@ -27,8 +30,27 @@ void ShmReactor::add(ShmReader *reader) {
     LOG_ERROR("ShmReactor is already running");
     return;
   }
+  if (readers_.size() + subscribers_.size() == FUTEX_WAITV_MAX) {
+    LOG_ERROR("Too many ShmReaders");
+    return;
+  }
   LOG_DEBUG("Register ShmReader");
   readers_.push_back(reader);
+  waitv_.resize(readers_.size() + subscribers_.size());
+}
+
+void ShmReactor::add(ShmSubscriber *subscriber) {
+  if (started_.load(std::memory_order_acquire)) {
+    LOG_ERROR("ShmReactor is already running");
+    return;
+  }
+  if (readers_.size() + subscribers_.size() == FUTEX_WAITV_MAX) {
+    LOG_ERROR("Too many ShmReaders");
+    return;
+  }
+  LOG_DEBUG("Register ShmSubscriber");
+  subscribers_.push_back(subscriber);
+  waitv_.resize(readers_.size() + subscribers_.size());
 }
 
 void ShmReactor::run(StdCallback onReadyClb) {
@@ -67,7 +89,11 @@ void ShmReactor::stop() {
   for (auto *rdr : readers_) {
     rdr->notify();
   }
+  for (auto *sub : subscribers_) {
+    sub->notify();
+  }
   readers_.clear();
+  subscribers_.clear();
   instance.store(nullptr, std::memory_order_release);
   LOG_DEBUG("Joining ShmReactor thread");
   utils::join(thread_);
@@ -75,42 +101,83 @@ void ShmReactor::stop() {
 }
 
 void ShmReactor::loop() {
-  LOG_DEBUG_SYSTEM("ShmReactor::loop start {} readers", readers_.size());
-  if (readers_.empty()) {
+  LOG_DEBUG_SYSTEM("ShmReactor::loop start {} readers {} subscribers", readers_.size(),
+                   subscribers_.size());
+  if (readers_.empty() && subscribers_.empty()) {
     LOG_ERROR_SYSTEM("No ShmReaders registered.");
     return;
   }
   SpinWait waiter{SPIN_RETRIES_WARM};
   while (!stopToken_.stop_requested()) {
-    bool busy = false;
-    for (size_t i = 0; i < readers_.size(); ++i) {
-      if (stopToken_.stop_requested()) {
-        break;
-      }
-      auto res = readers_[i]->poll();
-      if (res == ShmReader::PollResult::Vanished) {
-        LOG_DEBUG_SYSTEM("Reader vanished");
-        readers_[i] = readers_.back();
-        readers_.pop_back();
-        if (readers_.empty()) {
-          LOG_DEBUG_SYSTEM("No more active readers");
-          return;
-        }
-        --i;
-        continue;
-      } else if (res == ShmReader::PollResult::Busy) {
-        busy = true;
-      }
+    const bool busy = pollAll(readers_) | pollAll(subscribers_);
+    if (readers_.empty() && subscribers_.empty()) {
+      LOG_DEBUG_SYSTEM("No more active readers");
+      return;
     }
     if (busy) {
       waiter.reset();
     } else if (!++waiter) {
-      readers_[0]->wait();
+      wait();
       waiter.reset();
     }
   }
 }
 
+template <typename ReaderT>
+bool ShmReactor::pollAll(std::vector<ReaderT *> &readers) {
+  bool busy = false;
+  for (size_t i = 0; i < readers.size(); ++i) {
+    if (stopToken_.stop_requested()) {
+      break;
+    }
+    const auto res = readers[i]->poll();
+    if (res == ShmReader::PollResult::Vanished) {
+      LOG_DEBUG_SYSTEM("Reader vanished");
+      readers[i] = readers.back();
+      readers.pop_back();
+      --i;
+    } else if (res == ShmReader::PollResult::Busy) {
+      busy = true;
+    }
+  }
+  return busy;
+}
+
+void ShmReactor::wait() {
+  const size_t count = readers_.size() + subscribers_.size();
+  if (count == 1 || !waitvSupported_) {
+    const uint64_t timeoutNs = (count == 1) ? 0 : MULTI_READER_WAIT_NS;
+    if (!readers_.empty()) {
+      readers_[0]->wait(timeoutNs);
+    } else {
+      subscribers_[0]->wait(timeoutNs);
+    }
+    return;
+  }
+  size_t idx = 0;
+  for (auto *rdr : readers_) {
+    waitv_[idx++] = rdr->prepareWait();
+  }
+  for (auto *sub : subscribers_) {
+    waitv_[idx++] = sub->prepareWait();
+  }
+  // writes that came before the flags were raised did not notify
+  const auto isPending = [](auto *rdr) { return rdr->pending(); };
+  const bool pending =
+      std::ranges::any_of(readers_, isPending) || std::ranges::any_of(subscribers_, isPending);
+  const Span<utils::futex_waitv> waitv{waitv_.data(), count};
+  if (!pending && utils::waitForAny(waitv) < 0 && errno == ENOSYS) {
+    LOG_WARN_SYSTEM("futex_waitv is not supported, falling back to a bounded wait");
+    waitvSupported_ = false;
+  }
+  for (auto *rdr : readers_) {
+    rdr->cancelWait();
+  }
+  for (auto *sub : subscribers_) {
+    sub->cancelWait();
+  }
+}
+
 bool ShmReactor::running() const { return started_.load(std::memory_order_acquire); }
 
 } // namespace hft
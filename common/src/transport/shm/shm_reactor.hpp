@@ -11,17 +11,22 @@
 
 #include "bus/system_bus.hpp"
 #include "primitive_types.hpp"
+#include "utils/sync_utils.hpp"
 
 namespace hft {
 
 class ShmReader;
+class ShmSubscriber;
 
 /**
- * @brief polls shm readers
- * currently only 1 reader is active so waiting for data is done on its futex
- * if more readers are needed utils::waitForAny could be used
+ * @brief polls shm readers and broadcast subscribers round-robin
+ * when idle, raises waitFlag of every reader, checks them once more and sleeps on all
+ * their futexes at once with futex_waitv, so a write to any of the queues wakes it up
+ * kernels without futex_waitv fall back to a bounded wait on the first reader
  */
 class ShmReactor {
+  static constexpr uint64_t MULTI_READER_WAIT_NS = 100'000;
+
 public:
   /**
    * @brief service locator
@@ -40,11 +45,16 @@ public:
   bool running() const;
   void stop();
   void add(ShmReader *reader);
+  void add(ShmSubscriber *subscriber);
 
 private:
   ShmReactor() = default;
 
   void loop();
+  void wait();
+
+  template <typename ReaderT>
+  bool pollAll(std::vector<ReaderT *> &readers);
 
 private:
   const Config &config_;
@@ -52,6 +62,9 @@ private:
   ErrorBus bus_;
 
   std::vector<ShmReader *> readers_;
+  std::vector<ShmSubscriber *> subscribers_;
+  std::vector<utils::futex_waitv> waitv_;
+  bool waitvSupported_{true};
   AtomicBool started_{false};
 
   std::jthread thread_;
@@ -47,7 +47,8 @@ ShmReader::PollResult ShmReader::poll() {
   case State::Ready:
     return PollResult::Idle;
   case State::Active: {
-    const uint32_t bytes = shm_->queue.read(buf_.data(), buf_.size());
+    // everything that is there and fits, framer splits it back into messages
+    const uint32_t bytes = shm_->queue.readBatch(buf_.data(), buf_.size());
     if (bytes != 0) {
       clb_(IoResult{bytes, IoStatus::Ok});
       return PollResult::Busy;
@@ -71,10 +72,20 @@ void ShmReader::close() {
   }
 }
 
-void ShmReader::wait() { shm_->wait(); }
+void ShmReader::wait(uint64_t timeoutNs) { shm_->wait(timeoutNs); }
 
 void ShmReader::notify() { shm_->notify(); }
 
+auto ShmReader::prepareWait() -> utils::futex_waitv {
+  return utils::makeWaitv(shm_->futex, shm_->prepareWait());
+}
+
+void ShmReader::cancelWait() { shm_->cancelWait(); }
+
+bool ShmReader::pending() const {
+  return state_.load(std::memory_order_acquire) != State::Active || !shm_->queue.empty();
+}
+
 auto ShmReader::syncRx(ByteSpan buf) -> IoResult { return {0, IoStatus::Error}; }
 
 } // namespace hft
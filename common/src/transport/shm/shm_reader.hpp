@@ -17,6 +17,7 @@
 #include "shm_queue.hpp"
 #include "utils/handler.hpp"
 #include "utils/spin_wait.hpp"
+#include "utils/sync_utils.hpp"
 #include "utils/thread_utils.hpp"
 
 namespace hft {
@@ -39,9 +40,13 @@ public:
   void asyncRx(ByteSpan buf, CRefHandler<IoResult> &&clb);
   auto syncRx(ByteSpan buf) -> IoResult;
   void close();
-  void wait();
+  void wait(uint64_t timeoutNs = 0);
   void notify();
 
+  auto prepareWait() -> utils::futex_waitv;
+  void cancelWait();
+  bool pending() const;
+
   auto poll() -> PollResult;
 
 private:
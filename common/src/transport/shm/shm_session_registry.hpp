@@ -0,0 +1,197 @@
+/**
+ * @author Vladimir Pavliv
+ * @date 2026-02-12
+ */
+
+#ifndef HFT_COMMON_SHMSESSIONREGISTRY_HPP
+#define HFT_COMMON_SHMSESSIONREGISTRY_HPP
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <format>
+#include <unistd.h>
+
+#include "domain_types.hpp"
+#include "functional_types.hpp"
+#include "logging.hpp"
+#include "primitive_types.hpp"
+#include "ptr_types.hpp"
+#include "utils/memory_utils.hpp"
+
+namespace hft {
+
+/**
+ * @brief Well-known control segment of shm sessions
+ * server opens a number of slots, each slot has its own upstream/downstream ShmQueue pair
+ * named after the base queue names and the slot index, client claims a free slot
+ * and talks over its pair, slot of a client that died without releasing it
+ * is reclaimed by the next client
+ * @details every claim bumps the slot generation, ClientId is the slot index with the generation
+ * on top, client stamps it into every order, so orders the dead client left in the queue
+ * and statuses addressed to it are told apart from the ones of the newcomer and dropped
+ */
+struct alignas(utils::HUGE_PAGE_SIZE) ShmSessionRegistry {
+  static constexpr uint32_t MAX_SESSIONS = 16;
+  static constexpr uint32_t SLOT_BITS = 8;
+  static constexpr uint32_t SLOT_MASK = (1u << SLOT_BITS) - 1;
+
+  static_assert(MAX_SESSIONS <= SLOT_MASK + 1);
+
+  enum class SlotState : uint32_t { Free, Claimed };
+
+  struct ALIGN_CL Slot {
+    std::atomic<SlotState> state{SlotState::Free};
+    AtomicUInt32 pid{0};
+    AtomicUInt32 generation{0};
+  };
+
+  ALIGN_CL AtomicUInt32 sessions{0}; // slots opened by the server
+  ALIGN_CL AtomicUInt32 refCount{0}; // counter for shm cleanup
+  Slot slots[MAX_SESSIONS];
+
+  static String queueName(CRef<String> base, uint32_t slot) {
+    return std::format("{}_{}", base, slot);
+  }
+
+  static constexpr auto clientId(uint32_t slot, uint32_t generation) -> ClientId {
+    return (generation << SLOT_BITS) | slot;
+  }
+
+  static constexpr auto slotOf(ClientId clientId) -> uint32_t { return clientId & SLOT_MASK; }
+
+  /**
+   * @brief ClientId of the current owner of the slot
+   */
+  auto owner(uint32_t idx) const -> ClientId {
+    return clientId(idx, slots[idx].generation.load(std::memory_order_acquire));
+  }
+
+  /**
+   * @brief False once the slot of the client is claimed anew
+   */
+  bool owns(ClientId clientId) const {
+    const uint32_t idx = slotOf(clientId);
+    return idx < MAX_SESSIONS && owner(idx) == clientId;
+  }
+
+  /**
+   * @brief Called by the server before the queues of the slots are mapped
+   */
+  void open(uint32_t count) {
+    if (count > MAX_SESSIONS) {
+      throw std::runtime_error(std::format("Too many shm sessions {}", count));
+    }
+    sessions.store(count, std::memory_order_release);
+  }
+
+  /**
+   * @brief Claims a free slot for the calling process
+   * @return ClientId of the claim, slot index is in its low bits
+   */
+  auto claim() -> Optional<ClientId> {
+    const uint32_t pid = static_cast<uint32_t>(getpid());
+    const uint32_t count = sessions.load(std::memory_order_acquire);
+    for (uint32_t idx = 0; idx < count; ++idx) {
+      auto &slot = slots[idx];
+      auto state = SlotState::Free;
+      if (!slot.state.compare_exchange_strong(state, SlotState::Claimed,
+                                              std::memory_order_acq_rel)) {
+        uint32_t owner = slot.pid.load(std::memory_order_acquire);
+        if (owner == 0 || alive(owner) ||
+            !slot.pid.compare_exchange_strong(owner, pid, std::memory_order_acq_rel)) {
+          continue;
+        }
+        LOG_WARN_SYSTEM("Reclaimed shm session {} of a dead process {}", idx, owner);
+        return clientId(idx, slot.generation.fetch_add(1, std::memory_order_acq_rel) + 1);
+      }
+      slot.pid.store(pid, std::memory_order_release);
+      return clientId(idx, slot.generation.fetch_add(1, std::memory_order_acq_rel) + 1);
+    }
+    return std::nullopt;
+  }
+
+  void release(uint32_t idx) {
+    slots[idx].pid.store(0, std::memory_order_release);
+    slots[idx].state.store(SlotState::Free, std::memory_order_release);
+  }
+
+  void increment() { refCount.fetch_add(1, std::memory_order_release); }
+
+  bool decrement() noexcept {
+    uint32_t old = refCount.load(std::memory_order_acquire);
+    while (old > 0) {
+      if (refCount.compare_exchange_weak( // format
+              old, old - 1, std::memory_order_acq_rel, std::memory_order_acquire)) {
+        return old == 1;
+      }
+    }
+    LOG_ERROR("Attempted to decrement refCount already at 0");
+    return false;
+  }
+
+  size_t count() const { return refCount.load(std::memory_order_acquire); }
+
+private:
+  static bool alive(uint32_t pid) {
+    return kill(static_cast<pid_t>(pid), 0) == 0 || errno != ESRCH;
+  }
+};
+
+/**
+ * @brief Upstream record of a shm session, order stamped with the ClientId of the claim
+ */
+struct ShmOrder {
+  ClientId clientId;
+  Order order;
+};
+
+enum class ShmFeedType : uint8_t { Price, Level };
+
+/**
+ * @brief Broadcast record, one byte type tag followed by the plain message
+ */
+struct ShmFeedRecord {
+  static constexpr size_t TAG_SIZE = sizeof(ShmFeedType);
+  static constexpr size_t CAPACITY = TAG_SIZE + std::max(sizeof(TickerPrice), sizeof(LevelUpdate));
+
+  template <typename Type>
+  static constexpr ShmFeedType typeOf() {
+    if constexpr (std::is_same_v<Type, TickerPrice>) {
+      return ShmFeedType::Price;
+    } else {
+      static_assert(std::is_same_v<Type, LevelUpdate>, "Not a broadcast message");
+      return ShmFeedType::Level;
+    }
+  }
+
+  template <typename Type>
+  auto pack(CRef<Type> message) -> CByteSpan {
+    data[0] = static_cast<uint8_t>(typeOf<Type>());
+    std::memcpy(data.data() + TAG_SIZE, &message, sizeof(Type));
+    return CByteSpan{data.data(), TAG_SIZE + sizeof(Type)};
+  }
+
+  inline auto type() const -> ShmFeedType { return static_cast<ShmFeedType>(data[0]); }
+
+  /**
+   * @brief Message of the record read with size bytes, nullopt if the tag or size do not match
+   */
+  template <typename Type>
+  auto unpack(size_t size) const -> Optional<Type> {
+    if (type() != typeOf<Type>() || size != TAG_SIZE + sizeof(Type)) {
+      return std::nullopt;
+    }
+    Type message;
+    std::memcpy(&message, data.data() + TAG_SIZE, sizeof(Type));
+    return message;
+  }
+
+  std::array<uint8_t, CAPACITY> data{};
+};
+
+} // namespace hft
+
+#endif // HFT_COMMON_SHMSESSIONREGISTRY_HPP
@@ -0,0 +1,99 @@
+/**
+ * @author Vladimir Pavliv
+ * @date 2026-02-14
+ */
+
+#include "shm_subscriber.hpp"
+#include "shm_reactor.hpp"
+#include "utils/handler.hpp"
+
+namespace hft {
+
+ShmSubscriber::ShmSubscriber(CRef<String> name)
+    : shm_{name}, reactor_{init()}, cursor_{shm_->ring.attach()} {
+  LOG_INFO_SYSTEM("ShmSubscriber ctor");
+}
+
+ShmSubscriber::~ShmSubscriber() {
+  LOG_DEBUG_SYSTEM("~ShmSubscriber, lapped by {} messages", cursor_.lapped);
+}
+
+ShmReactor &ShmSubscriber::init() {
+  ShmReactor *r = ShmReactor::instance.load(std::memory_order_acquire);
+  if (r == nullptr) {
+    throw std::runtime_error("ShmReactor is not initialized");
+  }
+  return *r;
+}
+
+ShmSubscriber::ShmSubscriber(ShmSubscriber &&other)
+    : shm_{std::move(other.shm_)}, reactor_{other.reactor_}, cursor_{other.cursor_},
+      buf_{std::move(other.buf_)}, clb_{std::move(other.clb_)}, state_{other.state_.load()} {
+  other.state_ = State::Closed;
+}
+
+void ShmSubscriber::asyncRx(ByteSpan buf, CRefHandler<IoResult> &&clb) {
+  if (state_ != State::Ready) {
+    LOG_ERROR_SYSTEM("Invalid state in ShmSubscriber");
+    return;
+  }
+  LOG_INFO_SYSTEM("asyncRx");
+  buf_ = buf;
+  clb_ = std::move(clb);
+
+  state_.store(State::Active, std::memory_order_release);
+  reactor_.add(this);
+}
+
+ShmSubscriber::PollResult ShmSubscriber::poll() {
+  switch (state_.load(std::memory_order_acquire)) {
+  case State::Ready:
+    return PollResult::Idle;
+  case State::Active: {
+    const uint32_t bytes = shm_->ring.readBatch(cursor_, buf_.data(), buf_.size());
+    if (bytes != 0) {
+      clb_(IoResult{bytes, IoStatus::Ok});
+      return PollResult::Busy;
+    }
+    return PollResult::Idle;
+  }
+  case State::Closing:
+    state_.store(State::Closed, std::memory_order_release);
+    return PollResult::Vanished;
+  default:
+    return PollResult::Vanished;
+  }
+}
+
+void ShmSubscriber::close() {
+  LOG_DEBUG_SYSTEM("ShmSubscriber::close");
+  auto state = state_.load(std::memory_order_acquire);
+  if (state == State::Ready || state == State::Active) {
+    state_.store(State::Closing);
+    shm_->notify();
+  }
+}
+
+void ShmSubscriber::wait(uint64_t timeoutNs) {
+  const auto ftxVal = shm_->prepareWait();
+  if (shm_->ring.empty(cursor_)) {
+    utils::futexWait(shm_->futex, ftxVal, timeoutNs);
+  }
+  shm_->cancelWait();
+}
+
+void ShmSubscriber::notify() { shm_->notify(); }
+
+auto ShmSubscriber::prepareWait() -> utils::futex_waitv {
+  return utils::makeWaitv(shm_->futex, shm_->prepareWait());
+}
+
+void ShmSubscriber::cancelWait() { shm_->cancelWait(); }
+
+bool ShmSubscriber::pending() const {
+  return state_.load(std::memory_order_acquire) != State::Active || !shm_->ring.empty(cursor_);
+}
+
+auto ShmSubscriber::syncRx(ByteSpan buf) -> IoResult { return {0, IoStatus::Error}; }
+
+} // namespace hft
@@ -0,0 +1,72 @@
+/**
+ * @author Vladimir Pavliv
+ * @date 2026-02-14
+ */
+
+#ifndef HFT_COMMON_SHMSUBSCRIBER_HPP
+#define HFT_COMMON_SHMSUBSCRIBER_HPP
+
+#include "container_types.hpp"
+#include "functional_types.hpp"
+#include "io_result.hpp"
+#include "primitive_types.hpp"
+#include "shm_broadcast.hpp"
+#include "shm_ptr.hpp"
+#include "shm_reader.hpp"
+#include "utils/handler.hpp"
+#include "utils/sync_utils.hpp"
+
+namespace hft {
+
+class ShmReactor;
+
+/**
+ * @brief Reading side of ShmBroadcast, keeps its own cursor, polled by ShmReactor
+ * starts at the newest message, lapped subscriber skips ahead and keeps going
+ */
+class ShmSubscriber {
+  enum class State : uint8_t { Ready, Active, Closing, Closed };
+
+public:
+  using PollResult = ShmReader::PollResult;
+
+  explicit ShmSubscriber(CRef<String> name);
+  ShmSubscriber(ShmSubscriber &&other);
+  ~ShmSubscriber();
+
+  ShmSubscriber &operator=(ShmSubscriber &&other) = delete;
+  ShmSubscriber(const ShmSubscriber &) = delete;
+
+  void asyncRx(ByteSpan buf, CRefHandler<IoResult> &&clb);
+  auto syncRx(ByteSpan buf) -> IoResult;
+  void close();
+  void wait(uint64_t timeoutNs = 0);
+  void notify();
+
+  auto prepareWait() -> utils::futex_waitv;
+  void cancelWait();
+  bool pending() const;
+
+  auto poll() -> PollResult;
+
+  /**
+   * @brief Messages missed due to being lapped by the publisher
+   */
+  uint64_t lapped() const { return cursor_.lapped; }
+
+private:
+  ShmReactor &init();
+
+private:
+  ShmUPtr<ShmBroadcast> shm_;
+  ShmReactor &reactor_;
+  ShmBroadcast::Ring::Cursor cursor_;
+
+  ByteSpan buf_;
+  CRefHandler<IoResult> clb_;
+  Atomic<State> state_{State::Ready};
+};
+
+} // namespace hft
+
+#endif // HFT_COMMON_SHMSUBSCRIBER_HPP
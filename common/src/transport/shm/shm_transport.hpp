@@ -8,9 +8,11 @@
 
 #include "bus/system_bus.hpp"
 #include "functional_types.hpp"
+#include "shm_publisher.hpp"
 #include "shm_queue.hpp"
 #include "shm_reactor.hpp"
 #include "shm_reader.hpp"
+#include "shm_subscriber.hpp"
 #include "shm_writer.hpp"
 #include "utils/handler.hpp"
 
@@ -18,7 +20,7 @@ namespace hft {
 
 class ShmTransport {
 public:
-  enum class Type : uint8_t { None, Reader, Writer };
+  enum class Type : uint8_t { None, Reader, Writer, Subscriber, Publisher };
 
   static ShmTransport makeReader(CRef<String> name) {
     ShmTransport t(Type::Reader);
@@ -32,6 +34,18 @@ public:
     return t;
   }
 
+  static ShmTransport makeSubscriber(CRef<String> name) {
+    ShmTransport t(Type::Subscriber);
+    t.subscriber_.emplace(name);
+    return t;
+  }
+
+  static ShmTransport makePublisher(CRef<String> name) {
+    ShmTransport t(Type::Publisher);
+    t.publisher_.emplace(name);
+    return t;
+  }
+
   ShmTransport(ShmTransport &&other) noexcept = default;
   ShmTransport &operator=(ShmTransport &&other) noexcept = delete;
 
@@ -43,6 +57,8 @@ public:
     LOG_DEBUG("ShmTransport syncRx");
     if (type_ == Type::Reader) {
       return reader_->syncRx(buf);
+    } else if (type_ == Type::Subscriber) {
+      return subscriber_->syncRx(buf);
     }
     LOG_ERROR_SYSTEM("Unable to read from shm: wrong transport type");
     return {0, IoStatus::Error};
@@ -52,6 +68,8 @@ public:
     LOG_DEBUG("ShmTransport asyncRx");
     if (type_ == Type::Reader) {
       reader_->asyncRx(buf, std::move(clb));
+    } else if (type_ == Type::Subscriber) {
+      subscriber_->asyncRx(buf, std::move(clb));
     } else {
       LOG_ERROR_SYSTEM("Unable to read from shm: wrong transport type");
     }
@@ -61,6 +79,8 @@ public:
     LOG_DEBUG("ShmTransport syncTx");
     if (type_ == Type::Writer) {
       return writer_->syncTx(buffer);
+    } else if (type_ == Type::Publisher) {
+      return publisher_->syncTx(buffer);
     }
     LOG_ERROR_SYSTEM("Unable to write to shm: wrong transport type");
     return {0, IoStatus::Error};
@@ -70,6 +90,8 @@ public:
     LOG_DEBUG("ShmTransport asyncTx");
     if (type_ == Type::Writer) {
       writer_->asyncTx(buffer, std::move(clb));
+    } else if (type_ == Type::Publisher) {
+      publisher_->asyncTx(buffer, std::move(clb));
     } else {
       LOG_ERROR_SYSTEM("Unable to write to shm: wrong transport type");
     }
@@ -82,6 +104,12 @@ public:
     if (writer_.has_value()) {
       writer_->close();
     }
+    if (subscriber_.has_value()) {
+      subscriber_->close();
+    }
+    if (publisher_.has_value()) {
+      publisher_->close();
+    }
   }
 
 private:
@@ -93,6 +121,8 @@ private:
 
   std::optional<ShmReader> reader_;
   std::optional<ShmWriter> writer_;
+  std::optional<ShmSubscriber> subscriber_;
+  std::optional<ShmPublisher> publisher_;
 };
 
 } // namespace hft
@@ -0,0 +1,90 @@
+/**
+ * @author Vladimir Pavliv
+ * @date 2026-02-18
+ */
+
+#ifndef HFT_COMMON_INPLACEHANDLER_HPP
+#define HFT_COMMON_INPLACEHANDLER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace hft {
+
+/**
+ * @brief Owning callback kept in place, for completions stored until the kernel is done
+ * same size limit as boost async handlers, so nothing on the io path allocates
+ */
+template <typename Arg, size_t Capacity = 64>
+class InplaceHandler {
+public:
+  InplaceHandler() = default;
+
+  InplaceHandler(InplaceHandler &&other) noexcept { moveFrom(other); }
+
+  InplaceHandler &operator=(InplaceHandler &&other) noexcept {
+    if (this != &other) {
+      reset();
+      moveFrom(other);
+    }
+    return *this;
+  }
+
+  InplaceHandler(const InplaceHandler &) = delete;
+  InplaceHandler &operator=(const InplaceHandler &) = delete;
+
+  ~InplaceHandler() { reset(); }
+
+  template <typename Callable>
+  void emplace(Callable &&callable) {
+    using T = std::decay_t<Callable>;
+    static_assert(sizeof(T) <= Capacity, "async handler is too large");
+    static_assert(alignof(T) <= alignof(std::max_align_t));
+
+    reset();
+    new (storage_) T(std::forward<Callable>(callable));
+    invoke_ = [](void *self, Arg arg) { (*static_cast<T *>(self))(arg); };
+    relocate_ = [](void *dst, void *src) {
+      new (dst) T(std::move(*static_cast<T *>(src)));
+      static_cast<T *>(src)->~T();
+    };
+    destroy_ = [](void *self) { static_cast<T *>(self)->~T(); };
+  }
+
+  inline void operator()(Arg arg) { invoke_(storage_, arg); }
+
+  inline void reset() noexcept {
+    if (destroy_ != nullptr) {
+      destroy_(storage_);
+      invoke_ = nullptr;
+      relocate_ = nullptr;
+      destroy_ = nullptr;
+    }
+  }
+
+  explicit operator bool() const { return invoke_ != nullptr; }
+
+private:
+  void moveFrom(InplaceHandler &other) noexcept {
+    if (other.relocate_ != nullptr) {
+      other.relocate_(storage_, other.storage_);
+      invoke_ = std::exchange(other.invoke_, nullptr);
+      relocate_ = std::exchange(other.relocate_, nullptr);
+      destroy_ = std::exchange(other.destroy_, nullptr);
+    }
+  }
+
+private:
+  alignas(std::max_align_t) uint8_t storage_[Capacity];
+
+  void (*invoke_)(void *, Arg){nullptr};
+  void (*relocate_)(void *, void *){nullptr};
+  void (*destroy_)(void *){nullptr};
+};
+
+} // namespace hft
+
+#endif // HFT_COMMON_INPLACEHANDLER_HPP
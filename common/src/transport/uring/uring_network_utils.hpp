@@ -0,0 +1,96 @@
+/**
+ * @author Vladimir Pavliv
+ * @date 2026-02-18
+ */
+
+#ifndef HFT_COMMON_URINGNETWORKUTILS_HPP
+#define HFT_COMMON_URINGNETWORKUTILS_HPP
+
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstring>
+#include <format>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "io_result.hpp"
+#include "logging.hpp"
+#include "primitive_types.hpp"
+#include "ptr_types.hpp"
+
+namespace hft {
+
+static constexpr int SOCKET_BUFFER_SIZE = 1024 * 1024 * 4;
+
+/**
+ * @brief Maps errno of a failed completion or call
+ */
+inline IoStatus toIoStatus(int error) noexcept {
+  switch (error) {
+  case ECANCELED:
+  case ECONNRESET:
+  case EPIPE:
+  case EBADF:
+    return IoStatus::Closed;
+  case EAGAIN:
+    return IoStatus::WouldBlock;
+  default:
+    LOG_ERROR("{}", std::strerror(error));
+    return IoStatus::Error;
+  }
+}
+
+/**
+ * @brief Result of a completion or of a plain send/recv call
+ */
+inline IoResult toIoResult(long res) noexcept {
+  if (res < 0) {
+    return {0, toIoStatus(static_cast<int>(-res))};
+  }
+  return {static_cast<uint32_t>(res), IoStatus::Ok};
+}
+
+inline sockaddr_in makeAddress(in_addr_t address, Port port) {
+  sockaddr_in addr{};
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(port);
+  addr.sin_addr.s_addr = address;
+  return addr;
+}
+
+inline sockaddr_in makeAddress(CRef<String> url, Port port) {
+  sockaddr_in addr = makeAddress(INADDR_ANY, port);
+  if (::inet_pton(AF_INET, url.c_str(), &addr.sin_addr) != 1) {
+    throw std::runtime_error(std::format("Invalid address {}", url));
+  }
+  return addr;
+}
+
+inline void setSocketOption(int fd, int level, int option, int value) {
+  if (::setsockopt(fd, level, option, &value, sizeof(value)) != 0) {
+    throw std::runtime_error(std::format("setsockopt {} failed: {}", option, std::strerror(errno)));
+  }
+}
+
+inline int openSocket(int type) {
+  const int fd = ::socket(AF_INET, type | SOCK_CLOEXEC, 0);
+  if (fd < 0) {
+    throw std::runtime_error(std::format("Failed to open socket: {}", std::strerror(errno)));
+  }
+  setSocketOption(fd, SOL_SOCKET, SO_SNDBUF, SOCKET_BUFFER_SIZE);
+  setSocketOption(fd, SOL_SOCKET, SO_RCVBUF, SOCKET_BUFFER_SIZE);
+  return fd;
+}
+
+inline void configureTcpSocket(int fd) {
+  setSocketOption(fd, SOL_SOCKET, SO_SNDBUF, SOCKET_BUFFER_SIZE);
+  setSocketOption(fd, SOL_SOCKET, SO_RCVBUF, SOCKET_BUFFER_SIZE);
+  setSocketOption(fd, IPPROTO_TCP, TCP_NODELAY, 1);
+}
+
+} // namespace hft
+
+#endif // HFT_COMMON_URINGNETWORKUTILS_HPP
@@ -0,0 +1,275 @@
+/**
+ * @author Vladimir Pavliv
+ * @date 2026-02-18
+ */
+
+#ifndef HFT_COMMON_URINGREACTOR_HPP
+#define HFT_COMMON_URINGREACTOR_HPP
+
+#include <csignal>
+#include <cstring>
+#include <format>
+#include <liburing.h>
+#include <mutex>
+#include <stdexcept>
+#include <sys/eventfd.h>
+#include <sys/uio.h>
+#include <thread>
+#include <unistd.h>
+
+#include "container_types.hpp"
+#include "containers/buffer_pool.hpp"
+#include "inplace_handler.hpp"
+#include "logging.hpp"
+#include "primitive_types.hpp"
+#include "ptr_types.hpp"
+#include "utils/sync_utils.hpp"
+
+namespace hft {
+
+/**
+ * @brief Single io_uring shared by all the sockets of a process side, completions are reaped
+ * on the thread that runs it
+ * @details BufferPool memory is registered once, writes from it go as fixed buffer writes.
+ * Stream receives are multishot into provided buffers of the ring, so a socket is armed once
+ * and not per read. Submissions are only prepared under the lock and flushed together
+ * by the reactor thread right before it waits again, other threads wake it up over an eventfd
+ * once per batch, so writes coming from the system threads share one submit syscall.
+ * With URING_SQPOLL a kernel thread picks submissions up and there are no submit syscalls
+ */
+class UringReactor {
+public:
+  using Completion = InplaceHandler<CRef<io_uring_cqe>>;
+
+  static constexpr uint32_t QUEUE_DEPTH = 4096;
+  static constexpr uint32_t MAX_OPS = QUEUE_DEPTH * 2;
+  static constexpr uint16_t RX_GROUP = 0;
+  static constexpr uint32_t RX_BUFFER_COUNT = 1024;
+  static constexpr uint32_t RX_BUFFER_SIZE = 4096;
+  static constexpr uint32_t SQPOLL_IDLE_MS = 1000;
+  static constexpr uint64_t WAKE_OP = UINT64_MAX;
+
+  UringReactor() : ops_(MAX_OPS), rxBuffers_(RX_BUFFER_COUNT * RX_BUFFER_SIZE) {
+    // peer closing the socket under an in flight write should be an error, not a signal
+    std::signal(SIGPIPE, SIG_IGN);
+
+    io_uring_params params{};
+#ifdef URING_SQPOLL
+    params.flags |= IORING_SETUP_SQPOLL;
+    params.sq_thread_idle = SQPOLL_IDLE_MS;
+#endif
+    if (const int res = io_uring_queue_init_params(QUEUE_DEPTH, &ring_, &params); res < 0) {
+      throw std::runtime_error(std::format("Failed to init io_uring: {}", std::strerror(-res)));
+    }
+
+    auto pool = BufferPool<>::instance().storage();
+    const iovec iov{pool.data(), pool.size()};
+    if (const int res = io_uring_register_buffers(&ring_, &iov, 1); res < 0) {
+      LOG_WARN_SYSTEM("Failed to register buffers, fixed writes are off: {}", std::strerror(-res));
+    } else {
+      registered_ = CByteSpan{pool.data(), pool.size()};
+    }
+
+    int res = 0;
+    rxRing_ = io_uring_setup_buf_ring(&ring_, RX_BUFFER_COUNT, RX_GROUP, 0, &res);
+    if (rxRing_ == nullptr) {
+      io_uring_queue_exit(&ring_);
+      throw std::runtime_error(
+          std::format("Failed to set up io_uring buffer ring: {}", std::strerror(-res)));
+    }
+    for (uint32_t idx = 0; idx < RX_BUFFER_COUNT; ++idx) {
+      io_uring_buf_ring_add(rxRing_, rxBuffer(idx), RX_BUFFER_SIZE, idx,
+                            io_uring_buf_ring_mask(RX_BUFFER_COUNT), idx);
+    }
+    io_uring_buf_ring_advance(rxRing_, RX_BUFFER_COUNT);
+
+    freeOps_.reserve(MAX_OPS);
+    for (uint32_t idx = MAX_OPS; idx > 0; --idx) {
+      freeOps_.push_back(idx - 1);
+    }
+
+    wakeFd_ = eventfd(0, EFD_CLOEXEC);
+    if (wakeFd_ < 0) {
+      io_uring_free_buf_ring(&ring_, rxRing_, RX_BUFFER_COUNT, RX_GROUP);
+      io_uring_queue_exit(&ring_);
+      throw std::runtime_error(std::format("Failed to create eventfd: {}", std::strerror(errno)));
+    }
+    armWakeup();
+  }
+
+  ~UringReactor() {
+    io_uring_free_buf_ring(&ring_, rxRing_, RX_BUFFER_COUNT, RX_GROUP);
+    io_uring_queue_exit(&ring_);
+    ::close(wakeFd_);
+  }
+
+  UringReactor(const UringReactor &) = delete;
+  UringReactor &operator=(const UringReactor &) = delete;
+
+  /**
+   * @brief Prepares an sqe with prep, completion gets every cqe of it,
+   * the multishot ones included
+   * @return false if there is no room for one more operation, completion is not taken then
+   */
+  template <typename PrepFn, typename Callable>
+  bool submit(PrepFn &&prep, Callable &&completion) {
+    std::lock_guard lock{submitLock_};
+    if (UNLIKELY(freeOps_.empty())) {
+      LOG_ERROR_SYSTEM("Too many io_uring operations in flight");
+      return false;
+    }
+    io_uring_sqe *sqe = io_uring_get_sqe(&ring_);
+    if (UNLIKELY(sqe == nullptr)) {
+      io_uring_submit(&ring_);
+      sqe = io_uring_get_sqe(&ring_);
+      if (sqe == nullptr) {
+        LOG_ERROR_SYSTEM("io_uring submission queue is full");
+        return false;
+      }
+    }
+    const uint32_t idx = freeOps_.back();
+    freeOps_.pop_back();
+    ops_[idx].emplace(std::forward<Callable>(completion));
+
+    prep(sqe);
+    io_uring_sqe_set_data64(sqe, idx);
+    if (std::this_thread::get_id() != reactorThread_.load(std::memory_order_relaxed)) {
+      wakeup();
+    }
+    return true;
+  }
+
+  /**
+   * @brief Reaps completions until stopped
+   */
+  void run() {
+    reactorThread_.store(std::this_thread::get_id(), std::memory_order_relaxed);
+
+    while (!stopped_.load(std::memory_order_acquire)) {
+      flush();
+
+      io_uring_cqe *cqe = nullptr;
+      const int res = io_uring_wait_cqe(&ring_, &cqe);
+      if (res < 0) {
+        if (res != -EINTR) {
+          LOG_ERROR_SYSTEM("io_uring wait failed: {}", std::strerror(-res));
+        }
+        continue;
+      }
+      uint32_t head = 0;
+      uint32_t count = 0;
+      io_uring_for_each_cqe(&ring_, head, cqe) {
+        complete(*cqe);
+        ++count;
+      }
+      io_uring_cq_advance(&ring_, count);
+    }
+    reactorThread_.store(std::thread::id{}, std::memory_order_relaxed);
+  }
+
+  void stop() {
+    if (stopped_.exchange(true)) {
+      return;
+    }
+    // wake the reactor up, so it sees the flag
+    submit([](io_uring_sqe *sqe) { io_uring_prep_nop(sqe); }, [](CRef<io_uring_cqe>) {});
+  }
+
+  inline bool registered(CByteSpan buffer) const noexcept {
+    return !registered_.empty() && buffer.data() >= registered_.data() &&
+           buffer.data() + buffer.size() <= registered_.data() + registered_.size();
+  }
+
+  inline uint8_t *rxBuffer(uint32_t bufferId) noexcept {
+    return rxBuffers_.data() + bufferId * RX_BUFFER_SIZE;
+  }
+
+  /**
+   * @brief Gives the provided buffer back to the kernel, reactor thread only
+   */
+  inline void recycle(uint32_t bufferId) noexcept {
+    io_uring_buf_ring_add(rxRing_, rxBuffer(bufferId), RX_BUFFER_SIZE, bufferId,
+                          io_uring_buf_ring_mask(RX_BUFFER_COUNT), 0);
+    io_uring_buf_ring_advance(rxRing_, 1);
+  }
+
+private:
+  /**
+   * @brief Called under the submit lock, so the reactor flushes this sqe after it takes the wakeup
+   */
+  inline void wakeup() {
+#ifdef URING_SQPOLL
+    io_uring_submit(&ring_);
+#else
+    if (!wakePending_.exchange(true, std::memory_order_acq_rel)) {
+      const uint64_t one = 1;
+      if (UNLIKELY(::write(wakeFd_, &one, sizeof(one)) < 0)) {
+        LOG_ERROR_SYSTEM("Failed to wake io_uring reactor: {}", std::strerror(errno));
+      }
+    }
+#endif
+  }
+
+  /**
+   * @brief Reads the eventfd through the ring, rearmed on every wakeup
+   */
+  inline void armWakeup() {
+    io_uring_sqe *sqe = io_uring_get_sqe(&ring_);
+    if (UNLIKELY(sqe == nullptr)) {
+      io_uring_submit(&ring_);
+      sqe = io_uring_get_sqe(&ring_);
+    }
+    io_uring_prep_read(sqe, wakeFd_, &wakeCount_, sizeof(wakeCount_), 0);
+    io_uring_sqe_set_data64(sqe, WAKE_OP);
+  }
+
+  inline void flush() {
+    std::lock_guard lock{submitLock_};
+    if (io_uring_sq_ready(&ring_) != 0) {
+      io_uring_submit(&ring_);
+    }
+  }
+
+  inline void complete(CRef<io_uring_cqe> cqe) {
+    const uint64_t data = io_uring_cqe_get_data64(&cqe);
+    if (data == WAKE_OP) {
+      if (cqe.res < 0) {
+        LOG_ERROR_SYSTEM("io_uring wakeup read failed: {}", std::strerror(-cqe.res));
+      }
+      // cleared before the flush, a submission after it wakes the reactor up again
+      wakePending_.store(false, std::memory_order_release);
+      std::lock_guard lock{submitLock_};
+      armWakeup();
+      return;
+    }
+    const auto idx = static_cast<uint32_t>(data);
+    auto &op = ops_[idx];
+    op(cqe);
+    if ((cqe.flags & IORING_CQE_F_MORE) == 0) {
+      op.reset();
+      std::lock_guard lock{submitLock_};
+      freeOps_.push_back(idx);
+    }
+  }
+
+private:
+  io_uring ring_{};
+  io_uring_buf_ring *rxRing_{nullptr};
+
+  Vector<Completion> ops_;
+  Vector<uint32_t> freeOps_;
+  ByteBuffer rxBuffers_;
+  CByteSpan registered_;
+
+  int wakeFd_{-1};
+  uint64_t wakeCount_{0};
+
+  utils::SpinLock submitLock_;
+  Atomic<std::thread::id> reactorThread_;
+  ALIGN_CL AtomicBool wakePending_{false};
+  AtomicBool stopped_{false};
+};
+
+} // namespace hft
+
+#endif // HFT_COMMON_URINGREACTOR_HPP
@@ -0,0 +1,219 @@
+/**
+ * @author Vladimir Pavliv
+ * @date 2026-02-18
+ */
+
+#ifndef HFT_COMMON_URINGTCPTRANSPORT_HPP
+#define HFT_COMMON_URINGTCPTRANSPORT_HPP
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "container_types.hpp"
+#include "inplace_handler.hpp"
+#include "io_result.hpp"
+#include "logging.hpp"
+#include "primitive_types.hpp"
+#include "ptr_types.hpp"
+#include "transport/uring/uring_network_utils.hpp"
+#include "transport/uring/uring_reactor.hpp"
+
+namespace hft {
+
+/**
+ * @brief Tcp socket on the io_uring reactor
+ * @details Socket is armed with a single multishot receive on the first read, data lands
+ * in the reactor provided buffers and is copied straight into the buffer of the pending read,
+ * whatever does not fit is staged for the next one. Writes from BufferPool memory are
+ * fixed buffer writes, short writes are resubmitted until the whole buffer is sent
+ */
+class UringTcpTransport {
+  using RxHandler = InplaceHandler<IoResult>;
+
+  /**
+   * @brief Socket state, armed receive keeps it alive until its last completion
+   */
+  struct Stream {
+    Stream(UringReactor &reactor, int fd) : reactor{reactor}, fd{fd} {}
+    ~Stream() { ::close(fd); }
+
+    UringReactor &reactor;
+    const int fd;
+
+    ByteBuffer staged;
+    size_t stagedHead{0};
+
+    ByteSpan rxBuffer;
+    RxHandler rxHandler;
+    bool reading{false};
+    bool armed{false};
+    IoStatus ended{IoStatus::Ok};
+  };
+
+public:
+  UringTcpTransport(UringReactor &reactor, int fd)
+      : stream_{std::make_shared<Stream>(reactor, fd)} {}
+
+  UringTcpTransport(UringTcpTransport &&) = default;
+  UringTcpTransport &operator=(UringTcpTransport &&) = default;
+
+  /**
+   * @brief Reactor thread only, same as every completion
+   */
+  template <typename Callback>
+  void asyncRx(ByteSpan buf, Callback &&clb) {
+    Stream &s = *stream_;
+    s.rxBuffer = buf;
+    s.rxHandler.emplace(std::forward<Callback>(clb));
+    s.reading = true;
+    if (!s.armed && s.ended == IoStatus::Ok) {
+      arm(stream_);
+    }
+    deliver(s);
+  }
+
+  template <typename Callback>
+  void asyncTx(CByteSpan buf, Callback &&clb) {
+    send(stream_->reactor, stream_->fd, buf, 0, std::forward<Callback>(clb));
+  }
+
+  IoResult syncRx(ByteSpan buf) {
+    const long res = ::recv(stream_->fd, buf.data(), buf.size(), 0);
+    return res < 0 ? toIoResult(-errno) : toIoResult(res);
+  }
+
+  IoResult syncTx(CByteSpan buf) {
+    const long res = ::send(stream_->fd, buf.data(), buf.size(), MSG_NOSIGNAL);
+    return res < 0 ? toIoResult(-errno) : toIoResult(res);
+  }
+
+  /**
+   * @brief Shutdown ends the armed receive, socket is closed once its state is released
+   */
+  void close() {
+    if (stream_ != nullptr) {
+      ::shutdown(stream_->fd, SHUT_RDWR);
+    }
+  }
+
+private:
+  template <typename Callback>
+  static void send(UringReactor &reactor, int fd, CByteSpan buf, uint32_t sent, Callback &&clb) {
+    const bool fixed = reactor.registered(buf);
+    const auto prep = [fd, fixed, data = buf.data() + sent,
+                       size = buf.size() - sent](io_uring_sqe *sqe) {
+      if (fixed) {
+        io_uring_prep_write_fixed(sqe, fd, data, size, 0, 0);
+      } else {
+        io_uring_prep_send(sqe, fd, data, size, MSG_NOSIGNAL);
+      }
+    };
+    auto completion = [&reactor, fd, buf, sent,
+                             clb = std::forward<Callback>(clb)](CRef<io_uring_cqe> cqe) mutable {
+      if (cqe.res <= 0) {
+        clb(IoResult{sent, cqe.res == 0 ? IoStatus::Closed : toIoStatus(-cqe.res)});
+        return;
+      }
+      const uint32_t total = sent + static_cast<uint32_t>(cqe.res);
+      if (total < buf.size()) {
+        send(reactor, fd, buf, total, std::move(clb));
+        return;
+      }
+      clb(IoResult{total, IoStatus::Ok});
+    };
+    if (!reactor.submit(prep, std::move(completion))) {
+      io_uring_cqe failed{};
+      failed.res = -EIO;
+      completion(failed);
+    }
+  }
+
+  static void arm(SPtr<Stream> stream) {
+    Stream &s = *stream;
+    const int fd = s.fd;
+    s.armed = s.reactor.submit(
+        [fd](io_uring_sqe *sqe) {
+          io_uring_prep_recv_multishot(sqe, fd, nullptr, 0, 0);
+          sqe->flags |= IOSQE_BUFFER_SELECT;
+          sqe->buf_group = UringReactor::RX_GROUP;
+        },
+        [stream](CRef<io_uring_cqe> cqe) { onRecv(stream, cqe); });
+    if (!s.armed) {
+      s.ended = IoStatus::Error;
+    }
+  }
+
+  static void onRecv(CRef<SPtr<Stream>> stream, CRef<io_uring_cqe> cqe) {
+    Stream &s = *stream;
+    uint32_t direct = 0;
+    if (cqe.res > 0) {
+      const uint32_t bufferId = cqe.flags >> IORING_CQE_BUFFER_SHIFT;
+      const uint8_t *data = s.reactor.rxBuffer(bufferId);
+      const auto size = static_cast<uint32_t>(cqe.res);
+      if (s.reading && s.stagedHead == s.staged.size()) {
+        direct = std::min<uint32_t>(size, s.rxBuffer.size());
+        std::memcpy(s.rxBuffer.data(), data, direct);
+      }
+      if (direct < size) {
+        stage(s, data + direct, size - direct);
+      }
+      s.reactor.recycle(bufferId);
+    } else if (cqe.res == 0) {
+      s.ended = IoStatus::Closed;
+    } else if (cqe.res == -ENOBUFS) {
+      LOG_WARN("Out of io_uring receive buffers");
+    } else {
+      s.ended = toIoStatus(-cqe.res);
+    }
+    if ((cqe.flags & IORING_CQE_F_MORE) == 0) {
+      s.armed = false;
+      if (s.ended == IoStatus::Ok) {
+        arm(stream);
+      }
+    }
+    if (direct != 0) {
+      complete(s, IoResult{direct, IoStatus::Ok});
+    } else {
+      deliver(s);
+    }
+  }
+
+  static void stage(Stream &s, const uint8_t *data, uint32_t size) {
+    if (s.stagedHead == s.staged.size()) {
+      s.staged.clear();
+      s.stagedHead = 0;
+    }
+    s.staged.insert(s.staged.end(), data, data + size);
+  }
+
+  static void deliver(Stream &s) {
+    if (!s.reading) {
+      return;
+    }
+    const size_t available = s.staged.size() - s.stagedHead;
+    if (available != 0) {
+      const size_t size = std::min(available, s.rxBuffer.size());
+      std::memcpy(s.rxBuffer.data(), s.staged.data() + s.stagedHead, size);
+      s.stagedHead += size;
+      complete(s, IoResult{static_cast<uint32_t>(size), IoStatus::Ok});
+    } else if (s.ended != IoStatus::Ok) {
+      complete(s, IoResult{0, s.ended});
+    }
+  }
+
+  static void complete(Stream &s, IoResult res) {
+    s.reading = false;
+    RxHandler handler{std::move(s.rxHandler)};
+    handler(res);
+  }
+
+private:
+  SPtr<Stream> stream_;
+};
+
+} // namespace hft
+
+#endif // HFT_COMMON_URINGTCPTRANSPORT_HPP
@@ -0,0 +1,107 @@
+/**
+ * @author Vladimir Pavliv
+ * @date 2026-02-18
+ */
+
+#ifndef HFT_COMMON_URINGUDPTRANSPORT_HPP
+#define HFT_COMMON_URINGUDPTRANSPORT_HPP
+
+#include <sys/socket.h>
+#include <unistd.h>
+#include <utility>
+
+#include "container_types.hpp"
+#include "io_result.hpp"
+#include "logging.hpp"
+#include "primitive_types.hpp"
+#include "ptr_types.hpp"
+#include "transport/uring/uring_network_utils.hpp"
+#include "transport/uring/uring_reactor.hpp"
+
+namespace hft {
+
+/**
+ * @brief Udp socket on the io_uring reactor, every receive is a single datagram
+ * straight into the given buffer
+ */
+class UringUdpTransport {
+public:
+  UringUdpTransport(UringReactor &reactor, int fd) : reactor_{&reactor}, fd_{fd} {}
+
+  UringUdpTransport(UringUdpTransport &&other) noexcept
+      : reactor_{other.reactor_}, fd_{std::exchange(other.fd_, -1)} {}
+
+  UringUdpTransport &operator=(UringUdpTransport &&other) noexcept {
+    if (this != &other) {
+      close();
+      reactor_ = other.reactor_;
+      fd_ = std::exchange(other.fd_, -1);
+    }
+    return *this;
+  }
+
+  ~UringUdpTransport() { close(); }
+
+  template <typename Callback>
+  void asyncRx(ByteSpan buf, Callback &&clb) {
+    submit(
+        [fd = fd_, buf](io_uring_sqe *sqe) {
+          io_uring_prep_recv(sqe, fd, buf.data(), buf.size(), 0);
+        },
+        std::forward<Callback>(clb));
+  }
+
+  template <typename Callback>
+  void asyncTx(CByteSpan buf, Callback &&clb) {
+    submit(
+        [fd = fd_, buf](io_uring_sqe *sqe) {
+          io_uring_prep_send(sqe, fd, buf.data(), buf.size(), MSG_NOSIGNAL);
+        },
+        std::forward<Callback>(clb));
+  }
+
+  IoResult syncRx(ByteSpan buf) {
+    const long res = ::recv(fd_, buf.data(), buf.size(), 0);
+    return res < 0 ? toIoResult(-errno) : toIoResult(res);
+  }
+
+  /**
+   * @brief Single send of the whole datagram
+   */
+  IoResult syncTx(CByteSpan buf) {
+    const long res = ::send(fd_, buf.data(), buf.size(), MSG_NOSIGNAL);
+    return res < 0 ? toIoResult(-errno) : toIoResult(res);
+  }
+
+  /**
+   * @brief Shutdown wakes up the pending receive before the socket goes
+   */
+  void close() {
+    if (fd_ >= 0) {
+      ::shutdown(fd_, SHUT_RDWR);
+      ::close(fd_);
+      fd_ = -1;
+    }
+  }
+
+private:
+  template <typename PrepFn, typename Callback>
+  void submit(PrepFn &&prep, Callback &&clb) {
+    auto completion = [clb = std::forward<Callback>(clb)](CRef<io_uring_cqe> cqe) mutable {
+      clb(toIoResult(cqe.res));
+    };
+    if (!reactor_->submit(std::forward<PrepFn>(prep), std::move(completion))) {
+      io_uring_cqe failed{};
+      failed.res = -EIO;
+      completion(failed);
+    }
+  }
+
+private:
+  UringReactor *reactor_;
+  int fd_;
+};
+
+} // namespace hft
+
+#endif // HFT_COMMON_URINGUDPTRANSPORT_HPP
@@ -23,10 +23,12 @@ constexpr size_t PRICE_FLUCTUATION_RATE = 5;
 static constexpr uint32_t MAX_SYSTEM_ORDERS = 1 << 17;
 static constexpr uint32_t MAX_BOOK_ORDERS = 1 << 10;
 static constexpr uint32_t MAX_TICKS = 1 << 7;
+static constexpr uint32_t MAX_OVERFLOW_ORDERS = 1 << 6;
 #else
 static constexpr uint32_t MAX_SYSTEM_ORDERS = 1 << 24;
 static constexpr uint32_t MAX_BOOK_ORDERS = 1 << 17;
 static constexpr uint32_t MAX_TICKS = 1 << 13;
+static constexpr uint32_t MAX_OVERFLOW_ORDERS = 1 << 10;
 #endif
 
 } // namespace hft
@@ -6,6 +6,10 @@
 #ifndef HFT_COMMON_DOMAINTYPES_HPP
 #define HFT_COMMON_DOMAINTYPES_HPP
 
+#include <algorithm>
+#include <array>
+
+#include "container_types.hpp"
 #include "primitive_types.hpp"
 #include "ticker.hpp"
 
@@ -24,6 +28,13 @@ enum class OrderAction : uint8_t {
   Cancel = 1 << 3
 };
 
+/**
+ * @brief Time in force and execution type
+ * Limit rests the remainder, Market and Ioc cancel it, Fok fills fully or not at all,
+ * PostOnly is rejected if it would take liquidity
+ */
+enum class OrderType : uint8_t { Limit, Market, Ioc, Fok, PostOnly };
+
 enum class OrderState : uint8_t { Accepted, Rejected, Cancelled, Partial, Full };
 
 struct LoginRequest {
@@ -50,6 +61,7 @@ struct Order {
   Quantity quantity;
   Price price;
   OrderAction action;
+  OrderType type;
   auto operator<=>(const Order &) const = default;
 };
 
@@ -62,12 +74,50 @@ struct OrderStatus {
   auto operator<=>(const OrderStatus &) const = default;
 };
 
+/**
+ * @brief Orders of one client sent in a single message, only the first count are valid
+ */
+constexpr size_t ORDER_BATCH_CAPACITY = 128;
+
+struct OrderBatch {
+  uint16_t count{0};
+  std::array<Order, ORDER_BATCH_CAPACITY> orders;
+
+  inline auto view() const -> Span<const Order> { return {orders.data(), count}; }
+  bool operator==(const OrderBatch &other) const {
+    return std::ranges::equal(view(), other.view());
+  }
+};
+
+struct OrderStatusBatch {
+  uint16_t count{0};
+  std::array<OrderStatus, ORDER_BATCH_CAPACITY> statuses;
+
+  inline auto view() const -> Span<const OrderStatus> { return {statuses.data(), count}; }
+  bool operator==(const OrderStatusBatch &other) const {
+    return std::ranges::equal(view(), other.view());
+  }
+};
+
 struct TickerPrice {
   Ticker ticker;
   Price price;
   auto operator<=>(const TickerPrice &) const = default;
 };
 
+/**
+ * @brief Incremental market-by-price update, volume is the new total at the level
+ * sequence is per ticker, so a gap means a lost update for that book
+ */
+struct LevelUpdate {
+  Ticker ticker;
+  Price price;
+  uint32_t seq;
+  uint64_t volume;
+  OrderAction side;
+  auto operator<=>(const LevelUpdate &) const = default;
+};
+
 inline String toString(const LoginRequest &msg) {
   return std::format("LoginRequest {} {}", msg.name, msg.password);
 }
@@ -114,10 +164,27 @@ inline String toString(const OrderAction &state) {
   }
 }
 
+inline String toString(const OrderType &type) {
+  switch (type) {
+  case OrderType::Limit:
+    return "Limit";
+  case OrderType::Market:
+    return "Market";
+  case OrderType::Ioc:
+    return "Ioc";
+  case OrderType::Fok:
+    return "Fok";
+  case OrderType::PostOnly:
+    return "PostOnly";
+  default:
+    return "Unknown";
+  }
+}
+
 inline String toString(const Order &o) {
-  return std::format("Order: Id:{} Ticker:{} Qty:{} Price:{} Action:{}", o.id,
+  return std::format("Order: Id:{} Ticker:{} Qty:{} Price:{} Action:{} Type:{}", o.id,
                      std::string_view(o.ticker.data(), TICKER_SIZE), o.quantity, o.price,
-                     (o.action == OrderAction::Buy ? "Buy" : "Sell"));
+                     toString(o.action), toString(o.type));
 }
 
 inline String toString(const OrderStatus &status) {
@@ -126,10 +193,23 @@ inline String toString(const OrderStatus &status) {
                      toString(status.state));
 }
 
+inline String toString(const OrderBatch &batch) {
+  return std::format("OrderBatch: Count:{}", batch.count);
+}
+
+inline String toString(const OrderStatusBatch &batch) {
+  return std::format("OrderStatusBatch: Count:{}", batch.count);
+}
+
 inline String toString(const TickerPrice &price) {
   return std::format("{}: ${}", StringView(price.ticker.data(), TICKER_SIZE), price.price);
 }
 
+inline String toString(const LevelUpdate &update) {
+  return std::format("LevelUpdate {} #{} {} ${} {}", StringView(update.ticker.data(), TICKER_SIZE),
+                     update.seq, toString(update.side), update.price, update.volume);
+}
+
 } // namespace hft
 
 #endif // HFT_COMMON_DOMAINTYPES_HPP
@@ -8,6 +8,8 @@
 
 #include <cstdint>
 
+#include "primitive_types.hpp"
+
 namespace hft {
 enum class IoStatus : uint8_t { Ok, WouldBlock, Closed, Error };
 
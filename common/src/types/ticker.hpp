@@ -9,6 +9,7 @@
 #include <array>
 #include <cstddef>
 #include <cstring>
+#include <limits>
 #include <string>
 
 namespace hft {
@@ -16,6 +17,12 @@ namespace hft {
 constexpr size_t TICKER_SIZE = 4;
 using Ticker = std::array<char, TICKER_SIZE>;
 
+/**
+ * @brief Dense position of the ticker, interned once at startup
+ */
+using TickerIdx = uint32_t;
+constexpr TickerIdx INVALID_TICKER_IDX = std::numeric_limits<TickerIdx>::max();
+
 inline Ticker makeTicker(const std::string &str) {
   Ticker ticker{};
   std::memcpy(ticker.data(), str.data(), std::min(str.size(), TICKER_SIZE));
@@ -11,9 +11,12 @@
 
 namespace hft::utils {
 
+/**
+ * @brief Connections are accepted on several network threads
+ */
 inline auto genConnectionId() -> uint32_t {
-  static uint64_t counter{0};
-  return counter++;
+  static AtomicUInt64 counter{0};
+  return counter.fetch_add(1, std::memory_order_relaxed);
 }
 
 inline auto genToken() -> uint32_t {
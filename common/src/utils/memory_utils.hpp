@@ -7,6 +7,7 @@
 #define HFT_COMMON_MEMORYUTILS_HPP
 
 #include <cstdint>
+#include <cstring>
 #include <fcntl.h>
 #include <string>
 #include <sys/mman.h>
@@ -122,6 +123,22 @@ inline T *allocHuge(size_t size, bool lock = true) {
   return static_cast<T *>(ptr);
 }
 
+/**
+ * @brief Copies size bytes to dst and returns the position right after them
+ */
+inline uint8_t *writeRaw(uint8_t *dst, const void *src, size_t size) {
+  std::memcpy(dst, src, size);
+  return dst + size;
+}
+
+/**
+ * @brief Copies size bytes from src and returns the position right after them
+ */
+inline const uint8_t *readRaw(const uint8_t *src, void *dst, size_t size) {
+  std::memcpy(dst, src, size);
+  return src + size;
+}
+
 inline void freeHuge(void *ptr, size_t size) {
   if (!ptr) {
     return;
@@ -7,6 +7,7 @@
 #define HFT_COMMON_SYNCUTILS_HPP
 
 #include <atomic>
+#include <cerrno>
 #include <cstdint>
 #include <ctime>
 #include <linux/futex.h>
@@ -14,6 +15,7 @@
 #include <unistd.h>
 
 #include "constants.hpp"
+#include "container_types.hpp"
 #include "logging.hpp"
 #include "utils/spin_wait.hpp"
 
@@ -61,19 +63,39 @@ struct futex_waitv {
   uint32_t pad;
 };
 
-inline int waitForAny(const std::vector<Futex *> &futexes) {
-  std::vector<futex_waitv> waitv(futexes.size());
+inline auto makeWaitv(Futex &futex, uint32_t curr) -> futex_waitv {
+  return futex_waitv{curr, reinterpret_cast<uintptr_t>(&futex), FUTEX_32, 0};
+}
 
-  for (size_t i = 0; i < futexes.size(); ++i) {
-    waitv[i].address = (uintptr_t)&futexes[i];
+/**
+ * @brief Sleeps until any of the futexes is woken or no longer holds its expected value
+ * @return index of the woken futex, -1 if some value has already changed or on error,
+ * ENOSYS in errno means the kernel has no futex_waitv (pre 5.16)
+ */
+inline int waitForAny(Span<futex_waitv> waitv) {
+  LOG_DEBUG("waitForAny {}", waitv.size());
+  const long res = syscall(__NR_futex_waitv, waitv.data(), waitv.size(), 0, nullptr, 0);
+  return (res >= 0) ? static_cast<int>(res) : -1;
+}
 
-    waitv[i].val = futexes[i]->load(std::memory_order_acquire);
-    waitv[i].flags = FUTEX_32;
+/**
+ * @brief Test and test-and-set lock for a few instructions long critical sections
+ */
+class SpinLock {
+public:
+  inline void lock() noexcept {
+    while (locked_.exchange(true, std::memory_order_acquire)) {
+      while (locked_.load(std::memory_order_relaxed)) {
+        asm volatile("pause" ::: "memory");
+      }
+    }
   }
 
-  long res = syscall(__NR_futex_waitv, waitv.data(), waitv.size(), 0, NULL, 0);
-  return (res >= 0) ? static_cast<int>(res) : -1;
-}
+  inline void unlock() noexcept { locked_.store(false, std::memory_order_release); }
+
+private:
+  std::atomic<bool> locked_{false};
+};
 
 } // namespace hft::utils
 
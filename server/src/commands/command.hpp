@@ -15,13 +15,15 @@ namespace hft {
 namespace server {
 /**
  * @brief Commands for console management
- * @todo Make commands to add/remove workers, orders rerouting
+ * @todo Make commands to add/remove workers
  */
 enum class Command : uint8_t {
   PriceFeed_Start,
   PriceFeed_Stop,
   Telemetry_Start,
   Telemetry_Stop,
+  Books_Snapshot,
+  Books_Rebalance,
   Shutdown
 };
 } // namespace server
@@ -36,6 +38,10 @@ inline String toString(const server::Command &command) {
     return "telemetry start";
   case server::Command::Telemetry_Stop:
     return "telemetry stop";
+  case server::Command::Books_Snapshot:
+    return "books snapshot";
+  case server::Command::Books_Rebalance:
+    return "books rebalance";
   case server::Command::Shutdown:
     return "shutdown";
   default:
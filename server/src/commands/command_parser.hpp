@@ -56,6 +56,8 @@ inline const std::map<String, Command> CommandParser::commands{
     {"p-", Command::PriceFeed_Stop},
     {"t+", Command::Telemetry_Start},
     {"t-", Command::Telemetry_Stop},
+    {"s", Command::Books_Snapshot},
+    {"r", Command::Books_Rebalance},
     {"q", Command::Shutdown}};
 
 } // namespace hft::server
@@ -48,6 +48,14 @@ ServerConfig::ServerConfig(CRef<String> fileName) : data{fileName} {
       throw std::runtime_error("Invalid cores configuration");
     }
   }
+  if (const auto cores = data.get_optional<String>("cpu.cores_network")) {
+    coresNetwork = utils::split<CoreId>(*cores);
+    for (const auto core : coresNetwork) {
+      if (core == 0 || core == coreSystem || core == coreNetwork || core == coreGateway) {
+        throw std::runtime_error("Invalid cores configuration");
+      }
+    }
+  }
   if (const auto cores = data.get_optional<String>("cpu.cores_app")) {
     coresApp = utils::split<CoreId>(*cores);
     if (coreSystem.has_value() &&
@@ -58,6 +66,11 @@ ServerConfig::ServerConfig(CRef<String> fileName) : data{fileName} {
         std::find(coresApp.begin(), coresApp.end(), *coreNetwork) != coresApp.end()) {
       throw std::runtime_error("Invalid cores configuration");
     }
+    for (const auto core : coresNetwork) {
+      if (std::find(coresApp.begin(), coresApp.end(), core) != coresApp.end()) {
+        throw std::runtime_error("Invalid cores configuration");
+      }
+    }
   }
 
   // Rates
@@ -65,6 +78,10 @@ ServerConfig::ServerConfig(CRef<String> fileName) : data{fileName} {
   monitorRate = data.get<uint32_t>("rates.monitor_rate_ms");
   telemetryRate = data.get<uint32_t>("rates.telemetry_ms");
 
+  // Data
+  orderBookLimit = data.get<uint32_t>("data.order_book_limit");
+  snapshotPath = data.get_optional<String>("data.snapshot_path").value_or("");
+
   // Logging
   logOutput = data.get<String>("log.output");
 }
@@ -74,6 +91,11 @@ void ServerConfig::print() const {
   LOG_INFO_SYSTEM("SystemCore:{} NetworkCore:{} GatewayCore:{} AppCores:{} PriceFeedRate:{}µs",
                   coreSystem.value_or(0), coreNetwork.value_or(0), coreGateway.value_or(0),
                   toString(coresApp), priceFeedRate);
+  if (!coresNetwork.empty()) {
+    LOG_INFO_SYSTEM("Extra network cores: {}", toString(coresNetwork));
+  }
+  LOG_INFO_SYSTEM("OrderBookLimit: {} per worker", orderBookLimit);
+  LOG_INFO_SYSTEM("BookSnapshot: {}", snapshotPath.empty() ? "off" : snapshotPath);
   LOG_INFO_SYSTEM("LogOutput: {}", logOutput);
 }
 
@@ -27,6 +27,7 @@ struct ServerConfig {
   // Cores
   Optional<CoreId> coreSystem;
   Optional<CoreId> coreNetwork;
+  std::vector<CoreId> coresNetwork; // extra socket io threads, one per core
   Optional<CoreId> coreGateway;
   std::vector<CoreId> coresApp;
   double nsPerCycle;
@@ -36,6 +37,10 @@ struct ServerConfig {
   uint32_t monitorRate;
   uint32_t telemetryRate;
 
+  // Data
+  uint32_t orderBookLimit;
+  String snapshotPath;
+
   // Logging
   String logOutput;
 
@@ -45,6 +45,8 @@ namespace hft::server {
  * 4. Worker
  *    -> manually dispatched from Coordinator
  *    <= (thread hop) InternalOrderStatus via gateway LfqRunner
+ *    <- (thread hop) LevelUpdate via worker level queue, drained on the system thread
+ *       as LevelUpdateBurst, SessionManager publishes it with prices
  * [gateway thread]
  * 5. OrderGateway
  *    => InternalOrderStatus, update record with local OB id, cleanup if Rejected
@@ -64,13 +66,18 @@ public:
       : config_{std::move(config)}, bus_{config_.data}, ctx_{bus_, config_, stopSrc_.get_token()},
         dbAdapter_{config_.data}, storage_{config_, dbAdapter_}, sessionMgr_{ctx_},
         ipcServer_{ctx_}, authenticator_{ctx_, dbAdapter_},
-        coordinator_{ctx_, storage_.marketData()}, gateway_{ctx_},
-        consoleReader_{ctx_.bus.systemBus}, priceFeed_{ctx_, dbAdapter_},
-        signals_{bus_.systemIoCtx(), SIGINT, SIGTERM} {
+        coordinator_{ctx_, storage_.marketData(), storage_.nodePools(), storage_.snapshot()},
+        gateway_{ctx_, storage_.marketData()}, consoleReader_{ctx_.bus.systemBus},
+        priceFeed_{ctx_, dbAdapter_}, signals_{bus_.systemIoCtx(), SIGINT, SIGTERM} {
+    if (auto *snapshot = storage_.snapshot(); snapshot != nullptr) {
+      if (storage_.restored()) {
+        gateway_.restore(storage_.nodePools(), *snapshot);
+      }
+      snapshot->track(gateway_.records());
+    }
 
     // System bus subscriptions
     bus_.subscribe(CRefHandler<ComponentReady>::bind<SelfT, &SelfT::post>(this));
-    bus_.subscribe(CRefHandler<TickerPrice>::bind<SelfT, &SelfT::post>(this));
     bus_.subscribe(CRefHandler<InternalError>::bind<SelfT, &SelfT::post>(this));
 
     // network callbacks
@@ -78,7 +85,8 @@ public:
         StreamTHandler::bind<SessionManager, &SessionManager::acceptUpstream>(&sessionMgr_));
     ipcServer_.setDownstreamClb(
         StreamTHandler::bind<SessionManager, &SessionManager::acceptDownstream>(&sessionMgr_));
-    ipcServer_.setDatagramClb(DatagramTHandler::bind<SelfT, &SelfT::onDatagram>(this));
+    ipcServer_.setDatagramClb(
+        DatagramTHandler::bind<SessionManager, &SessionManager::acceptDatagram>(&sessionMgr_));
 
     bus_.systemBus.subscribe(Command::Shutdown, Callback::bind<SelfT, &SelfT::stop>(this));
 
@@ -138,8 +146,6 @@ private:
     }
   }
 
-  void post(CRef<TickerPrice>) {}
-
   void post(CRef<InternalError> event) {
     LOG_ERROR_SYSTEM("Internal error: {} {}", event.what, toString(event.code));
     stop();
@@ -153,8 +159,6 @@ private:
     LOG_INFO_SYSTEM("Tickers loaded: {}", storage_.marketData().size());
   }
 
-  void onDatagram(DatagramTransport &&t) {}
-
 private:
   ServerConfig config_;
   std::stop_source stopSrc_;
@@ -6,6 +6,7 @@
 #ifndef HFT_SERVER_SERVERDOMAINTYPES_HPP
 #define HFT_SERVER_SERVERDOMAINTYPES_HPP
 
+#include "container_types.hpp"
 #include "domain_types.hpp"
 #include "primitive_types.hpp"
 #include "utils/string_utils.hpp"
@@ -16,6 +17,14 @@ struct ServerOrder {
   Order order;
 };
 
+/**
+ * @brief Orders of a batch message, valid only for the duration of the post
+ */
+struct ServerOrderBatch {
+  ClientId clientId;
+  Span<const Order> orders;
+};
+
 struct ServerOrderStatus {
   ClientId clientId;
   OrderStatus orderStatus;
@@ -26,6 +35,9 @@ namespace hft {
 inline String toString(const server::ServerOrder &msg) {
   return std::format("ClientId {} {}", msg.clientId, toString(msg.order));
 }
+inline String toString(const server::ServerOrderBatch &msg) {
+  return std::format("ClientId {} OrderBatch {}", msg.clientId, msg.orders.size());
+}
 inline String toString(const server::ServerOrderStatus &msg) {
   return std::format("ClientId {} {}", msg.clientId, toString(msg.orderStatus));
 }
@@ -6,6 +6,8 @@
 #ifndef HFT_SERVER_SERVEREVENTS_HPP
 #define HFT_SERVER_SERVEREVENTS_HPP
 
+#include "container_types.hpp"
+#include "domain_types.hpp"
 #include "functional_types.hpp"
 #include "primitive_types.hpp"
 #include "status_code.hpp"
@@ -31,6 +33,13 @@ constexpr uint8_t INTERNAL_READY =
 
 constexpr uint8_t ALL_READY = INTERNAL_READY | (uint8_t)Component::Ipc;
 
+/**
+ * @brief Level updates of a worker drained on the system thread, valid only within the post
+ */
+struct LevelUpdateBurst {
+  Span<const LevelUpdate> levels;
+};
+
 // TODO
 struct ChannelStatusEvent {
   Optional<ClientId> clientId;
@@ -54,6 +63,10 @@ inline String toString(const server::Component &cmp) {
   }
 }
 
+inline String toString(const server::LevelUpdateBurst &burst) {
+  return std::format("LevelUpdateBurst {}", burst.levels.size());
+}
+
 inline String toString(const server::ChannelStatusEvent &event) {
   using namespace server;
   return std::format("ChannelStatusEvent {} {}", event.clientId.value_or(0), toString(event.event));
@@ -10,13 +10,16 @@
 #include "commands/command.hpp"
 #include "config/server_config.hpp"
 #include "container_types.hpp"
+#include "containers/sequenced_spsc.hpp"
 #include "domain/server_order_messages.hpp"
 #include "domain_types.hpp"
 #include "events.hpp"
 #include "gateway/internal_order.hpp"
 #include "market_data.hpp"
+#include "execution/orderbook/node_pool.hpp"
 #include "runner/ctx_runner.hpp"
 #include "runner/lfq_runner.hpp"
+#include "storage/book_snapshot.hpp"
 #include "traits.hpp"
 #include "utils/handler.hpp"
 #include "utils/spin_wait.hpp"
@@ -26,40 +29,241 @@
 namespace hft::server {
 
 /**
- * @brief Manages order-matching workers, routes order to a proper worker by the ticker
+ * @brief Manages order-matching workers, routes order to a proper worker by the ticker index
  * for optimization tickerdata is supplied with InternalOrderEvent so the worker doesnt have to look
  * it up again in the MarketData
- * for further optimizations all tickers could be indexed at a startup to avoid 'ticker->' hashmap
- * @note ticker rerouting could be done by managing WorkerId uint32 atomic,
- * using highest bit to indicate that book is locked
- * 1. on ticker reroute sys thread does spin CAS in the OrderBook
- *    (free_flag|curr_worker_id)->(free_flag|next_worker_id)
- * 2. on order processing worker does CAS
- *    (free_flag|self_id)->(busy_flag|self_id)
- *    only way it fails is if worker_id changed
- * 3. on failure order gets returned to Coordinator for dispatching to a new worker
- * 4. on success order gets processed blocking attempts to reroute the ticker
+ * books of the same worker share its NodePool, occupancy is reported at monitor rate
+ * each worker has its own Matcher, which collects books touched during a drained batch
+ * and publishes their conflated level updates once the batch is done
+ * level updates go into the worker level queue, system thread is woken once per batch
+ * and only if it is not already scheduled to drain that queue, it posts them as bursts
+ * books snapshot is written by each worker at the end of a batch when requested,
+ * and once more after workers are stopped
+ * workers report messages and busy cycles per batch, at monitor rate rebalancer moves
+ * a book from the busiest worker to the idlest one if the load is skewed
+ * @details book move keeps the order of messages:
+ * 1. rebalancer sets TickerData::moveTo
+ * 2. on the next order for the ticker the gateway thread sends a handoff marker to the old worker
+ *    and routes everything after it to the new one
+ * 3. old worker processes all the orders queued before the marker, then hands the book off
+ *    releasing its nodes, and passes ownership with HANDOFF|new_worker
+ * 4. new worker parks orders for the book until it sees the ownership, then takes the book over
+ *    into its own pool and replays parked orders
+ * burst of an order batch is routed the same way, but staged per worker first,
+ * so each worker gets its part with a single queue write and at most one wake up
  */
 class Coordinator {
   using SelfT = Coordinator;
+
+  static constexpr double REBALANCE_MIN_BUSY = 0.5;
+  static constexpr uint64_t REBALANCE_SKEW = 2;
+  static constexpr size_t LEVEL_QUEUE_SLOTS = 8192;
+  static constexpr size_t LEVEL_DRAIN_CHUNK = 256;
+
+  /**
+   * @brief Worker side of the level feed, written by the worker, drained by the system thread
+   * update that does not fit is dropped, its book seq gap tells the client about it
+   */
+  struct LevelFeed {
+    template <typename EventT>
+    inline void post(CRef<EventT> level) {
+      if (LIKELY(queue.write(level))) {
+        written = true;
+      } else {
+        ++dropped;
+      }
+    }
+
+    SequencedSPSC<LEVEL_QUEUE_SLOTS> queue;
+    ALIGN_CL AtomicBool scheduled{false};
+    bool written{false};
+    uint64_t dropped{0};
+  };
+
   /**
    * @brief Consumer for workers to execute order in their thread
    */
   struct Matcher {
-    explicit Matcher(ServerBus &bus) : bus{bus} {}
+    struct ParkedBook {
+      const TickerData *data;
+      Vector<InternalOrderEvent> orders;
+    };
+
+    Matcher(Coordinator &coordinator, ThreadId id, NodePool &pool)
+        : coordinator{coordinator}, bus{coordinator.ctx_.bus}, id{id}, pool{pool} {
+      touched.reserve(TOUCHED_RESERVE);
+    }
 
     inline void post(CRef<InternalOrderEvent> ioe) {
       LOG_DEBUG("Matcher {}", toString(ioe));
-      ioe.data->orderBook.add(ioe, bus);
+      if (batchStart == 0) {
+        batchStart = utils::getCycles();
+      }
+      ++batchMessages;
+
+      if (UNLIKELY(ioe.data->owner.load(std::memory_order_acquire) != id) &&
+          !adopt(*ioe.data)) {
+        park(ioe);
+        return;
+      }
+      if (UNLIKELY(ioe.isHandoff())) {
+        handOff(ioe);
+        return;
+      }
+      match(ioe);
     }
 
+    /**
+     * @brief Called by the runner for the whole drained batch before it is processed,
+     * books not owned by this worker are left alone
+     */
+    inline void prefetch(CRef<InternalOrderEvent> ioe) const {
+      const TickerData &data = *ioe.data;
+      if (LIKELY(data.owner.load(std::memory_order_acquire) == id)) {
+        data.orderBook.prefetch(ioe);
+      }
+    }
+
+    inline void flush() {
+      if (UNLIKELY(!parked.empty())) {
+        for (size_t idx = 0; idx < parked.size();) {
+          if (!adopt(*parked[idx].data)) {
+            ++idx;
+          }
+        }
+      }
+      for (const auto *data : touched) {
+        data->orderBook.publishLevels(data->ticker, levels);
+      }
+      touched.clear();
+      if (levels.written) {
+        levels.written = false;
+        coordinator.scheduleLevels(id);
+      }
+      if (UNLIKELY(levels.dropped != 0)) {
+        LOG_WARN_SYSTEM("Worker {} level queue is full, dropped {} updates", id, levels.dropped);
+        levels.dropped = 0;
+      }
+      if (batchStart != 0) {
+        const uint64_t cycles = utils::getCycles() - batchStart;
+        busyCycles.store(busyCycles.load(std::memory_order_relaxed) + cycles,
+                         std::memory_order_relaxed);
+        messages.store(messages.load(std::memory_order_relaxed) + batchMessages,
+                       std::memory_order_relaxed);
+        batchStart = 0;
+        batchMessages = 0;
+      }
+      if (UNLIKELY(snapshotRequested.load(std::memory_order_acquire))) {
+        snapshotRequested.store(false, std::memory_order_relaxed);
+        coordinator.snapshot_->write(id, pool, coordinator.data_);
+      }
+    }
+
+    inline void match(CRef<InternalOrderEvent> ioe) {
+      const TickerData &data = *ioe.data;
+      const bool pending = data.orderBook.hasLevelUpdates();
+      data.orderBook.add(ioe, bus);
+      if (!pending && data.orderBook.hasLevelUpdates()) {
+        touched.push_back(&data);
+      }
+      data.orders.store(data.orders.load(std::memory_order_relaxed) + 1,
+                        std::memory_order_relaxed);
+    }
+
+    void handOff(CRef<InternalOrderEvent> ioe) {
+      const TickerData &data = *ioe.data;
+      const uint32_t target = data.moveTo.load(std::memory_order_acquire);
+
+      // nothing of the book may be touched by this worker after the ownership is passed
+      data.orderBook.publishLevels(data.ticker, levels);
+      std::erase(touched, &data);
+      data.orderBook.handOff();
+
+      data.moveTo.store(TickerData::NO_MOVE, std::memory_order_relaxed);
+      data.owner.store(TickerData::HANDOFF | target, std::memory_order_release);
+      coordinator.workers_[target]->notify();
+      LOG_INFO_SYSTEM("Worker {} handed {} off to worker {}", id, toString(data.ticker), target);
+    }
+
+    /**
+     * @brief Takes the book over if it was handed off to this worker, replays parked orders
+     */
+    bool adopt(const TickerData &data) {
+      if (data.owner.load(std::memory_order_acquire) != (TickerData::HANDOFF | id)) {
+        return false;
+      }
+      data.orderBook.takeOver(pool, bus);
+      data.owner.store(id, std::memory_order_release);
+
+      const auto iter =
+          std::find_if(parked.begin(), parked.end(),
+                       [&data](const ParkedBook &entry) { return entry.data == &data; });
+      if (iter == parked.end()) {
+        return true;
+      }
+      const auto orders = std::move(iter->orders);
+      parked.erase(iter);
+      LOG_INFO_SYSTEM("Worker {} replays {} parked orders", id, orders.size());
+      for (const auto &ioe : orders) {
+        if (UNLIKELY(ioe.isHandoff())) {
+          handOff(ioe);
+        } else {
+          match(ioe);
+        }
+      }
+      return true;
+    }
+
+    void park(CRef<InternalOrderEvent> ioe) {
+      const auto iter =
+          std::find_if(parked.begin(), parked.end(),
+                       [&ioe](const ParkedBook &entry) { return entry.data == ioe.data; });
+      if (iter != parked.end()) {
+        iter->orders.push_back(ioe);
+      } else {
+        parked.push_back(ParkedBook{ioe.data, {ioe}});
+      }
+    }
+
+    static constexpr size_t TOUCHED_RESERVE = 64;
+
+    Coordinator &coordinator;
     ServerBus &bus;
+    const ThreadId id;
+    NodePool &pool;
+
+    Vector<const TickerData *> touched;
+    LevelFeed levels;
+    Vector<ParkedBook> parked;
+    uint64_t batchStart{0};
+    uint64_t batchMessages{0};
+
+    AtomicBool snapshotRequested{false};
+
+    // load of the worker, read by the rebalancer
+    ALIGN_CL AtomicUInt64 messages{0};
+    AtomicUInt64 busyCycles{0};
   };
   using Worker = LfqRunner<InternalOrderEvent, Matcher, SystemBus>;
 
 public:
-  Coordinator(Context &ctx, CRef<MarketData> data) : ctx_{ctx}, data_{data}, matcher_{ctx_.bus} {
+  Coordinator(Context &ctx, CRef<MarketData> data, CRef<NodePools> pools,
+              BookSnapshot *snapshot = nullptr)
+      : ctx_{ctx}, data_{data}, pools_{pools}, snapshot_{snapshot}, staged_(pools.size()),
+        monitorTimer_{ctx_.bus.systemIoCtx()}, monitorRate_{ctx_.config.monitorRate},
+        reportedUsage_(pools.size(), 0), reportedBusy_(pools.size(), 0),
+        reportedMessages_(pools.size(), 0), reportedOrders_(data.size(), 0) {
+    for (auto &staged : staged_) {
+      staged.reserve(ORDER_BATCH_CAPACITY);
+    }
     ctx_.bus.subscribe(CRefHandler<InternalOrderEvent>::bind<SelfT, &SelfT::post>(this));
+    ctx_.bus.subscribe(CRefHandler<InternalOrderBurst>::bind<SelfT, &SelfT::post>(this));
+    ctx_.bus.subscribe(Command::Books_Rebalance,
+                       Callback::bind<SelfT, &SelfT::forceRebalance>(this));
+    if (snapshot_ != nullptr) {
+      ctx_.bus.subscribe(Command::Books_Snapshot,
+                         Callback::bind<SelfT, &SelfT::requestSnapshot>(this));
+    }
   }
 
   ~Coordinator() { LOG_DEBUG_SYSTEM("~Coordinator"); }
@@ -67,15 +271,42 @@ public:
   void start() {
     LOG_DEBUG("Coordinator start");
     startWorkers();
+    scheduleMonitor();
   }
 
   void stop() {
     LOG_DEBUG("Coordinator stop");
+    monitorTimer_.cancel();
     for (auto &worker : workers_) {
       worker->stop();
     }
+    if (snapshot_ != nullptr) {
+      // workers are joined, so books are safe to touch from here
+      for (const auto &data : data_) {
+        const uint32_t owner = data.owner.load(std::memory_order_acquire);
+        if (owner & TickerData::HANDOFF) {
+          matchers_[owner & ~TickerData::HANDOFF]->adopt(data);
+        }
+      }
+      for (size_t idx = 0; idx < matchers_.size(); ++idx) {
+        snapshot_->write(idx, *pools_[idx], data_);
+      }
+    }
   }
 
+#if defined(BENCHMARK_BUILD) || defined(UNIT_TESTS_BUILD)
+  /**
+   * @brief Routes the burst the way post does, but leaves it staged instead of posting to workers
+   */
+  auto stageBurst(CRef<InternalOrderBurst> burst) -> CRef<Vector<Vector<InternalOrderEvent>>> {
+    for (auto &staged : staged_) {
+      staged.clear();
+    }
+    stage(burst);
+    return staged_;
+  }
+#endif
+
 private:
   void startWorkers() {
     LOG_DEBUG("Coordinator::startWorkers");
@@ -93,41 +324,230 @@ private:
 
     started_.store(true);
     workers_.reserve(appCores);
+    matchers_.reserve(appCores);
+    for (size_t i = 0; i < appCores; ++i) {
+      matchers_.emplace_back(std::make_unique<Matcher>(*this, i, *pools_[i]));
+    }
     if (ctx_.config.coresApp.empty()) {
-      workers_.emplace_back(
-          std::make_unique<Worker>(matcher_, ctx_.bus.systemBus, ctx_.stopToken, "worker zero"));
+      workers_.emplace_back(std::make_unique<Worker>(*matchers_[0], ctx_.bus.systemBus,
+                                                     ctx_.stopToken, "worker zero"));
       workers_[0]->run(readyClb);
     } else {
       for (size_t i = 0; i < ctx_.config.coresApp.size(); ++i) {
         const auto name = std::format("worker {}", i);
         const auto coreId = ctx_.config.coresApp[i];
-        workers_.emplace_back(
-            std::make_unique<Worker>(matcher_, ctx_.bus.systemBus, ctx_.stopToken, name, coreId));
+        workers_.emplace_back(std::make_unique<Worker>(*matchers_[i], ctx_.bus.systemBus,
+                                                       ctx_.stopToken, name, coreId));
         workers_[i]->run(readyClb);
       }
     }
   }
 
+  /**
+   * @brief Worker thread, wakes the system thread up unless a drain is already pending,
+   * flag is taken with an rmw on both sides, so an update written after the drain took it
+   * always gets a drain of its own
+   */
+  void scheduleLevels(ThreadId id) {
+    if (!matchers_[id]->levels.scheduled.exchange(true, std::memory_order_acq_rel)) {
+      ctx_.bus.post([this, id]() { drainLevels(id); });
+    }
+  }
+
+  void drainLevels(ThreadId id) {
+    auto &feed = matchers_[id]->levels;
+    feed.scheduled.exchange(false, std::memory_order_acq_rel);
+    if (ctx_.stopToken.stop_requested()) {
+      return;
+    }
+    LevelUpdate chunk[LEVEL_DRAIN_CHUNK];
+    while (const size_t count = feed.queue.readBatch(Span<LevelUpdate>{chunk})) {
+      ctx_.bus.post(LevelUpdateBurst{Span<const LevelUpdate>{chunk, count}});
+    }
+  }
+
+  void requestSnapshot() {
+    LOG_INFO_SYSTEM("Books snapshot requested");
+    for (size_t idx = 0; idx < matchers_.size(); ++idx) {
+      matchers_[idx]->snapshotRequested.store(true, std::memory_order_release);
+      workers_[idx]->notify();
+    }
+  }
+
+  void scheduleMonitor() {
+    if (monitorRate_.count() == 0) {
+      return;
+    }
+    monitorTimer_.expires_after(monitorRate_);
+    monitorTimer_.async_wait([this](BoostErrorCode ec) {
+      if (ec) {
+        return;
+      }
+      reportPoolUsage();
+      rebalance(false);
+      scheduleMonitor();
+    });
+  }
+
+  void reportPoolUsage() {
+    for (size_t idx = 0; idx < pools_.size(); ++idx) {
+      const uint32_t used = pools_[idx]->used();
+      if (used == reportedUsage_[idx]) {
+        continue;
+      }
+      reportedUsage_[idx] = used;
+      const uint32_t capacity = pools_[idx]->capacity();
+      if (used * 10ULL >= capacity * 9ULL) {
+        LOG_WARN_SYSTEM("Worker {} node pool is almost full {}/{}", idx, used, capacity);
+      } else {
+        LOG_INFO_SYSTEM("Worker {} node pool {}/{}", idx, used, capacity);
+      }
+    }
+  }
+
+  void forceRebalance() { rebalance(true); }
+
+  /**
+   * @brief Moves one book from the busiest worker to the idlest one,
+   * forced run skips the load thresholds but still moves only if it narrows the gap
+   */
+  void rebalance(bool force) {
+    const size_t count = matchers_.size();
+    if (count < 2) {
+      return;
+    }
+    Vector<uint64_t> busy(count);
+    Vector<uint64_t> load(count);
+    for (size_t idx = 0; idx < count; ++idx) {
+      const uint64_t cycles = matchers_[idx]->busyCycles.load(std::memory_order_relaxed);
+      const uint64_t messages = matchers_[idx]->messages.load(std::memory_order_relaxed);
+      busy[idx] = cycles - reportedBusy_[idx];
+      load[idx] = messages - reportedMessages_[idx];
+      reportedBusy_[idx] = cycles;
+      reportedMessages_[idx] = messages;
+    }
+    Vector<uint64_t> bookLoad(data_.size());
+    for (const auto &data : data_) {
+      const uint64_t orders = data.orders.load(std::memory_order_relaxed);
+      bookLoad[data.index] = orders - reportedOrders_[data.index];
+      reportedOrders_[data.index] = orders;
+    }
+
+    const auto [coldIt, hotIt] = std::minmax_element(busy.begin(), busy.end());
+    const ThreadId hot = hotIt - busy.begin();
+    const ThreadId cold = coldIt - busy.begin();
+    if (hot == cold || load[hot] <= load[cold]) {
+      return;
+    }
+    if (!force) {
+      const double nsPerCycle = ctx_.config.nsPerCycle;
+      const double intervalNs = monitorRate_.count() * 1e6;
+      if (nsPerCycle == 0 || busy[hot] * nsPerCycle < intervalNs * REBALANCE_MIN_BUSY ||
+          busy[hot] < busy[cold] * REBALANCE_SKEW) {
+        return;
+      }
+    }
+    if (pools_[cold]->used() * 2ULL > pools_[cold]->capacity()) {
+      LOG_WARN_SYSTEM("Worker {} node pool is too full to take a book", cold);
+      return;
+    }
+
+    // moving a book with load d changes the gap g to |g - 2d|, best is d closest to g / 2
+    const uint64_t gap = load[hot] - load[cold];
+    const TickerData *pick{nullptr};
+    uint64_t bestDistance = std::numeric_limits<uint64_t>::max();
+    for (const auto &data : data_) {
+      const uint64_t orders = bookLoad[data.index];
+      if (data.owner.load(std::memory_order_acquire) != hot ||
+          data.moveTo.load(std::memory_order_acquire) != TickerData::NO_MOVE || orders == 0 ||
+          orders >= gap) {
+        continue;
+      }
+      const uint64_t distance = (orders * 2 > gap) ? orders * 2 - gap : gap - orders * 2;
+      if (distance < bestDistance) {
+        bestDistance = distance;
+        pick = &data;
+      }
+    }
+    if (pick == nullptr) {
+      LOG_INFO_SYSTEM("No book to move from worker {} to worker {}", hot, cold);
+      return;
+    }
+    LOG_INFO_SYSTEM("Moving {} from worker {} to worker {}, loads {} {}", toString(pick->ticker), hot,
+                    cold, load[hot], load[cold]);
+    pick->moveTo.store(cold, std::memory_order_release);
+  }
+
   void post(CRef<InternalOrderEvent> ioe) {
     if (ctx_.stopToken.stop_requested()) {
       return;
     }
-    if (data_.count(ioe.ticker) == 0) {
-      LOG_ERROR_SYSTEM("Ticker not found {}", toString(ioe.ticker));
+    route(ioe, [this](ThreadId workerId, CRef<InternalOrderEvent> event) {
+      workers_[workerId]->post(event);
+    });
+  }
+
+  void post(CRef<InternalOrderBurst> burst) {
+    if (ctx_.stopToken.stop_requested()) {
+      return;
+    }
+    stage(burst);
+    for (size_t idx = 0; idx < staged_.size(); ++idx) {
+      if (!staged_[idx].empty()) {
+        workers_[idx]->post(Span<const InternalOrderEvent>{staged_[idx]});
+        staged_[idx].clear();
+      }
+    }
+  }
+
+  void stage(CRef<InternalOrderBurst> burst) {
+    for (const auto &ioe : burst.events) {
+      route(ioe, [this](ThreadId workerId, CRef<InternalOrderEvent> event) {
+        staged_[workerId].push_back(event);
+      });
+    }
+  }
+
+  /**
+   * @brief Resolves the ticker data and the owning worker, sends a handoff marker first
+   * if the book is being moved
+   */
+  template <typename SinkT>
+  inline void route(CRef<InternalOrderEvent> ioe, SinkT &&sink) {
+    if (UNLIKELY(ioe.tickerIdx >= data_.size())) {
+      LOG_ERROR_SYSTEM("Ticker not found {}", toString(ioe));
       return;
     }
-    ioe.data = &data_.at(ioe.ticker);
-    workers_[ioe.data->workerId]->post(ioe);
+    const TickerData &data = data_[ioe.tickerIdx];
+    ioe.data = &data;
+
+    const uint32_t moveTo = data.moveTo.load(std::memory_order_acquire);
+    if (UNLIKELY(moveTo != TickerData::NO_MOVE && moveTo != data.workerId)) {
+      sink(data.workerId, InternalOrderEvent::makeHandoff(&data, ioe.tickerIdx));
+      data.workerId = moveTo;
+    }
+    sink(data.workerId, ioe);
   }
 
 private:
   Context &ctx_;
 
   const MarketData &data_;
+  const NodePools &pools_;
+  BookSnapshot *snapshot_;
 
   AtomicBool started_{false};
-  Matcher matcher_;
+  Vector<UPtr<Matcher>> matchers_;
   Vector<UPtr<Worker>> workers_;
+  // burst events per worker, filled and flushed within one post
+  Vector<Vector<InternalOrderEvent>> staged_;
+
+  SteadyTimer monitorTimer_;
+  const Milliseconds monitorRate_;
+  Vector<uint32_t> reportedUsage_;
+  Vector<uint64_t> reportedBusy_;
+  Vector<uint64_t> reportedMessages_;
+  Vector<uint64_t> reportedOrders_;
 };
 
 } // namespace hft::server
@@ -9,25 +9,50 @@
 #include <boost/unordered/unordered_flat_map.hpp>
 
 #include "constants.hpp"
+#include "container_types.hpp"
 #include "domain_types.hpp"
 #include "execution/orderbook/flat_order_book.hpp"
+#include "execution/orderbook/node_pool.hpp"
 #include "execution/orderbook/price_level_order_book.hpp"
 #include "primitive_types.hpp"
+#include "ptr_types.hpp"
+#include "ticker.hpp"
 #include "traits.hpp"
 
 namespace hft::server {
 
 /**
  * @brief All the data in one place
- * @todo Add atomic flag to lock the book for rerouting
+ * workerId is where the gateway thread routes orders, owner is the worker holding the book,
+ * they differ only while the book is handed over to another worker
+ * routing and worker-side fields are kept on separate cache lines
  */
 struct ALIGN_CL TickerData {
-  explicit TickerData(ThreadId id) : workerId{id} {}
+  static constexpr uint32_t NO_MOVE = std::numeric_limits<uint32_t>::max();
+  static constexpr uint32_t HANDOFF = 1U << 31;
+
+  TickerData(Ticker ticker, TickerIdx idx, ThreadId id, NodePool &pool, Price refPrice)
+      : ticker{ticker}, index{idx}, workerId{id}, owner{id}, orderBook{pool, refPrice} {}
 
   TickerData(TickerData &&other) noexcept
-      : workerId(other.workerId), orderBook(std::move(other.orderBook)) {}
+      : ticker{other.ticker}, index{other.index}, workerId(other.workerId),
+        moveTo{other.moveTo.load()}, owner{other.owner.load()}, orders{other.orders.load()},
+        orderBook(std::move(other.orderBook)) {}
+
+  const Ticker ticker;
+  /**
+   * @brief Position of the ticker in the load order, stable for the lifetime of the server
+   */
+  const TickerIdx index;
+
+  // routing, written by the gateway thread
+  mutable ThreadId workerId;
+  mutable AtomicUInt32 moveTo{NO_MOVE};
+
+  // ownership and load, written by the owning worker
+  ALIGN_CL mutable AtomicUInt32 owner;
+  mutable AtomicUInt64 orders{0};
 
-  ThreadId workerId;
   ALIGN_CL mutable OrderBook orderBook;
 
 private:
@@ -36,7 +61,55 @@ private:
   TickerData &operator=(const TickerData &other) = delete;
 };
 
-using MarketData = boost::unordered_flat_map<Ticker, TickerData, TickerHash>;
+/**
+ * @brief Books in a flat array indexed by TickerIdx
+ * tickers are interned at startup, so the hash lookup is done once per new order by the gateway
+ * and everything after it routes with a single array load
+ * @note filled only at startup, growing past the reserved size would move the books
+ */
+class MarketData {
+public:
+  void reserve(size_t count) {
+    data_.reserve(count);
+    index_.reserve(count);
+  }
+
+  /**
+   * @brief Interns the ticker at the next index, nullptr if it is already there
+   */
+  auto emplace(Ticker ticker, ThreadId workerId, NodePool &pool, Price refPrice) -> TickerData * {
+    const auto idx = static_cast<TickerIdx>(data_.size());
+    if (!index_.emplace(ticker, idx).second) {
+      return nullptr;
+    }
+    return &data_.emplace_back(ticker, idx, workerId, pool, refPrice);
+  }
+
+  [[nodiscard]] auto find(CRef<Ticker> ticker) const -> TickerIdx {
+    const auto iter = index_.find(ticker);
+    return iter == index_.end() ? INVALID_TICKER_IDX : iter->second;
+  }
+
+  inline auto operator[](TickerIdx idx) const -> CRef<TickerData> { return data_[idx]; }
+  inline auto operator[](TickerIdx idx) -> TickerData & { return data_[idx]; }
+
+  [[nodiscard]] inline size_t size() const { return data_.size(); }
+  [[nodiscard]] inline bool empty() const { return data_.empty(); }
+
+  auto begin() const { return data_.begin(); }
+  auto end() const { return data_.end(); }
+  auto begin() { return data_.begin(); }
+  auto end() { return data_.end(); }
+
+  void clear() {
+    data_.clear();
+    index_.clear();
+  }
+
+private:
+  Vector<TickerData> data_;
+  boost::unordered_flat_map<Ticker, TickerIdx, TickerHash> index_;
+};
 
 } // namespace hft::server
 
@@ -13,6 +13,7 @@
 #include "gateway/internal_order.hpp"
 #include "gateway/internal_order_status.hpp"
 #include "logging.hpp"
+#include "node_pool.hpp"
 #include "primitive_types.hpp"
 #include "ptr_types.hpp"
 #include "schema.hpp"
@@ -34,6 +35,10 @@ class FlatOrderBook {
 
 public:
   FlatOrderBook() = default;
+  /**
+   * @brief Keeps orders in its own storage, shared node pool and reference price are not used
+   */
+  FlatOrderBook(NodePool &, Price) {}
 
   FlatOrderBook(FlatOrderBook &&other) noexcept
       : bids_(std::move(other.bids_)), asks_(std::move(other.asks_)) {}
@@ -69,6 +74,26 @@ public:
     return true;
   }
 
+  static constexpr size_t IMAGE_SIZE = 0;
+
+  inline void prefetch(CRef<InternalOrderEvent>) const {}
+
+  [[nodiscard]] inline bool hasLevelUpdates() const { return false; }
+
+  /**
+   * @brief Not persisted, restored book starts empty
+   */
+  void saveImage(uint8_t *) const {}
+  void loadImage(const uint8_t *) {}
+
+  /**
+   * @brief Orders stay in the book storage, so nothing to move
+   */
+  void handOff() {}
+  bool takeOver(NodePool &, BusableFor<InternalOrderStatus> auto &) { return true; }
+
+  void publishLevels(CRef<Ticker>, BusableFor<LevelUpdate> auto &) {}
+
 #if defined(BENCHMARK_BUILD) || defined(UNIT_TESTS_BUILD)
   void sendAck(CRef<InternalOrderEvent> ioe, BusableFor<InternalOrderStatus> auto &consumer) {
     consumer.post(InternalOrderStatus(ioe.order.id, BookOrderId{}, 0, 0, OrderState::Accepted));
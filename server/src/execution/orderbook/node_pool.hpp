@@ -0,0 +1,167 @@
+/**
+ * @author Vladimir Pavliv
+ * @date 2026-02-04
+ */
+
+#ifndef HFT_SERVER_NODEPOOL_HPP
+#define HFT_SERVER_NODEPOOL_HPP
+
+#include <algorithm>
+#include <cstring>
+
+#include "constants.hpp"
+#include "container_types.hpp"
+#include "logging.hpp"
+#include "primitive_types.hpp"
+#include "ptr_types.hpp"
+#include "schema.hpp"
+#include "utils/memory_utils.hpp"
+
+namespace hft::server {
+
+enum class BookSide : uint8_t { Buy, Sell };
+
+struct BookNode {
+  uint32_t next;
+  uint32_t prev;
+
+  uint32_t price;
+  uint32_t qty;
+
+  BookOrderId localId;
+  SystemOrderId systemId;
+
+  BookSide side;
+  // amend events carry no type, so PostOnly is checked against the one the order rested with
+  OrderType type;
+};
+
+/**
+ * @brief Order node arena shared by all the books of a single worker
+ * sized at runtime, so memory scales with open orders per worker instead of tickers x max orders
+ * stack-based generation id recycling, index 0 is reserved as a null link
+ * @note only the owning worker mutates the pool, occupancy is readable from any thread
+ */
+class NodePool {
+public:
+  explicit NodePool(uint32_t capacity)
+      : capacity_{std::clamp<uint32_t>(capacity, 2, MAX_BOOK_ORDERS)}, freeTop_{0},
+        nextAvailableIdx_{1} {
+    if (capacity_ != capacity) {
+      LOG_WARN_SYSTEM("Node pool capacity {} clamped to {}", capacity, capacity_);
+    }
+    nodes_ = utils::allocHuge<BookNode>(capacity_ * sizeof(BookNode));
+    freeStack_ = utils::allocHuge<BookOrderId>(capacity_ * sizeof(BookOrderId));
+  }
+
+  ~NodePool() {
+    utils::freeHuge(nodes_, capacity_ * sizeof(BookNode));
+    utils::freeHuge(freeStack_, capacity_ * sizeof(BookOrderId));
+  }
+
+  [[nodiscard]] inline BookNode &operator[](uint32_t idx) noexcept { return nodes_[idx]; }
+  [[nodiscard]] inline const BookNode &operator[](uint32_t idx) const noexcept {
+    return nodes_[idx];
+  }
+
+  inline auto acquire() -> BookOrderId {
+    if (LIKELY(freeTop_ > 0)) {
+      used_.store(used_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+      return freeStack_[--freeTop_];
+    }
+    if (UNLIKELY(nextAvailableIdx_ >= capacity_)) {
+      return BookOrderId{};
+    }
+    used_.store(used_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    return BookOrderId::make(nextAvailableIdx_++, 1);
+  }
+
+  inline void release(BookOrderId id) {
+    id.nextGen();
+    // bump generation in the node as well so stale cancel/modify for it fails
+    nodes_[id.index()].localId = id;
+    freeStack_[freeTop_++] = id;
+    used_.store(used_.load(std::memory_order_relaxed) - 1, std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Number of nodes currently holding resting orders
+   */
+  [[nodiscard]] inline uint32_t used() const noexcept {
+    return used_.load(std::memory_order_relaxed);
+  }
+
+  [[nodiscard]] inline uint32_t capacity() const noexcept { return capacity_ - 1; }
+
+  /**
+   * @brief Size of the raw image of the pool, depends on the capacity only
+   */
+  [[nodiscard]] inline uint32_t slots() const noexcept { return capacity_; }
+
+  [[nodiscard]] inline size_t imageSize() const noexcept {
+    return sizeof(freeTop_) + sizeof(nextAvailableIdx_) +
+           capacity_ * (sizeof(BookNode) + sizeof(BookOrderId));
+  }
+
+  void saveImage(uint8_t *dst) const {
+    dst = utils::writeRaw(dst, &freeTop_, sizeof(freeTop_));
+    dst = utils::writeRaw(dst, &nextAvailableIdx_, sizeof(nextAvailableIdx_));
+    dst = utils::writeRaw(dst, nodes_, capacity_ * sizeof(BookNode));
+    utils::writeRaw(dst, freeStack_, capacity_ * sizeof(BookOrderId));
+  }
+
+  /**
+   * @brief Restores the image saved by a pool of the same capacity
+   */
+  void loadImage(const uint8_t *src) {
+    src = utils::readRaw(src, &freeTop_, sizeof(freeTop_));
+    src = utils::readRaw(src, &nextAvailableIdx_, sizeof(nextAvailableIdx_));
+    src = utils::readRaw(src, nodes_, capacity_ * sizeof(BookNode));
+    utils::readRaw(src, freeStack_, capacity_ * sizeof(BookOrderId));
+    used_.store(nextAvailableIdx_ - 1 - freeTop_, std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Calls fn(idx, node) for every node holding a resting order, not for the hot path
+   */
+  template <typename Fn>
+  void forEachUsed(Fn &&fn) const {
+    Vector<bool> released(nextAvailableIdx_, false);
+    for (uint32_t i = 0; i < freeTop_; ++i) {
+      released[freeStack_[i].index()] = true;
+    }
+    for (uint32_t idx = 1; idx < nextAvailableIdx_; ++idx) {
+      if (!released[idx]) {
+        fn(idx, nodes_[idx]);
+      }
+    }
+  }
+
+  void clear() {
+    std::memset(nodes_, 0, capacity_ * sizeof(BookNode));
+    freeTop_ = 0;
+    nextAvailableIdx_ = 1;
+    used_.store(0, std::memory_order_relaxed);
+  }
+
+  NodePool(const NodePool &) = delete;
+  NodePool &operator=(const NodePool &) = delete;
+  NodePool(NodePool &&) = delete;
+  NodePool &operator=(NodePool &&) = delete;
+
+private:
+  const uint32_t capacity_;
+
+  BookNode *nodes_;
+  BookOrderId *freeStack_;
+  uint32_t freeTop_;
+  uint32_t nextAvailableIdx_;
+
+  ALIGN_CL AtomicUInt32 used_{0};
+};
+
+using NodePools = Vector<UPtr<NodePool>>;
+
+} // namespace hft::server
+
+#endif // HFT_SERVER_NODEPOOL_HPP
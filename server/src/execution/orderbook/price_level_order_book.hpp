@@ -6,13 +6,22 @@
 #ifndef HFT_SERVER_PRICELEVELORDERBOOK_HPP
 #define HFT_SERVER_PRICELEVELORDERBOOK_HPP
 
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#include <boost/unordered/unordered_flat_map.hpp>
+
 #include "bus/busable.hpp"
+#include "containers/hierarchical_bitmap.hpp"
+#include "container_types.hpp"
 #include "containers/huge_array.hpp"
 #include "gateway/internal_order.hpp"
 #include "gateway/internal_order_status.hpp"
 #include "id/slot_id.hpp"
 #include "id/slot_id_pool.hpp"
 #include "internal_error.hpp"
+#include "node_pool.hpp"
 #include "primitive_types.hpp"
 #include "ptr_types.hpp"
 #include "schema.hpp"
@@ -20,28 +29,30 @@
 namespace hft::server {
 
 /**
- * @brief Maintains pool of nodes with stack-based generation id recycling
+ * @brief Keeps order nodes in the NodePool shared with other books of the same worker
  * maintains array of combined price levels bids+asks,
+ * levels form a ring-indexed window of MAX_TICKS prices anchored at the ticker reference price,
+ * window re-centers when the market drifts, rare far-away orders are parked in a small overflow
  * provides internal id of order node to the gateway for fast modify/cancel
  * this way no need to maintain separate map of system oid -> internal book oid
- * optimized best price discovery via masks
- * @note for local testing only the last added order gets notification
+ * optimized best price discovery via hierarchical occupancy masks
+ * Market/Ioc/Fok orders never rest and touch the node pool only via matching,
+ * Fok is pre-checked against level volumes, PostOnly is rejected if it would cross,
+ * on add as well as on an amend to a crossing price
+ * volume changes of the window levels are collected as dirty levels and published on demand
+ * as conflated LevelUpdate events, levels of the overflow are not part of the depth feed
+ * the book is a few trivially copyable blocks, so it is saved and restored as a raw image
+ * book moves between workers via handOff/takeOver, nodes get new ids in the pool of the new owner,
+ * so cancel/modify with ids issued before the move are resolved by the system id
+ * modify reuses the node of the resting order: quantity decrease at the same price is done in place
+ * keeping queue priority, anything else is cancel-replace within a single pass
+ * every resting order touched by a sweep gets its fill reported,
+ * maker fills are packed into InternalFillBatch events per aggressor and price level
+ * prefetch is called ahead of add for a batch of orders, so level and node misses overlap
  */
 class PriceLevelOrderBook {
-  enum class Side : uint8_t { Buy, Sell };
-
-  struct Node {
-    uint32_t next;
-    uint32_t prev;
-
-    uint32_t price;
-    uint32_t qty;
-
-    BookOrderId localId;
-    SystemOrderId systemId;
-
-    Side side;
-  };
+  using Side = BookSide;
+  using Node = BookNode;
 
   struct PriceLevelSide {
     uint64_t volume;
@@ -59,12 +70,61 @@ class PriceLevelOrderBook {
     bool exists;
   };
 
-  static constexpr uint32_t MASK_SIZE = (MAX_TICKS / 64) + 1;
+  struct DirtyLevel {
+    Price price;
+    Side side;
+  };
+
+  /**
+   * @brief Orders resting outside of the price window, sorted worst to best
+   * so the best order is always at the back
+   */
+  struct OverflowSide {
+    uint32_t nodes[MAX_OVERFLOW_ORDERS];
+    uint32_t size;
+  };
+
+  using OccupancyMask = HierarchicalBitmap<MAX_TICKS>;
+
+  static_assert((MAX_TICKS & (MAX_TICKS - 1)) == 0, "Price window size must be a power of two");
+  static_assert(std::is_trivially_copyable_v<OccupancyMask> &&
+                std::is_trivially_copyable_v<OverflowSide>);
+
+  static constexpr Price NO_BID = 0;
+  static constexpr Price NO_ASK = std::numeric_limits<Price>::max();
+  static constexpr uint32_t DIRTY_LEVELS_RESERVE = 64;
+
+public:
+  static constexpr size_t IMAGE_SIZE =
+      HugeArray<PriceLevel, MAX_TICKS>::size_bytes() + 2 * sizeof(OccupancyMask) +
+      2 * sizeof(OverflowSide) + 4 * sizeof(Price) + sizeof(uint32_t);
 
 public:
-  PriceLevelOrderBook() : freeTop_{0}, nextAvailableIdx_{1}, minAsk_{MAX_TICKS}, maxBid_{0} {
-    std::memset(bidMask_, 0, sizeof(bidMask_));
-    std::memset(askMask_, 0, sizeof(askMask_));
+  explicit PriceLevelOrderBook(NodePool &pool, Price refPrice = MAX_TICKS / 2)
+      : nodePool_{&pool}, minAsk_{NO_ASK}, maxBid_{NO_BID},
+        initialBase_{refPrice > MAX_TICKS / 2 ? refPrice - MAX_TICKS / 2 : 0},
+        base_{initialBase_} {
+    bidOverflow_.size = 0;
+    askOverflow_.size = 0;
+    std::memset(dirtyBits_, 0, sizeof(dirtyBits_));
+    dirtyLevels_.reserve(DIRTY_LEVELS_RESERVE);
+  }
+
+  /**
+   * @brief Hints the lines the order is going to touch, the node for cancel/modify,
+   * the opposite best level for new orders and the level at the order price
+   */
+  inline void prefetch(CRef<InternalOrderEvent> ioe) const {
+    const auto &o = ioe.order;
+    if (ioe.action == OrderAction::Cancel || ioe.action == OrderAction::Modify) {
+      const uint32_t idx = o.bookOId.index();
+      if (nodePool_ != nullptr && idx != 0 && idx <= nodePool_->capacity()) {
+        PREFETCH(&(*nodePool_)[idx]);
+      }
+    } else {
+      PREFETCH(&levels_[toSlot(getSide(ioe.action) == Side::Buy ? minAsk_ : maxBid_)]);
+    }
+    PREFETCH(&levels_[toSlot(o.price)]);
   }
 
   bool add(CRef<InternalOrderEvent> ioe, BusableFor<InternalOrderStatus> auto &consumer) {
@@ -73,24 +133,158 @@ public:
       cancelOrder(ioe, consumer);
       return true;
     }
+    if (ioe.action == OrderAction::Modify) {
+      modifyOrder(ioe, consumer);
+      return true;
+    }
 
     auto &o = ioe.order;
     const Side side = getSide(ioe.action);
 
-    if (UNLIKELY(o.price >= MAX_TICKS)) [[unlikely]] {
-      LOG_ERROR_SYSTEM("Price out of bounds: {} {}", o.price, MAX_TICKS);
-      return false;
+    if (UNLIKELY(o.type == OrderType::PostOnly) && crossesBook(side, o.price)) {
+      LOG_DEBUG("PostOnly order would take liquidity {}", toString(o));
+      consumer.post(InternalOrderStatus{o.id, BookOrderId{}, 0, o.price, OrderState::Rejected});
+      return true;
+    }
+    if (UNLIKELY(o.type == OrderType::Fok) && !canFill(o.quantity, side, o.price)) {
+      LOG_DEBUG("Not enough volume to fill {}", toString(o));
+      consumer.post(InternalOrderStatus{o.id, BookOrderId{}, 0, o.price, OrderState::Cancelled});
+      return true;
     }
 
     uint32_t remainingQty = match(o, side, consumer);
 
-    if (remainingQty > 0) {
+    if (remainingQty == 0) {
+      consumer.post(
+          InternalOrderStatus{o.id, BookOrderId{}, o.quantity, fillPrice(o), OrderState::Full});
+    } else if (o.type == OrderType::Limit || o.type == OrderType::PostOnly) {
       restOrder(o, side, remainingQty, consumer);
     } else {
+      // immediate orders never rest, the remainder is cancelled in the same status
+      const Quantity fillQty = o.quantity - remainingQty;
       consumer.post(
-          InternalOrderStatus{o.id, BookOrderId{}, o.quantity, o.price, OrderState::Full});
+          InternalOrderStatus{o.id, BookOrderId{}, fillQty, fillPrice(o), OrderState::Cancelled});
+    }
+
+    return true;
+  }
+
+  [[nodiscard]] inline bool hasLevelUpdates() const { return !dirtyLevels_.empty(); }
+
+  /**
+   * @brief Publishes levels changed since the last call with their current volume,
+   * so a level touched many times in between costs a single update
+   */
+  void publishLevels(CRef<Ticker> ticker, BusableFor<LevelUpdate> auto &consumer) {
+    for (const auto &dirty : dirtyLevels_) {
+      const bool inside = inWindow(dirty.price);
+      if (inside) {
+        // slot of a level out of the window may be the one of a listed level in it
+        const uint32_t slot = toSlot(dirty.price);
+        dirtyBits_[(uint8_t)dirty.side][slot >> 6] &= ~(1ULL << (slot & 63));
+      }
+
+      const uint64_t volume = inside ? getLevel(dirty.side, dirty.price).volume : 0;
+      const auto action = (dirty.side == Side::Buy) ? OrderAction::Buy : OrderAction::Sell;
+      consumer.post(LevelUpdate{ticker, dirty.price, ++levelSeq_, volume, action});
+    }
+    dirtyLevels_.clear();
+  }
+
+  /**
+   * @brief Raw copy of the book into IMAGE_SIZE bytes, nodes are saved with the NodePool
+   */
+  void saveImage(uint8_t *dst) const {
+    dst = utils::writeRaw(dst, levels_.data(), levels_.size_bytes());
+    dst = utils::writeRaw(dst, &bidMask_, sizeof(bidMask_));
+    dst = utils::writeRaw(dst, &askMask_, sizeof(askMask_));
+    dst = utils::writeRaw(dst, &bidOverflow_, sizeof(bidOverflow_));
+    dst = utils::writeRaw(dst, &askOverflow_, sizeof(askOverflow_));
+    dst = utils::writeRaw(dst, &minAsk_, sizeof(minAsk_));
+    dst = utils::writeRaw(dst, &maxBid_, sizeof(maxBid_));
+    dst = utils::writeRaw(dst, &base_, sizeof(base_));
+    dst = utils::writeRaw(dst, &lastFillPrice_, sizeof(lastFillPrice_));
+    utils::writeRaw(dst, &levelSeq_, sizeof(levelSeq_));
+  }
+
+  /**
+   * @brief Restores the image, the NodePool is expected to be restored from the same snapshot
+   */
+  void loadImage(const uint8_t *src) {
+    src = utils::readRaw(src, levels_.data(), levels_.size_bytes());
+    src = utils::readRaw(src, &bidMask_, sizeof(bidMask_));
+    src = utils::readRaw(src, &askMask_, sizeof(askMask_));
+    src = utils::readRaw(src, &bidOverflow_, sizeof(bidOverflow_));
+    src = utils::readRaw(src, &askOverflow_, sizeof(askOverflow_));
+    src = utils::readRaw(src, &minAsk_, sizeof(minAsk_));
+    src = utils::readRaw(src, &maxBid_, sizeof(maxBid_));
+    src = utils::readRaw(src, &base_, sizeof(base_));
+    src = utils::readRaw(src, &lastFillPrice_, sizeof(lastFillPrice_));
+    utils::readRaw(src, &levelSeq_, sizeof(levelSeq_));
+    migrated_.clear();
+    dirtyLevels_.clear();
+    std::memset(dirtyBits_, 0, sizeof(dirtyBits_));
+  }
+
+  /**
+   * @brief Copies resting orders out and releases their nodes, called by the current owner
+   * levels keep old node indices until takeOver remaps them into the pool of the new owner
+   */
+  void handOff() {
+    handoff_.clear();
+    forEachNode([this](uint32_t idx) { handoff_.push_back((*nodePool_)[idx]); });
+    for (const auto &node : handoff_) {
+      releaseId(node.localId);
+    }
+    migrated_.clear();
+    nodePool_ = nullptr;
+  }
+
+  /**
+   * @brief Links orders of the handOff into the pool of the new owner in the same order,
+   * if the pool can not fit them all, they are cancelled
+   */
+  bool takeOver(NodePool &pool, BusableFor<InternalOrderStatus> auto &consumer) {
+    nodePool_ = &pool;
+    if (UNLIKELY(pool.capacity() - pool.used() < handoff_.size())) {
+      LOG_ERROR_SYSTEM("Not enough nodes to take over {} orders, cancelling", handoff_.size());
+      for (const auto &node : handoff_) {
+        consumer.post(InternalOrderStatus{node.systemId, BookOrderId{}, 0, 0,
+                                          OrderState::Cancelled});
+      }
+      handoff_.clear();
+      dropLevels();
+      return false;
     }
 
+    boost::unordered_flat_map<uint32_t, uint32_t> remap;
+    remap.reserve(handoff_.size());
+    migrated_.reserve(handoff_.size());
+    for (const auto &node : handoff_) {
+      const BookOrderId newId = acquireId();
+      remap.emplace(node.localId.index(), newId.index());
+      migrated_.insert_or_assign(node.systemId.raw(), newId);
+      Node &moved = pool[newId.index()];
+      moved = node;
+      moved.localId = newId;
+    }
+    const auto toNew = [&remap](uint32_t idx) { return idx == 0 ? 0 : remap.at(idx); };
+    for (const auto &node : handoff_) {
+      Node &moved = pool[remap.at(node.localId.index())];
+      moved.next = toNew(node.next);
+      moved.prev = toNew(node.prev);
+    }
+    forEachLevel([&toNew](PriceLevelSide &level) {
+      level.head = toNew(level.head);
+      level.tail = toNew(level.tail);
+    });
+    for (OverflowSide *overflow : {&bidOverflow_, &askOverflow_}) {
+      for (uint32_t i = 0; i < overflow->size; ++i) {
+        overflow->nodes[i] = toNew(overflow->nodes[i]);
+      }
+    }
+    LOG_INFO_SYSTEM("Took over {} orders", handoff_.size());
+    handoff_.clear();
     return true;
   }
 
@@ -99,15 +293,22 @@ public:
     consumer.post(InternalOrderStatus(ioe.order.id, BookOrderId{}, 0, 0, OrderState::Accepted));
   }
 
+  /**
+   * @brief Resets the book only, shared node pool is cleared by its owner
+   */
   void clear() {
-    std::memset(bidMask_, 0, sizeof(bidMask_));
-    std::memset(askMask_, 0, sizeof(askMask_));
-    freeTop_ = 0;
-    nextAvailableIdx_ = 1;
-    minAsk_ = MAX_TICKS;
-    maxBid_ = 0;
+    bidMask_.reset();
+    askMask_.reset();
+    bidOverflow_.size = 0;
+    askOverflow_.size = 0;
+    minAsk_ = NO_ASK;
+    maxBid_ = NO_BID;
+    base_ = initialBase_;
     levels_.clear();
-    nodePool_.clear();
+    dirtyLevels_.clear();
+    std::memset(dirtyBits_, 0, sizeof(dirtyBits_));
+    handoff_.clear();
+    migrated_.clear();
   }
 #endif
 
@@ -115,22 +316,28 @@ private:
   uint32_t match(CRef<InternalOrder> o, Side side, BusableFor<InternalOrderStatus> auto &consumer) {
     LOG_DEBUG("Match {}", toString(o));
     uint32_t remainingQty = o.quantity;
+    const Price limit = (o.type == OrderType::Market) ? marketLimit(side) : o.price;
+
+    InternalFillBatch fills;
+    fills.count = 0;
 
     while (remainingQty > 0) {
-      if (side == Side::Buy) {
-        if (minAsk_ > o.price)
-          break;
-      } else {
-        if (maxBid_ < o.price)
-          break;
+      auto bestPrice = (side == Side::Buy) ? getBestAsk(limit) : getBestBid(limit);
+
+      OverflowSide &overflow = (side == Side::Buy) ? askOverflow_ : bidOverflow_;
+      if (UNLIKELY(overflow.size != 0)) {
+        const Node &front = (*nodePool_)[overflow.nodes[overflow.size - 1]];
+        if (crosses(side, front.price, limit) &&
+            (!bestPrice.exists || isBetter(front.side, front.price, bestPrice.price))) {
+          remainingQty = matchOverflow(overflow, remainingQty, fills, consumer);
+          continue;
+        }
       }
 
-      auto bestPrice = (side == Side::Buy) ? getBestAsk(o.price) : getBestBid(o.price);
       if (!bestPrice.exists)
         break;
 
-      auto &pricePoint = levels_[bestPrice.price];
-      PriceLevelSide &level = (side == Side::Buy) ? pricePoint.ask : pricePoint.bid;
+      PriceLevelSide &level = getLevel(side == Side::Buy ? Side::Sell : Side::Buy, bestPrice.price);
 
       if (UNLIKELY(level.head == 0)) {
         LOG_DEBUG("Mask out of sync at price {}", bestPrice.price);
@@ -139,17 +346,19 @@ private:
       }
 
       while (level.head != 0 && remainingQty > 0) {
-        Node &restingNode = nodePool_[level.head];
+        Node &restingNode = (*nodePool_)[level.head];
         uint32_t fillQty = std::min(remainingQty, restingNode.qty);
 
         remainingQty -= fillQty;
         restingNode.qty -= fillQty;
         level.volume -= fillQty;
+        markDirty(restingNode.side, bestPrice.price);
+        addMakerFill(fills, restingNode, fillQty, bestPrice.price, consumer);
 
         if (restingNode.qty == 0) {
           level.head = restingNode.next;
           if (level.head != 0) {
-            nodePool_[level.head].prev = 0;
+            (*nodePool_)[level.head].prev = 0;
           } else {
             level.tail = 0;
             updateOccupancy(restingNode.side, bestPrice.price, false);
@@ -158,9 +367,103 @@ private:
         }
       }
     }
+    if (fills.count != 0) {
+      consumer.post(fills);
+    }
     return remainingQty;
   }
 
+  uint32_t matchOverflow(OverflowSide &overflow, uint32_t remainingQty, InternalFillBatch &fills,
+                         BusableFor<InternalOrderStatus> auto &consumer) {
+    Node &restingNode = (*nodePool_)[overflow.nodes[overflow.size - 1]];
+    const uint32_t fillQty = std::min(remainingQty, restingNode.qty);
+
+    restingNode.qty -= fillQty;
+    addMakerFill(fills, restingNode, fillQty, restingNode.price, consumer);
+    if (restingNode.qty == 0) {
+      --overflow.size;
+      releaseId(restingNode.localId);
+    }
+    return remainingQty - fillQty;
+  }
+
+  /**
+   * @brief Appends maker fill to the batch, batch is flushed when full or price level changes
+   * only the last maker of the sweep can be filled partially
+   */
+  inline void addMakerFill(InternalFillBatch &fills, CRef<Node> node, Quantity fillQty,
+                           Price price, BusableFor<InternalOrderStatus> auto &consumer) {
+    if (fills.count != 0 &&
+        (fills.fillPrice != price || fills.count == InternalFillBatch::CAPACITY)) {
+      consumer.post(fills);
+      fills.count = 0;
+    }
+    fills.fillPrice = price;
+    fills.fills[fills.count++] = {node.systemId, fillQty};
+    fills.lastPartial = node.qty != 0;
+    lastFillPrice_ = price;
+  }
+
+  /**
+   * @brief Market orders have no limit, so they are reported with the last fill price
+   */
+  inline Price fillPrice(CRef<InternalOrder> o) const {
+    return (o.type == OrderType::Market) ? lastFillPrice_ : o.price;
+  }
+
+  static inline Price marketLimit(Side side) { return (side == Side::Buy) ? NO_ASK - 1 : 0; }
+
+  /**
+   * @brief Whether aggressor at the given limit would take liquidity
+   */
+  inline bool crossesBook(Side side, Price limit) const {
+    const BestPrice best = (side == Side::Buy) ? getBestAsk(limit) : getBestBid(limit);
+    if (best.exists) {
+      return true;
+    }
+    const OverflowSide &overflow = (side == Side::Buy) ? askOverflow_ : bidOverflow_;
+    return overflow.size != 0 &&
+           crosses(side, (*nodePool_)[overflow.nodes[overflow.size - 1]].price, limit);
+  }
+
+  /**
+   * @brief Fok pre-check, sums volume of crossing levels and stops as soon as quantity is covered
+   */
+  bool canFill(Quantity qty, Side side, Price limit) const {
+    uint64_t available = 0;
+
+    const OverflowSide &overflow = (side == Side::Buy) ? askOverflow_ : bidOverflow_;
+    for (uint32_t i = overflow.size; i > 0 && available < qty; --i) {
+      const Node &node = (*nodePool_)[overflow.nodes[i - 1]];
+      if (!crosses(side, node.price, limit)) {
+        break;
+      }
+      available += node.qty;
+    }
+
+    if (side == Side::Buy) {
+      for (uint32_t rel = askMask_.findNext(0); rel != OccupancyMask::NPOS && available < qty;
+           rel = askMask_.findNext(rel + 1)) {
+        const Price price = base_ + rel;
+        if (price > limit) {
+          break;
+        }
+        available += levels_[toSlot(price)].ask.volume;
+      }
+    } else {
+      for (uint32_t rel = bidMask_.findPrev(MAX_TICKS - 1);
+           rel != OccupancyMask::NPOS && available < qty;
+           rel = (rel == 0) ? OccupancyMask::NPOS : bidMask_.findPrev(rel - 1)) {
+        const Price price = base_ + rel;
+        if (price < limit) {
+          break;
+        }
+        available += levels_[toSlot(price)].bid.volume;
+      }
+    }
+    return available >= qty;
+  }
+
   void restOrder(CRef<InternalOrder> o, Side side, uint32_t qty,
                  BusableFor<InternalOrderStatus> auto &consumer) {
     LOG_DEBUG("restOrder {}", toString(o));
@@ -171,27 +474,19 @@ private:
     }
 
     uint32_t idx = localId.index();
-    Node &node = nodePool_[idx];
+    Node &node = (*nodePool_)[idx];
     node.localId = localId;
     node.systemId = o.id;
     node.price = o.price;
     node.qty = qty;
     node.side = side;
-    node.next = 0;
-
-    auto &pricePoint = levels_[node.price];
-    PriceLevelSide &level = (side == Side::Buy) ? pricePoint.bid : pricePoint.ask;
-
-    node.prev = level.tail;
-
-    if (level.tail != 0) {
-      nodePool_[level.tail].next = idx;
-    } else {
-      level.head = idx;
-      updateOccupancy(side, node.price, true);
+    node.type = o.type;
+    if (UNLIKELY(!placeNode(idx))) {
+      LOG_ERROR_SYSTEM("OrderBook overflow is full, rejecting {}", toString(o));
+      releaseId(localId);
+      consumer.post(InternalOrderStatus{o.id, BookOrderId{}, 0, 0, OrderState::Rejected});
+      return;
     }
-    level.tail = idx;
-    level.volume += node.qty;
 
     const uint32_t fillTtl = o.quantity - qty;
     const auto state = (fillTtl == 0) ? OrderState::Accepted : OrderState::Partial;
@@ -201,148 +496,435 @@ private:
 
   void cancelOrder(CRef<InternalOrderEvent> ioe, BusableFor<InternalOrderStatus> auto &consumer) {
     auto &o = ioe.order;
-    uint32_t idx = o.bookOId.index();
-    Node &node = nodePool_[idx];
-
-    if (UNLIKELY(node.localId != o.bookOId)) {
+    const uint32_t idx = findNode(o);
+    if (UNLIKELY(idx == 0)) {
       LOG_ERROR("Failed to cancel order {}, already closed", toString(ioe));
       consumer.post(InternalOrderStatus{o.id, o.bookOId, 0, 0, OrderState::Rejected});
       return;
     }
+    Node &node = (*nodePool_)[idx];
+
+    detachNode(idx);
+
+    consumer.post(InternalOrderStatus{o.id, node.localId, 0, 0, OrderState::Cancelled});
+    releaseId(node.localId);
+  }
+
+  void modifyOrder(CRef<InternalOrderEvent> ioe, BusableFor<InternalOrderStatus> auto &consumer) {
+    auto &o = ioe.order;
+    if (o.quantity == 0) {
+      cancelOrder(ioe, consumer);
+      return;
+    }
+    const uint32_t idx = findNode(o);
+    if (UNLIKELY(idx == 0)) {
+      LOG_ERROR("Failed to modify order {}, already closed", toString(ioe));
+      consumer.post(InternalOrderStatus{o.id, o.bookOId, 0, 0, OrderState::Rejected});
+      return;
+    }
+    Node &node = (*nodePool_)[idx];
+
+    if (o.price == node.price && o.quantity <= node.qty) {
+      if (LIKELY(inWindow(node.price))) {
+        getLevel(node.side, node.price).volume -= node.qty - o.quantity;
+        markDirty(node.side, node.price);
+      }
+      node.qty = o.quantity;
+      consumer.post(InternalOrderStatus{o.id, node.localId, 0, o.price, OrderState::Accepted});
+      return;
+    }
+
+    detachNode(idx);
+    if (UNLIKELY(node.type == OrderType::PostOnly) && crossesBook(node.side, o.price)) {
+      // rejected status closes the order, so it leaves the book the way it does on add
+      LOG_DEBUG("PostOnly amend would take liquidity {}", toString(o));
+      consumer.post(InternalOrderStatus{o.id, BookOrderId{}, 0, o.price, OrderState::Rejected});
+      releaseId(node.localId);
+      return;
+    }
+    const uint32_t remainingQty = match(o, node.side, consumer);
+    if (remainingQty == 0) {
+      consumer.post(
+          InternalOrderStatus{o.id, BookOrderId{}, o.quantity, o.price, OrderState::Full});
+      releaseId(node.localId);
+      return;
+    }
+
+    node.price = o.price;
+    node.qty = remainingQty;
+    if (UNLIKELY(!placeNode(idx))) {
+      LOG_ERROR_SYSTEM("OrderBook overflow is full, rejecting {}", toString(o));
+      consumer.post(InternalOrderStatus{o.id, node.localId, 0, 0, OrderState::Rejected});
+      releaseId(node.localId);
+      return;
+    }
+
+    const uint32_t fillTtl = o.quantity - remainingQty;
+    const auto state = (fillTtl == 0) ? OrderState::Accepted : OrderState::Partial;
+
+    consumer.post(InternalOrderStatus{o.id, node.localId, fillTtl, o.price, state});
+  }
+
+  /**
+   * @brief Index of the resting node of the order, 0 if it is closed
+   * ids issued before the book moved to another worker are resolved by the system id
+   */
+  inline uint32_t findNode(CRef<InternalOrder> o) const {
+    const uint32_t idx = o.bookOId.index();
+    const Node &node = (*nodePool_)[idx];
+    if (LIKELY(node.localId == o.bookOId && node.systemId == o.id)) {
+      return idx;
+    }
+    if (migrated_.empty()) {
+      return 0;
+    }
+    const auto iter = migrated_.find(o.id.raw());
+    if (iter == migrated_.end()) {
+      return 0;
+    }
+    const Node &moved = (*nodePool_)[iter->second.index()];
+    return (moved.localId == iter->second && moved.systemId == o.id) ? iter->second.index() : 0;
+  }
+
+  inline PriceLevelSide &getLevel(Side side, Price price) {
+    auto &pricePoint = levels_[toSlot(price)];
+    return (side == Side::Buy) ? pricePoint.bid : pricePoint.ask;
+  }
+
+  /**
+   * @brief Records the level for the next publishLevels, once per level until then
+   */
+  inline void markDirty(Side side, Price price) {
+    const uint32_t slot = toSlot(price);
+    uint64_t &word = dirtyBits_[(uint8_t)side][slot >> 6];
+    const uint64_t bit = 1ULL << (slot & 63);
+    if ((word & bit) == 0) {
+      word |= bit;
+      dirtyLevels_.push_back(DirtyLevel{price, side});
+    }
+  }
+
+  inline bool inWindow(Price price) const { return price - base_ < MAX_TICKS; }
+  inline uint32_t toSlot(Price price) const { return price & (MAX_TICKS - 1); }
+  inline uint32_t toRel(Price price) const { return price - base_; }
+
+  /**
+   * @brief Whether resting price a is more aggressive than b
+   */
+  static inline bool isBetter(Side side, Price a, Price b) {
+    return (side == Side::Buy) ? a > b : a < b;
+  }
+
+  /**
+   * @brief Whether resting price crosses the limit of aggressor
+   */
+  static inline bool crosses(Side aggressor, Price resting, Price limit) {
+    return (aggressor == Side::Buy) ? resting <= limit : resting >= limit;
+  }
+
+  /**
+   * @brief Links node into the window, re-centering the window around its price if needed,
+   * parks it in the overflow if occupied levels do not allow to re-center
+   */
+  inline bool placeNode(uint32_t idx) {
+    const Node &node = (*nodePool_)[idx];
+    if (LIKELY(inWindow(node.price)) || recenter(node.price)) {
+      linkNode(idx);
+      return true;
+    }
+    return overflowInsert(idx);
+  }
+
+  inline void detachNode(uint32_t idx) {
+    const Node &node = (*nodePool_)[idx];
+    if (LIKELY(inWindow(node.price))) {
+      unlinkNode(node);
+    } else {
+      overflowErase(idx);
+    }
+  }
+
+  /**
+   * @brief Appends node to the tail of its price level
+   */
+  inline void linkNode(uint32_t idx) {
+    Node &node = (*nodePool_)[idx];
+    PriceLevelSide &level = getLevel(node.side, node.price);
+
+    node.next = 0;
+    node.prev = level.tail;
+
+    if (level.tail != 0) {
+      (*nodePool_)[level.tail].next = idx;
+    } else {
+      level.head = idx;
+      updateOccupancy(node.side, node.price, true);
+    }
+    level.tail = idx;
+    level.volume += node.qty;
+    markDirty(node.side, node.price);
+  }
 
-    auto &pricePoint = levels_[node.price];
-    PriceLevelSide &level = (node.side == Side::Buy) ? pricePoint.bid : pricePoint.ask;
+  inline void unlinkNode(CRef<Node> node) {
+    PriceLevelSide &level = getLevel(node.side, node.price);
 
     if (node.prev != 0) {
-      nodePool_[node.prev].next = node.next;
+      (*nodePool_)[node.prev].next = node.next;
     } else {
       level.head = node.next;
     }
 
     if (node.next != 0) {
-      nodePool_[node.next].prev = node.prev;
+      (*nodePool_)[node.next].prev = node.prev;
     } else {
       level.tail = node.prev;
     }
 
     level.volume -= node.qty;
+    markDirty(node.side, node.price);
 
     if (level.volume == 0) {
       updateOccupancy(node.side, node.price, false);
     }
-
-    consumer.post(InternalOrderStatus{o.id, o.bookOId, 0, 0, OrderState::Cancelled});
-    releaseId(node.localId);
   }
 
-  inline void updateOccupancy(Side side, uint32_t priceIdx, bool active) {
-    uint64_t *mask = (side == Side::Buy) ? bidMask_ : askMask_;
-    const uint32_t wordIdx = priceIdx >> 6;
-    const uint64_t bit = 1ULL << (priceIdx & 63);
+  inline void updateOccupancy(Side side, Price price, bool active) {
+    OccupancyMask &mask = (side == Side::Buy) ? bidMask_ : askMask_;
 
-    auto &level = levels_[priceIdx];
+    auto &level = levels_[toSlot(price)];
     uint64_t volume = (side == Side::Buy) ? level.bid.volume : level.ask.volume;
 
     if (active) {
-      mask[wordIdx] |= bit;
+      mask.set(toRel(price));
       if (side == Side::Buy) {
-        maxBid_ = std::max(maxBid_, priceIdx);
+        maxBid_ = std::max(maxBid_, price);
       } else {
-        minAsk_ = std::min(minAsk_, priceIdx);
+        minAsk_ = std::min(minAsk_, price);
       }
     } else {
       if (volume == 0) {
-        mask[wordIdx] &= ~bit;
+        mask.clear(toRel(price));
       }
-      if (side == Side::Buy && priceIdx == maxBid_) {
-        findNewMaxBid(wordIdx);
-      } else if (side == Side::Sell && priceIdx == minAsk_) {
-        findNewMinAsk(wordIdx);
+      if (side == Side::Buy && price == maxBid_) {
+        findNewMaxBid(toRel(price));
+      } else if (side == Side::Sell && price == minAsk_) {
+        findNewMinAsk(toRel(price));
       }
     }
   }
 
-  void findNewMaxBid(uint32_t startWord) {
-    for (int i = static_cast<int>(startWord); i >= 0; --i) {
-      if (bidMask_[i] != 0) {
-        maxBid_ = (i << 6) + (63 - __builtin_clzll(bidMask_[i]));
-        return;
-      }
+  inline void findNewMaxBid(uint32_t fromRel) {
+    const uint32_t rel = bidMask_.findPrev(fromRel);
+    maxBid_ = (rel == OccupancyMask::NPOS) ? NO_BID : base_ + rel;
+  }
+
+  inline void findNewMinAsk(uint32_t fromRel) {
+    const uint32_t rel = askMask_.findNext(fromRel);
+    minAsk_ = (rel == OccupancyMask::NPOS) ? NO_ASK : base_ + rel;
+  }
+
+  BestPrice getBestAsk(Price limitPrice) const {
+    return {minAsk_, minAsk_ != NO_ASK && minAsk_ <= limitPrice};
+  }
+
+  BestPrice getBestBid(Price limitPrice) const {
+    return {maxBid_, maxBid_ != NO_BID && maxBid_ >= limitPrice};
+  }
+
+  /**
+   * @brief Moves the window so it covers all occupied levels and the given price
+   * levels are ring-indexed so nothing is moved except for the occupancy bits,
+   * overflow orders that got into the new window are linked into their levels
+   */
+  bool recenter(Price price) {
+    Price lo = price;
+    Price hi = price;
+    if (!bidMask_.empty()) {
+      lo = std::min(lo, base_ + bidMask_.findNext(0));
+      hi = std::max(hi, maxBid_);
     }
-    maxBid_ = 0;
+    if (!askMask_.empty()) {
+      lo = std::min(lo, minAsk_);
+      hi = std::max(hi, base_ + askMask_.findPrev(MAX_TICKS - 1));
+    }
+    if (hi - lo >= MAX_TICKS) {
+      return false;
+    }
+
+    const Price mid = lo + (hi - lo) / 2;
+    Price newBase = mid > MAX_TICKS / 2 ? mid - MAX_TICKS / 2 : 0;
+    if (hi >= MAX_TICKS) {
+      newBase = std::max(newBase, hi - MAX_TICKS + 1);
+    }
+    LOG_DEBUG("Re-center price window {} => {}", base_, newBase);
+
+    rebase(bidMask_, newBase);
+    rebase(askMask_, newBase);
+    base_ = newBase;
+    rebuildDirtyBits();
+
+    absorbOverflow(bidOverflow_);
+    absorbOverflow(askOverflow_);
+    return true;
   }
 
-  void findNewMinAsk(uint32_t startWord) {
-    for (uint32_t i = startWord; i < MASK_SIZE; ++i) {
-      if (askMask_[i] != 0) {
-        minAsk_ = (i << 6) + __builtin_ctzll(askMask_[i]);
-        return;
+  /**
+   * @brief Slots map to other prices after a rebase, bits are set again for listed levels
+   * in the new window, levels that left it stay listed with no bit, they publish empty
+   */
+  void rebuildDirtyBits() {
+    std::memset(dirtyBits_, 0, sizeof(dirtyBits_));
+    size_t kept = 0;
+    for (const auto &dirty : dirtyLevels_) {
+      if (inWindow(dirty.price)) {
+        const uint32_t slot = toSlot(dirty.price);
+        uint64_t &word = dirtyBits_[(uint8_t)dirty.side][slot >> 6];
+        const uint64_t bit = 1ULL << (slot & 63);
+        if ((word & bit) != 0) {
+          continue; // listed already
+        }
+        word |= bit;
       }
+      dirtyLevels_[kept++] = dirty;
     }
-    minAsk_ = MAX_TICKS;
+    dirtyLevels_.erase(dirtyLevels_.begin() + kept, dirtyLevels_.end());
   }
 
-  BestPrice getBestAsk(Price limitPrice) const {
-    const uint32_t startWord = minAsk_ >> 6;
-    const uint32_t maxWord = limitPrice >> 6;
-    for (uint32_t i = startWord; i <= maxWord; ++i) {
-      if (askMask_[i] != 0) {
-        Price p = (i << 6) + __builtin_ctzll(askMask_[i]);
-        if (p <= limitPrice && levels_[p].ask.head != 0) {
-          return {p, true};
-        }
-        break;
+  void rebase(OccupancyMask &mask, Price newBase) {
+    OccupancyMask shifted;
+    for (uint32_t rel = mask.findNext(0); rel != OccupancyMask::NPOS;
+         rel = mask.findNext(rel + 1)) {
+      shifted.set(base_ + rel - newBase);
+    }
+    mask = shifted;
+  }
+
+  void absorbOverflow(OverflowSide &overflow) {
+    // back to front so orders at the same price are linked in time priority
+    for (uint32_t i = overflow.size; i > 0; --i) {
+      if (inWindow((*nodePool_)[overflow.nodes[i - 1]].price)) {
+        linkNode(overflow.nodes[i - 1]);
+      }
+    }
+    uint32_t kept = 0;
+    for (uint32_t i = 0; i < overflow.size; ++i) {
+      if (!inWindow((*nodePool_)[overflow.nodes[i]].price)) {
+        overflow.nodes[kept++] = overflow.nodes[i];
       }
     }
-    return {0, false};
+    overflow.size = kept;
   }
 
-  BestPrice getBestBid(Price limitPrice) const {
-    const int startWord = static_cast<int>(maxBid_ >> 6);
-    const int minWord = static_cast<int>(limitPrice >> 6);
-    for (int i = startWord; i >= minWord; --i) {
-      if (bidMask_[i] != 0) {
-        Price p = (i << 6) + (63 - __builtin_clzll(bidMask_[i]));
-        if (p >= limitPrice && levels_[p].bid.head != 0) {
-          return {p, true};
-        }
-        break;
+  bool overflowInsert(uint32_t idx) {
+    const Node &node = (*nodePool_)[idx];
+    OverflowSide &overflow = (node.side == Side::Buy) ? bidOverflow_ : askOverflow_;
+    if (overflow.size == MAX_OVERFLOW_ORDERS) {
+      return false;
+    }
+    LOG_WARN("Price {} is out of window [{}, {}), parking in overflow", node.price, base_,
+             base_ + MAX_TICKS);
+
+    uint32_t pos = 0;
+    while (pos < overflow.size &&
+           isBetter(node.side, node.price, (*nodePool_)[overflow.nodes[pos]].price)) {
+      ++pos;
+    }
+    std::memmove(&overflow.nodes[pos + 1], &overflow.nodes[pos],
+                 (overflow.size - pos) * sizeof(uint32_t));
+    overflow.nodes[pos] = idx;
+    ++overflow.size;
+    return true;
+  }
+
+  void overflowErase(uint32_t idx) {
+    const Node &node = (*nodePool_)[idx];
+    OverflowSide &overflow = (node.side == Side::Buy) ? bidOverflow_ : askOverflow_;
+    for (uint32_t pos = 0; pos < overflow.size; ++pos) {
+      if (overflow.nodes[pos] == idx) {
+        std::memmove(&overflow.nodes[pos], &overflow.nodes[pos + 1],
+                     (overflow.size - pos - 1) * sizeof(uint32_t));
+        --overflow.size;
+        return;
       }
     }
-    return {0, false};
+    LOG_ERROR("Node {} not found in overflow", idx);
   }
 
-  inline auto acquireId() -> BookOrderId {
-    if (LIKELY(freeTop_ > 0)) {
-      return freeStack_[--freeTop_];
+  template <typename Fn>
+  void forEachLevel(Fn &&fn) {
+    for (OccupancyMask *mask : {&bidMask_, &askMask_}) {
+      const Side side = (mask == &bidMask_) ? Side::Buy : Side::Sell;
+      for (uint32_t rel = mask->findNext(0); rel != OccupancyMask::NPOS;
+           rel = mask->findNext(rel + 1)) {
+        fn(getLevel(side, base_ + rel));
+      }
     }
-    if (UNLIKELY(nextAvailableIdx_ >= MAX_BOOK_ORDERS)) {
-      return BookOrderId{};
+  }
+
+  /**
+   * @brief Visits resting nodes, levels in time priority, then the overflow
+   */
+  template <typename Fn>
+  void forEachNode(Fn &&fn) {
+    forEachLevel([this, &fn](PriceLevelSide &level) {
+      for (uint32_t idx = level.head; idx != 0; idx = (*nodePool_)[idx].next) {
+        fn(idx);
+      }
+    });
+    for (const OverflowSide *overflow : {&bidOverflow_, &askOverflow_}) {
+      for (uint32_t i = 0; i < overflow->size; ++i) {
+        fn(overflow->nodes[i]);
+      }
     }
-    return BookOrderId::make(nextAvailableIdx_++, 1);
   }
 
-  inline void releaseId(BookOrderId idx) {
-    idx.nextGen();
-    freeStack_[freeTop_++] = idx;
+  void dropLevels() {
+    for (OccupancyMask *mask : {&bidMask_, &askMask_}) {
+      const Side side = (mask == &bidMask_) ? Side::Buy : Side::Sell;
+      for (uint32_t rel = mask->findNext(0); rel != OccupancyMask::NPOS;
+           rel = mask->findNext(rel + 1)) {
+        getLevel(side, base_ + rel) = PriceLevelSide{};
+        markDirty(side, base_ + rel);
+      }
+      mask->reset();
+    }
+    bidOverflow_.size = 0;
+    askOverflow_.size = 0;
+    minAsk_ = NO_ASK;
+    maxBid_ = NO_BID;
   }
 
+  inline auto acquireId() -> BookOrderId { return nodePool_->acquire(); }
+
+  inline void releaseId(BookOrderId idx) { nodePool_->release(idx); }
+
   inline Side getSide(OrderAction action) const {
     return action == OrderAction::Buy ? Side::Buy : Side::Sell;
   }
 
 private:
-  HugeArray<Node, MAX_BOOK_ORDERS> nodePool_;
+  NodePool *nodePool_;
   HugeArray<PriceLevel, MAX_TICKS> levels_;
 
-  ALIGN_CL uint64_t bidMask_[MASK_SIZE];
-  ALIGN_CL uint64_t askMask_[MASK_SIZE];
+  OccupancyMask bidMask_;
+  OccupancyMask askMask_;
+
+  OverflowSide bidOverflow_;
+  OverflowSide askOverflow_;
 
-  HugeArray<BookOrderId, MAX_BOOK_ORDERS> freeStack_;
-  uint32_t freeTop_;
-  uint32_t nextAvailableIdx_;
   Price minAsk_;
   Price maxBid_;
+
+  Price initialBase_;
+  Price base_;
+  Price lastFillPrice_{0};
+
+  Vector<DirtyLevel> dirtyLevels_;
+  uint64_t dirtyBits_[2][(MAX_TICKS + 63) / 64];
+  uint32_t levelSeq_{0};
+
+  Vector<Node> handoff_;
+  boost::unordered_flat_map<uint32_t, BookOrderId> migrated_;
 };
 } // namespace hft::server
 
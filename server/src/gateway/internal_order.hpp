@@ -6,6 +6,7 @@
 #ifndef HFT_SERVER_INTERNALORDER_HPP
 #define HFT_SERVER_INTERNALORDER_HPP
 
+#include "container_types.hpp"
 #include "domain_types.hpp"
 #include "id/slot_id.hpp"
 #include "primitive_types.hpp"
@@ -23,6 +24,7 @@ struct InternalOrder {
   BookOrderId bookOId;
   Quantity quantity;
   Price price;
+  OrderType type;
 
   inline void partialFill(Quantity fill) { quantity = quantity < fill ? 0 : quantity - fill; }
   inline bool isFilled() const { return quantity == 0; }
@@ -30,24 +32,44 @@ struct InternalOrder {
 
 /**
  * @brief event to route IntOrder to OrderBook and store only the needed data internally
+ * ticker is resolved to its dense index by the gateway, so routing needs no lookup
  */
 struct InternalOrderEvent {
   InternalOrder order;
   mutable const TickerData *data{nullptr};
-  Ticker ticker;
+  TickerIdx tickerIdx;
   OrderAction action;
+
+  /**
+   * @brief Marker that tells the current owner to hand the book over, carries no order
+   */
+  static auto makeHandoff(const TickerData *data, TickerIdx tickerIdx) -> InternalOrderEvent {
+    return InternalOrderEvent{InternalOrder{}, data, tickerIdx, OrderAction::Cancel};
+  }
+
+  [[nodiscard]] inline bool isHandoff() const { return !order.id; }
+};
+
+/**
+ * @brief Events of one order batch, routed to the workers together
+ */
+struct InternalOrderBurst {
+  Span<const InternalOrderEvent> events;
 };
 
 } // namespace hft::server
 
 namespace hft {
 inline String toString(const server::InternalOrder &event) {
-  return std::format("InternalOrder {} {} {} {}", event.id.raw(), event.bookOId.raw(),
-                     event.quantity, event.price);
+  return std::format("InternalOrder {} {} {} {} {}", event.id.raw(), event.bookOId.raw(),
+                     event.quantity, event.price, toString(event.type));
 }
 inline String toString(const server::InternalOrderEvent &e) {
   return std::format("InternalOrderEvent {} {} {}", toString(e.order), toString(e.action),
-                     toString(e.ticker));
+                     e.tickerIdx);
+}
+inline String toString(const server::InternalOrderBurst &burst) {
+  return std::format("InternalOrderBurst {}", burst.events.size());
 }
 } // namespace hft
 
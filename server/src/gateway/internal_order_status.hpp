@@ -6,6 +6,8 @@
 #ifndef HFT_SERVER_INTERNALORDERSTATUS_HPP
 #define HFT_SERVER_INTERNALORDERSTATUS_HPP
 
+#include <variant>
+
 #include "domain_types.hpp"
 #include "primitive_types.hpp"
 #include "schema.hpp"
@@ -20,6 +22,29 @@ struct InternalOrderStatus {
   Price fillPrice;
   OrderState state;
 };
+
+/**
+ * @brief Fills of resting orders hit by a single aggressor at a single price level
+ * packed to fit one queue slot, every maker but the last one is filled fully
+ */
+struct InternalFillBatch {
+  static constexpr uint8_t CAPACITY = 5;
+
+  struct MakerFill {
+    SystemOrderId id;
+    Quantity fillQty;
+  };
+
+  Price fillPrice;
+  uint8_t count;
+  bool lastPartial;
+  MakerFill fills[CAPACITY];
+};
+
+/**
+ * @brief Everything workers send to the gateway goes through a single queue to keep the order
+ */
+using InternalGatewayEvent = std::variant<InternalOrderStatus, InternalFillBatch>;
 } // namespace hft::server
 
 namespace hft {
@@ -27,6 +52,16 @@ inline String toString(const server::InternalOrderStatus &event) {
   return std::format("InternalOrderStatus {} {} {} {} {}", event.id.raw(), event.bookOId.raw(),
                      event.fillQty, event.fillPrice, toString(event.state));
 }
+inline String toString(const server::InternalFillBatch &event) {
+  String result = std::format("InternalFillBatch {} {}", event.fillPrice, event.count);
+  for (uint8_t idx = 0; idx < event.count; ++idx) {
+    result += std::format(" {}:{}", event.fills[idx].id.raw(), event.fills[idx].fillQty);
+  }
+  return event.lastPartial ? result + " Partial" : result;
+}
+inline String toString(const server::InternalGatewayEvent &event) {
+  return std::visit([](const auto &e) { return toString(e); }, event);
+}
 } // namespace hft
 
 #endif // HFT_SERVER_INTERNALORDERSTATUS_HPP
\ No newline at end of file
@@ -8,8 +8,11 @@
 
 #include "bus/bus_hub.hpp"
 #include "config/server_config.hpp"
+#include "container_types.hpp"
 #include "containers/huge_array.hpp"
 #include "domain/server_order_messages.hpp"
+#include "events.hpp"
+#include "execution/market_data.hpp"
 #include "id/slot_id_pool.hpp"
 #include "internal_order.hpp"
 #include "internal_order_status.hpp"
@@ -18,6 +21,8 @@
 #include "primitive_types.hpp"
 #include "ptr_types.hpp"
 #include "runner/lfq_runner.hpp"
+#include "utils/spin_wait.hpp"
+#include "storage/book_snapshot.hpp"
 #include "traits.hpp"
 #include "utils/handler.hpp"
 
@@ -40,15 +45,60 @@ namespace hft::server {
  * This only needs atomic record state, other variables are never changed after creation, except for
  * BookOrderId, which is published once by the gateway thread,
  * and not accessed by the network thread untill state becomes Accepted
+ * Worker statuses and maker fill batches share one queue, so fills of a resting order
+ * are never reordered with its cancel/modify statuses
+ * Ticker of a new order is resolved to its TickerIdx here once and kept in the record,
+ * cancel/modify reuse it, so nothing downstream looks tickers up
+ * With extra network cores orders come from several network threads, each of them writes
+ * into its own ingress lane and the gateway thread processes them, so records and worker queues
+ * still see a single producer and a network thread only ever waits for room in its own lane.
+ * Gateway thread then waits for full worker queues itself, ingress is drained in bounded chunks
+ * between the status batches, so statuses keep flowing while the workers catch up
+ * Order batch is processed in one go, its internal events are collected and handed
+ * to the coordinator as one burst
+ * Statuses and fills are matched against the record by the full system id, so a stale one
+ * never reports to the wrong client or closes a reused record
+ * Records of orders restored from the book snapshot are rebuilt before start
  */
 class OrderGateway {
   using SelfT = OrderGateway;
 
+  static constexpr size_t INGRESS_SLOTS = 8192;
+  static constexpr size_t INGRESS_CHUNK = 64;
+  static constexpr size_t INGRESS_DRAIN_LIMIT = 1024;
+
+  /**
+   * @brief Order on its way from a network thread to the gateway thread,
+   * orders of a batch are written back to back, the last one ends the burst
+   */
+  struct IngressOrder {
+    ServerOrder order;
+    bool batched;
+    bool last;
+  };
+  using IngressLane = SequencedSPSC<INGRESS_SLOTS>;
+
+  static_assert(sizeof(InternalGatewayEvent) <= SequencedSPSC<>::MAX_DATA_SIZE);
+  static_assert(sizeof(IngressOrder) <= IngressLane::MAX_DATA_SIZE);
+
 public:
-  explicit OrderGateway(Context &ctx)
-      : ctx_{ctx},
-        worker_{*this, ctx_.bus, ctx_.stopToken, "gateway", ctx.config.coreGateway, true} {
+  OrderGateway(Context &ctx, CRef<MarketData> data)
+      : ctx_{ctx}, data_{data},
+        worker_{*this, ctx_.bus, ctx_.stopToken, "gateway", ctx.config.coreGateway},
+        sharedIngress_{!ctx.config.coresNetwork.empty()}, instance_{nextInstance()} {
+    burst_.reserve(ORDER_BATCH_CAPACITY);
+    if (sharedIngress_) {
+      // one lane per network thread
+      for (size_t idx = 0; idx <= ctx.config.coresNetwork.size(); ++idx) {
+        lanes_.emplace_back(std::make_unique<IngressLane>());
+      }
+    }
     ctx_.bus.subscribe(CRefHandler<ServerOrder>::bind<SelfT, &SelfT::post>(this));
+    ctx_.bus.subscribe(CRefHandler<ServerOrderBatch>::bind<SelfT, &SelfT::post>(this));
+    ctx_.bus.subscribe(
+        CRefHandler<InternalOrderStatus>::bind<SelfT, &SelfT::enqueue<InternalOrderStatus>>(this));
+    ctx_.bus.subscribe(
+        CRefHandler<InternalFillBatch>::bind<SelfT, &SelfT::enqueue<InternalFillBatch>>(this));
   }
 
   ~OrderGateway() { LOG_DEBUG_SYSTEM("~OrderGateway"); }
@@ -64,13 +114,47 @@ public:
     worker_.stop();
   };
 
+  /**
+   * @brief Rebuilds records of the orders restored into the books and takes their ids
+   * out of the pool, called before start
+   */
+  void restore(CRef<NodePools> pools, CRef<BookSnapshot> snapshot) {
+    Vector<SystemOrderId> ids;
+    for (ThreadId worker = 0; worker < pools.size(); ++worker) {
+      pools[worker]->forEachUsed([&](uint32_t idx, CRef<BookNode> node) {
+        const auto &image = snapshot.record(worker, idx);
+        OrderRecord &r = recordMap_[node.systemId.index()];
+        r.externalOId = image.externalOId;
+        r.systemOId = node.systemId;
+        r.bookOId = node.localId;
+        r.clientId = image.clientId;
+        r.tickerIdx = image.tickerIdx;
+        r.setState(RecordState::Accepted);
+        ids.push_back(node.systemId);
+      });
+    }
+    idPool_.reserve(ids);
+    LOG_INFO_SYSTEM("Restored {} order records", ids.size());
+  }
+
+  auto records() const -> CRef<OrderRecords> { return recordMap_; }
+
+  void post(CRef<InternalGatewayEvent> event) {
+    std::visit([this](const auto &e) { post(e); }, event);
+  }
+
   void post(CRef<InternalOrderStatus> s) {
     LOG_DEBUG("{}", toString(s));
     if (closed_.load(std::memory_order_acquire)) {
       LOG_WARN_SYSTEM("OrderGateway is already stopped");
       return;
     }
-    auto &r = recordMap_[s.id.index()];
+    auto *record = openRecord(s.id);
+    if (UNLIKELY(record == nullptr)) {
+      LOG_ERROR_SYSTEM("No open record, dropping {}", toString(s));
+      return;
+    }
+    auto &r = *record;
     ctx_.bus.post(ServerOrderStatus{
         r.clientId, {r.externalOId, r.systemOId.raw(), s.fillQty, s.fillPrice, s.state}});
 
@@ -89,8 +173,164 @@ public:
     }
   }
 
+  /**
+   * @brief Gateway thread, processes orders the network threads left in their lanes,
+   * a batch that is only partly written yet is waited for, so bursts of the lanes never mix
+   */
+  bool poll() {
+    size_t drained = 0;
+    for (auto &lane : lanes_) {
+      drained += drain(*lane);
+    }
+    return drained != 0;
+  }
+
+  void post(CRef<InternalFillBatch> batch) {
+    LOG_DEBUG("{}", toString(batch));
+    if (closed_.load(std::memory_order_acquire)) {
+      LOG_WARN_SYSTEM("OrderGateway is already stopped");
+      return;
+    }
+    for (uint8_t idx = 0; idx < batch.count; ++idx) {
+      const auto &fill = batch.fills[idx];
+      const bool partial = batch.lastPartial && idx + 1 == batch.count;
+
+      auto *record = openRecord(fill.id);
+      if (UNLIKELY(record == nullptr)) {
+        LOG_ERROR_SYSTEM("No open record, dropping fill of {}", fill.id.raw());
+        continue;
+      }
+      auto &r = *record;
+      ctx_.bus.post(ServerOrderStatus{r.clientId,
+                                      {r.externalOId, r.systemOId.raw(), fill.fillQty,
+                                       batch.fillPrice,
+                                       partial ? OrderState::Partial : OrderState::Full}});
+      if (!partial) {
+        closeRecord(r);
+      }
+    }
+  }
+
 private:
+  template <typename EventT>
+  void enqueue(CRef<EventT> event) {
+    worker_.post(InternalGatewayEvent{event});
+  }
+
   void post(CRef<ServerOrder> so) {
+    if (!sharedIngress_) {
+      process(so);
+      return;
+    }
+    auto *lane = ingressLane();
+    if (LIKELY(lane != nullptr)) {
+      ingress(*lane, IngressOrder{so, false, true});
+      worker_.wakeUp();
+    }
+  }
+
+  void post(CRef<ServerOrderBatch> batch) {
+    if (!sharedIngress_) {
+      process(batch);
+      return;
+    }
+    auto *lane = ingressLane();
+    if (UNLIKELY(lane == nullptr)) {
+      return;
+    }
+    const size_t count = batch.orders.size();
+    for (size_t idx = 0; idx < count; ++idx) {
+      const ServerOrder so{batch.clientId, batch.orders[idx]};
+      ingress(*lane, IngressOrder{so, true, idx + 1 == count});
+    }
+    worker_.wakeUp();
+  }
+
+  /**
+   * @brief Network thread side, only waits for room in its own lane
+   */
+  void ingress(IngressLane &lane, CRef<IngressOrder> entry) {
+    SpinWait waiter;
+    while (!lane.write(entry)) {
+      worker_.wakeUp();
+      if (!++waiter) {
+        const auto &o = entry.order.order;
+        LOG_ERROR_SYSTEM("Ingress lane is full, rejecting {}", toString(entry.order));
+        ctx_.bus.post(ServerOrderStatus{entry.order.clientId,
+                                        {o.id, 0, o.quantity, o.price, OrderState::Rejected}});
+        return;
+      }
+    }
+  }
+
+  /**
+   * @brief Lane of the calling network thread, taken with its first order
+   */
+  auto ingressLane() -> IngressLane * {
+    thread_local std::pair<uint64_t, IngressLane *> owned{0, nullptr};
+    if (LIKELY(owned.first == instance_)) {
+      return owned.second;
+    }
+    const size_t idx = lanesTaken_.fetch_add(1, std::memory_order_relaxed);
+    if (UNLIKELY(idx >= lanes_.size())) {
+      LOG_ERROR_SYSTEM("No ingress lane left for another network thread, orders dropped");
+      return nullptr;
+    }
+    owned = {instance_, lanes_[idx].get()};
+    return owned.second;
+  }
+
+  size_t drain(IngressLane &lane) {
+    IngressOrder chunk[INGRESS_CHUNK];
+    size_t drained = 0;
+    SpinWait waiter;
+    while (drained < INGRESS_DRAIN_LIMIT || bursting_) {
+      const size_t count = lane.readBatch(Span<IngressOrder>{chunk});
+      for (size_t idx = 0; idx < count; ++idx) {
+        const auto &entry = chunk[idx];
+        bursting_ = entry.batched;
+        process(entry.order);
+        if (entry.batched && entry.last) {
+          endBurst();
+        }
+      }
+      drained += count;
+      if (count == INGRESS_CHUNK) {
+        continue;
+      }
+      if (!bursting_) {
+        break;
+      }
+      // rest of the batch is being written
+      if (count != 0) {
+        waiter.reset();
+      } else if (!++waiter || ctx_.stopToken.stop_requested()) {
+        LOG_ERROR_SYSTEM("Order batch was not written in full");
+        endBurst();
+        break;
+      }
+    }
+    return drained;
+  }
+
+  void process(CRef<ServerOrderBatch> batch) {
+    LOG_DEBUG("{}", toString(batch));
+    bursting_ = true;
+    for (const auto &order : batch.orders) {
+      process(ServerOrder{batch.clientId, order});
+    }
+    endBurst();
+  }
+
+  inline void endBurst() {
+    bursting_ = false;
+    if (!burst_.empty()) {
+      ctx_.bus.post(InternalOrderBurst{burst_});
+      burst_.clear();
+    }
+  }
+
+  void process(CRef<ServerOrder> so) {
     LOG_DEBUG("{}", toString(so));
     if (closed_.load(std::memory_order_acquire)) {
       LOG_WARN_SYSTEM("OrderGateway is already stopped");
@@ -111,8 +351,7 @@ private:
       cancelOrder(so);
       break;
     case OrderAction::Modify:
-      LOG_DEBUG("Modify request received");
-      // TODO(self)
+      modifyOrder(so);
       break;
     default:
       newOrder(so);
@@ -126,18 +365,42 @@ private:
 
     auto &o = so.order;
     auto &r = recordMap_[sysOId.index()];
-    if (r.getState() != RecordState::Accepted || so.clientId != r.clientId ||
-        o.id != r.systemOId.raw()) {
+    if (!isActive(so, r)) {
       LOG_ERROR_SYSTEM("Failed to cancel order: {}", toString(so));
       return;
     }
-    ctx_.bus.post(
-        InternalOrderEvent{{sysOId, r.bookOId, o.quantity, o.price}, nullptr, o.ticker, o.action});
+    route(InternalOrderEvent{
+        {sysOId, r.bookOId, o.quantity, o.price}, nullptr, r.tickerIdx, o.action});
+  }
+
+  /**
+   * @brief Amends the resting order in place, record and BookOrderId are reused
+   * quantity is the new open quantity, zero quantity is treated as cancel by the book
+   */
+  void modifyOrder(CRef<ServerOrder> so) {
+    LOG_DEBUG("Modify order: {}", toString(so));
+    SystemOrderId sysOId{so.order.id};
+
+    auto &o = so.order;
+    auto &r = recordMap_[sysOId.index()];
+    if (!isActive(so, r)) {
+      LOG_ERROR_SYSTEM("Failed to modify order: {}", toString(so));
+      return;
+    }
+    route(InternalOrderEvent{
+        {sysOId, r.bookOId, o.quantity, o.price}, nullptr, r.tickerIdx, o.action});
   }
 
   void newOrder(CRef<ServerOrder> so) {
     LOG_DEBUG("Creating order record {}", toString(so));
     auto &o = so.order;
+    const TickerIdx tickerIdx = data_.find(o.ticker);
+    if (tickerIdx == INVALID_TICKER_IDX) {
+      LOG_ERROR_SYSTEM("Unknown ticker, rejecting {}", toString(so));
+      ctx_.bus.post(
+          ServerOrderStatus{so.clientId, {o.id, 0, o.quantity, o.price, OrderState::Rejected}});
+      return;
+    }
     auto systemOId = idPool_.acquire();
     if (!systemOId) {
       LOG_ERROR_SYSTEM("Server opened order limit exceeded, rejecting {}", toString(so));
@@ -150,11 +413,30 @@ private:
     r.systemOId = systemOId;
     r.bookOId = BookOrderId{};
     r.clientId = so.clientId;
-    r.ticker = o.ticker;
+    r.tickerIdx = tickerIdx;
     r.setState(RecordState::New);
 
-    ctx_.bus.post(InternalOrderEvent{
-        {systemOId, BookOrderId{}, o.quantity, o.price}, nullptr, o.ticker, o.action});
+    route(InternalOrderEvent{
+        {systemOId, BookOrderId{}, o.quantity, o.price, o.type}, nullptr, tickerIdx, o.action});
+  }
+
+  inline void route(CRef<InternalOrderEvent> ioe) {
+    if (bursting_) {
+      burst_.push_back(ioe);
+    } else {
+      ctx_.bus.post(ioe);
+    }
+  }
+
+  /**
+   * @brief Record of the id unless it is closed or already reused by another order
+   */
+  inline auto openRecord(SystemOrderId id) -> OrderRecord * {
+    auto &r = recordMap_[id.index()];
+    if (!id || r.systemOId != id || r.getState() == RecordState::Closed) {
+      return nullptr;
+    }
+    return &r;
   }
 
   void closeRecord(OrderRecord &r) {
@@ -162,16 +444,41 @@ private:
     idPool_.release(r.systemOId);
   }
 
-  inline bool isValid(CRef<ServerOrder> o) const noexcept { return o.order.price > 0; }
+  inline bool isValid(CRef<ServerOrder> o) const noexcept {
+    return o.order.price > 0 || o.order.type == OrderType::Market;
+  }
+
+  /**
+   * @brief Tells gateways apart for the lanes cached by the network threads
+   */
+  static uint64_t nextInstance() {
+    static AtomicUInt64 counter{0};
+    return counter.fetch_add(1, std::memory_order_relaxed) + 1;
+  }
+
+  inline bool isActive(CRef<ServerOrder> so, CRef<OrderRecord> r) const noexcept {
+    return r.getState() == RecordState::Accepted && so.clientId == r.clientId &&
+           so.order.id == r.systemOId.raw();
+  }
 
 private:
   ALIGN_CL Context &ctx_;
+  const MarketData &data_;
 
   ALIGN_CL SlotIdPool<> idPool_;
-  ALIGN_CL HugeArray<OrderRecord, SlotIdPool<>::CAPACITY> recordMap_;
-  ALIGN_CL LfqRunner<InternalOrderStatus, OrderGateway, ServerBus> worker_;
+  ALIGN_CL OrderRecords recordMap_;
+  ALIGN_CL LfqRunner<InternalGatewayEvent, OrderGateway, ServerBus> worker_;
 
   ALIGN_CL AtomicBool closed_{false};
+
+  const bool sharedIngress_;
+  const uint64_t instance_;
+  Vector<UPtr<IngressLane>> lanes_;
+  ALIGN_CL AtomicUInt64 lanesTaken_{0};
+
+  // events of the batch being processed, touched by the processing thread only
+  Vector<InternalOrderEvent> burst_;
+  bool bursting_{false};
 };
 } // namespace hft::server
 
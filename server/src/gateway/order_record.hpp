@@ -6,9 +6,12 @@
 #ifndef HFT_SERVER_ORDERRECORD_HPP
 #define HFT_SERVER_ORDERRECORD_HPP
 
+#include "containers/huge_array.hpp"
 #include "domain_types.hpp"
+#include "id/slot_id_pool.hpp"
 #include "primitive_types.hpp"
 #include "schema.hpp"
+#include "ticker.hpp"
 
 namespace hft::server {
 enum class RecordState : uint32_t { New, Accepted, Closed };
@@ -21,7 +24,7 @@ struct OrderRecord {
   OrderId externalOId;
   SystemOrderId systemOId;
   BookOrderId bookOId;
-  Ticker ticker;
+  TickerIdx tickerIdx;
 
   // published once
   ClientId clientId;
@@ -39,6 +42,8 @@ struct OrderRecord {
     aState.store(newState, std::memory_order_release);
   }
 };
+
+using OrderRecords = HugeArray<OrderRecord, SlotIdPool<>::CAPACITY>;
 } // namespace hft::server
 
 #endif // HFT_SERVER_ORDERRECORD_HPP
\ No newline at end of file
@@ -12,9 +12,11 @@
 #include "bus/bus_hub.hpp"
 #include "commands/command.hpp"
 #include "config/server_config.hpp"
+#include "container_types.hpp"
 #include "events.hpp"
 #include "internal_error.hpp"
 #include "primitive_types.hpp"
+#include "ptr_types.hpp"
 #include "traits.hpp"
 #include "transport/boost/boost_network_types.hpp"
 #include "transport/boost/boost_tcp_transport.hpp"
@@ -24,16 +26,35 @@
 namespace hft::server {
 
 /**
- * @brief
+ * @brief Socket io, runs an io thread on the network core and one more on every extra core
+ * @details Every io thread has its own io context and acceptors, with several threads they
+ * share the ports with SO_REUSEPORT, so the kernel spreads new connections over the threads,
+ * connection then stays on the thread that has accepted it. Datagram socket is on the first one
  */
 class BoostIpcServer {
+  struct IoThread {
+    explicit IoThread(Optional<CoreId> core)
+        : core{core}, guard{MakeGuard(ioCtx.get_executor())}, upstreamAcceptor{ioCtx},
+          downstreamAcceptor{ioCtx} {}
+
+    const Optional<CoreId> core;
+    IoCtx ioCtx;
+    IoCtxGuard guard;
+    TcpAcceptor upstreamAcceptor;
+    TcpAcceptor downstreamAcceptor;
+    std::jthread thread;
+  };
+
 public:
   using StreamTHandler = MoveHandler<BoostTcpTransport>;
   using DatagramTHandler = MoveHandler<BoostUdpTransport>;
 
-  explicit BoostIpcServer(Context &ctx)
-      : ctx_{ctx}, guard_{MakeGuard(ioCtx_.get_executor())}, upstreamAcceptor_{ioCtx_},
-        downstreamAcceptor_{ioCtx_} {}
+  explicit BoostIpcServer(Context &ctx) : ctx_{ctx} {
+    io_.push_back(std::make_unique<IoThread>(ctx_.config.coreNetwork));
+    for (const auto core : ctx_.config.coresNetwork) {
+      io_.push_back(std::make_unique<IoThread>(core));
+    }
+  }
 
   ~BoostIpcServer() { stop(); }
 
@@ -44,91 +65,89 @@ public:
   void setDatagramClb(DatagramTHandler &&datagramClb) { datagramClb_ = std::move(datagramClb); }
 
   void start() {
-    if (running_) {
+    if (running_.exchange(true)) {
       LOG_ERROR("BoostIpcServer is already running");
       return;
     }
-    workerThread_ = std::jthread([this]() {
-      try {
-        running_ = true;
-        utils::setThreadRealTime();
-        if (ctx_.config.coreNetwork.has_value()) {
-          const CoreId id = ctx_.config.coreNetwork.value();
-          utils::pinThreadToCore(id);
-          LOG_DEBUG("Network thread started on the core {}", id);
-        } else {
-          LOG_DEBUG("Network thread started");
+    for (size_t idx = 0; idx < io_.size(); ++idx) {
+      IoThread &io = *io_[idx];
+      io.thread = std::jthread([this, &io, idx]() {
+        try {
+          utils::setThreadRealTime();
+          if (io.core.has_value()) {
+            utils::pinThreadToCore(io.core.value());
+            LOG_DEBUG("Network thread {} started on the core {}", idx, io.core.value());
+          } else {
+            LOG_DEBUG("Network thread {} started", idx);
+          }
+          io.ioCtx.post([this, &io, idx]() {
+            startUpstream(io);
+            startDownstream(io);
+            if (idx == 0) {
+              createDatagram(io);
+            }
+          });
+          io.ioCtx.run();
+        } catch (const std::exception &e) {
+          LOG_ERROR_SYSTEM("Exception in network thread {}", e.what());
+          io.ioCtx.stop();
+          ctx_.bus.post(InternalError(StatusCode::Error, e.what()));
+        } catch (...) {
+          LOG_ERROR_SYSTEM("Unknown exception in network thread");
+          io.ioCtx.stop();
+          ctx_.bus.post(InternalError(StatusCode::Error, "Unknown"));
         }
-        ioCtx_.post([this]() {
-          startUpstream();
-          startDownstream();
-          createDatagram();
-        });
-        ioCtx_.run();
-      } catch (const std::exception &e) {
-        LOG_ERROR_SYSTEM("Exception in network thread {}", e.what());
-        ioCtx_.stop();
-        ctx_.bus.post(InternalError(StatusCode::Error, e.what()));
-      } catch (...) {
-        LOG_ERROR_SYSTEM("Unknown exception in ShmReader");
-        ioCtx_.stop();
-        ctx_.bus.post(InternalError(StatusCode::Error, "Unknown"));
-      }
-    });
+      });
+    }
   }
 
   void stop() {
     if (!running_.exchange(false)) {
       return;
     }
-    ioCtx_.stop();
-    utils::join(workerThread_);
+    for (auto &io : io_) {
+      io->ioCtx.stop();
+    }
+    for (auto &io : io_) {
+      utils::join(io->thread);
+    }
   }
 
   auto getHook() -> std::function<void(Callback &&clb)> {
-    return [this](Callback &&clb) { ioCtx_.post(std::move(clb)); };
+    return [this](Callback &&clb) { io_.front()->ioCtx.post(std::move(clb)); };
   }
 
 private:
-  void startUpstream() {
-    const TcpEndpoint endpoint(Tcp::v4(), ctx_.config.portTcpUp);
-    upstreamAcceptor_.open(endpoint.protocol());
-    upstreamAcceptor_.set_option(boost::asio::socket_base::reuse_address(true));
-    upstreamAcceptor_.bind(endpoint);
-    upstreamAcceptor_.listen();
-    acceptUpstream();
+  void startUpstream(IoThread &io) {
+    listen(io.upstreamAcceptor, ctx_.config.portTcpUp);
+    accept(io.upstreamAcceptor, upstreamClb_);
   }
 
-  void acceptUpstream() {
-    upstreamAcceptor_.async_accept([this](BoostErrorCode ec, TcpSocket socket) {
-      if (ec) {
-        LOG_ERROR("Failed to accept connection {}", ec.message());
-        return;
-      }
-      configureTcpSocket(socket);
-      upstreamClb_(BoostTcpTransport{std::move(socket)});
-      acceptUpstream();
-    });
+  void startDownstream(IoThread &io) {
+    listen(io.downstreamAcceptor, ctx_.config.portTcpDown);
+    accept(io.downstreamAcceptor, downstreamClb_);
   }
 
-  void startDownstream() {
-    const TcpEndpoint endpoint(Tcp::v4(), ctx_.config.portTcpDown);
-    downstreamAcceptor_.open(endpoint.protocol());
-    downstreamAcceptor_.set_option(boost::asio::socket_base::reuse_address(true));
-    downstreamAcceptor_.bind(endpoint);
-    downstreamAcceptor_.listen();
-    acceptDownstream();
+  void listen(TcpAcceptor &acceptor, Port port) {
+    const TcpEndpoint endpoint(Tcp::v4(), port);
+    acceptor.open(endpoint.protocol());
+    acceptor.set_option(boost::asio::socket_base::reuse_address(true));
+    if (io_.size() > 1) {
+      acceptor.set_option(ReusePort(true));
+    }
+    acceptor.bind(endpoint);
+    acceptor.listen();
   }
 
-  void acceptDownstream() {
-    downstreamAcceptor_.async_accept([this](BoostErrorCode ec, TcpSocket socket) {
+  void accept(TcpAcceptor &acceptor, StreamTHandler &clb) {
+    acceptor.async_accept([this, &acceptor, &clb](BoostErrorCode ec, TcpSocket socket) {
       if (ec) {
         LOG_ERROR("Failed to accept connection: {}", ec.message());
         return;
       }
       configureTcpSocket(socket);
-      downstreamClb_(BoostTcpTransport{std::move(socket)});
-      acceptDownstream();
+      clb(BoostTcpTransport{std::move(socket)});
+      accept(acceptor, clb);
     });
   }
 
@@ -149,11 +168,11 @@ private:
     socket.set_option(boost::asio::socket_base::reuse_address(true));
   }
 
-  void createDatagram() {
+  void createDatagram(IoThread &io) {
     try {
       using namespace boost::asio;
 
-      UdpSocket socket(ioCtx_, Udp::v4());
+      UdpSocket socket(io.ioCtx, Udp::v4());
 
       socket.set_option(socket_base::broadcast{true});
       configureUdpSocket(socket);
@@ -172,18 +191,13 @@ private:
 private:
   Context &ctx_;
 
-  IoCtx ioCtx_;
-  IoCtxGuard guard_;
-
   StreamTHandler upstreamClb_;
   StreamTHandler downstreamClb_;
   DatagramTHandler datagramClb_;
 
-  TcpAcceptor upstreamAcceptor_;
-  TcpAcceptor downstreamAcceptor_;
+  Vector<UPtr<IoThread>> io_;
 
   AtomicBool running_{false};
-  std::jthread workerThread_;
 };
 
 } // namespace hft::server
@@ -0,0 +1,85 @@
+/**
+ * @author Vladimir Pavliv
+ * @date 2026-02-16
+ */
+
+#ifndef HFT_SERVER_PRICEPUBLISHER_HPP
+#define HFT_SERVER_PRICEPUBLISHER_HPP
+
+#include "domain_types.hpp"
+#include "logging.hpp"
+#include "primitive_types.hpp"
+#include "traits.hpp"
+#include "transport/price_batch.hpp"
+
+namespace hft::server {
+
+/**
+ * @brief Packs price and level updates into datagrams, one send per batch
+ * first update since the last flush tells the owner to schedule a flush, so all the updates
+ * of a single PriceFeed round or worker batch go out together, full batch is sent right away
+ * price and level batches share the sequence, so the receiver spots any lost datagram
+ * @details publisher never posts anything referring to itself, the owner does it
+ * and flushes through its own pointer, so a queued flush never outlives the publisher
+ */
+template <typename TransportT>
+class PricePublisher {
+public:
+  explicit PricePublisher(TransportT &&transport) : transport_{std::move(transport)} {}
+
+  /**
+   * @return true if the flush needs to be scheduled
+   */
+  [[nodiscard]] bool post(CRef<TickerPrice> price) { return add(prices_, price); }
+
+  [[nodiscard]] bool post(CRef<LevelUpdate> level) { return add(levels_, level); }
+
+  void flush() {
+    send(prices_);
+    send(levels_);
+  }
+
+  void close() {
+    closed_ = true;
+    transport_.close();
+  }
+
+private:
+  template <typename BatchT, typename ItemT>
+  bool add(BatchT &batch, CRef<ItemT> item) {
+    const bool idle = prices_.empty() && levels_.empty();
+    batch.add(item);
+    if (batch.full()) {
+      send(batch);
+    }
+    return idle;
+  }
+
+  template <typename BatchT>
+  void send(BatchT &batch) {
+    if (batch.empty()) {
+      return;
+    }
+    if (!closed_) {
+      batch.header.seq = seq_++;
+      const auto res = transport_.syncTx(batch.bytes());
+      if (!res) {
+        LOG_ERROR("Failed to send feed batch #{}", batch.header.seq);
+      }
+      LOG_TRACE("Feed batch #{} of {}", batch.header.seq, batch.header.count);
+    }
+    batch.header.count = 0;
+  }
+
+private:
+  TransportT transport_;
+
+  PriceBatch prices_;
+  LevelBatch levels_;
+  uint64_t seq_{0};
+  bool closed_{false};
+};
+
+} // namespace hft::server
+
+#endif // HFT_SERVER_PRICEPUBLISHER_HPP
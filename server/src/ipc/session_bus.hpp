@@ -50,6 +50,13 @@ public:
         return;
       }
       bus_.post(ServerOrder{clientId_.value(), message});
+    } else if constexpr (std::is_same_v<MessageType, OrderBatch>) {
+      if (!isAuthenticated()) {
+        LOG_ERROR_SYSTEM("Not authenticated: session {}", connId_);
+        bus_.post(ChannelStatusEvent{clientId_, {connId_, ConnectionStatus::Error}});
+        return;
+      }
+      bus_.post(ServerOrderBatch{clientId_.value(), message.view()});
     } else if constexpr (std::is_same_v<MessageType, ConnectionStatusEvent>) {
       bus_.post(ChannelStatusEvent{clientId_, message});
     } else {
@@ -14,7 +14,9 @@
 #include "config/server_config.hpp"
 #include "events.hpp"
 #include "traits.hpp"
+#include "transport/shm/shm_ptr.hpp"
 #include "transport/shm/shm_reactor.hpp"
+#include "transport/shm/shm_session_registry.hpp"
 #include "transport/shm/shm_transport.hpp"
 #include "utils/memory_utils.hpp"
 #include "utils/sync_utils.hpp"
@@ -22,7 +24,9 @@
 namespace hft::server {
 
 /**
- * @brief
+ * @brief Opens shm sessions in the registry and maps a queue pair for each of them
+ * streams are handed over slot by slot, upstream then downstream, so the session manager
+ * knows the slot, and so the ClientId, by the order they come in
  */
 class ShmServer {
 public:
@@ -56,20 +60,33 @@ public:
 private:
   void initialize() {
     LOG_DEBUG("ShmServer::initialize");
-    if (upstreamClb_) {
-      const auto name = ctx_.config.data.get<String>("shm.shm_upstream");
-      upstreamClb_(ShmTransport::makeReader(name));
+    const auto &cfg = ctx_.config.data;
+    const auto sessions = cfg.get<uint32_t>("shm.shm_sessions");
+    registry_.emplace(cfg.get<String>("shm.shm_registry"));
+
+    const auto upstream = cfg.get<String>("shm.shm_upstream");
+    const auto downstream = cfg.get<String>("shm.shm_downstream");
+    for (uint32_t slot = 0; slot < sessions; ++slot) {
+      if (upstreamClb_) {
+        upstreamClb_(ShmTransport::makeReader(ShmSessionRegistry::queueName(upstream, slot)));
+      }
+      if (downstreamClb_) {
+        downstreamClb_(ShmTransport::makeWriter(ShmSessionRegistry::queueName(downstream, slot)));
+      }
     }
-    if (downstreamClb_) {
-      const auto name = ctx_.config.data.get<String>("shm.shm_downstream");
-      downstreamClb_(ShmTransport::makeWriter(name));
+    if (datagramClb_) {
+      datagramClb_(ShmTransport::makePublisher(cfg.get<String>("shm.shm_broadcast")));
     }
+    // clients may claim slots only once their queues are there
+    (*registry_)->open(sessions);
+    LOG_INFO_SYSTEM("ShmServer opened {} sessions", sessions);
   }
 
 private:
   Context &ctx_;
 
   ShmReactor reactor_;
+  Optional<ShmUPtr<ShmSessionRegistry>> registry_;
 
   ShmHandler upstreamClb_;
   ShmHandler downstreamClb_;
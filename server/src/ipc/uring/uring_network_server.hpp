@@ -0,0 +1,181 @@
+/**
+ * @author Vladimir Pavliv
+ * @date 2026-02-18
+ */
+
+#ifndef HFT_SERVER_URINGNETWORKSERVER_HPP
+#define HFT_SERVER_URINGNETWORKSERVER_HPP
+
+#include <cstring>
+#include <format>
+#include <memory>
+
+#include "bus/bus_hub.hpp"
+#include "config/server_config.hpp"
+#include "events.hpp"
+#include "internal_error.hpp"
+#include "primitive_types.hpp"
+#include "traits.hpp"
+#include "transport/uring/uring_network_utils.hpp"
+#include "transport/uring/uring_reactor.hpp"
+#include "transport/uring/uring_tcp_transport.hpp"
+#include "transport/uring/uring_udp_transport.hpp"
+#include "utils/thread_utils.hpp"
+
+namespace hft::server {
+
+/**
+ * @brief Socket io on a single io_uring, same callbacks as BoostIpcServer
+ * connections are accepted with multishot accepts, one per listening socket
+ */
+class UringIpcServer {
+public:
+  using StreamTHandler = MoveHandler<UringTcpTransport>;
+  using DatagramTHandler = MoveHandler<UringUdpTransport>;
+
+  explicit UringIpcServer(Context &ctx) : ctx_{ctx} {
+    if (!ctx_.config.coresNetwork.empty()) {
+      LOG_WARN_SYSTEM("Extra network cores are not used with io_uring");
+    }
+  }
+
+  ~UringIpcServer() {
+    stop();
+    closeListeners();
+  }
+
+  void setUpstreamClb(StreamTHandler &&streamClb) { upstreamClb_ = std::move(streamClb); }
+
+  void setDownstreamClb(StreamTHandler &&streamClb) { downstreamClb_ = std::move(streamClb); }
+
+  void setDatagramClb(DatagramTHandler &&datagramClb) { datagramClb_ = std::move(datagramClb); }
+
+  void start() {
+    if (running_.exchange(true)) {
+      LOG_ERROR("UringIpcServer is already running");
+      return;
+    }
+    workerThread_ = std::jthread([this]() {
+      try {
+        utils::setThreadRealTime();
+        if (ctx_.config.coreNetwork.has_value()) {
+          const CoreId id = ctx_.config.coreNetwork.value();
+          utils::pinThreadToCore(id);
+          LOG_DEBUG("Network thread started on the core {}", id);
+        } else {
+          LOG_DEBUG("Network thread started");
+        }
+        upstreamFd_ = listen(ctx_.config.portTcpUp);
+        downstreamFd_ = listen(ctx_.config.portTcpDown);
+        accept(upstreamFd_, upstreamClb_);
+        accept(downstreamFd_, downstreamClb_);
+        createDatagram();
+        reactor_.run();
+      } catch (const std::exception &e) {
+        LOG_ERROR_SYSTEM("Exception in network thread {}", e.what());
+        ctx_.bus.post(InternalError(StatusCode::Error, e.what()));
+      } catch (...) {
+        LOG_ERROR_SYSTEM("Unknown exception in network thread");
+        ctx_.bus.post(InternalError(StatusCode::Error, "Unknown"));
+      }
+    });
+  }
+
+  void stop() {
+    if (!running_.exchange(false)) {
+      return;
+    }
+    reactor_.stop();
+    utils::join(workerThread_);
+  }
+
+private:
+  int listen(Port port) {
+    const int fd = openSocket(SOCK_STREAM);
+    setSocketOption(fd, SOL_SOCKET, SO_REUSEADDR, 1);
+    const sockaddr_in addr = makeAddress(INADDR_ANY, port);
+    if (::bind(fd, reinterpret_cast<const sockaddr *>(&addr), sizeof(addr)) != 0 ||
+        ::listen(fd, SOMAXCONN) != 0) {
+      const int error = errno;
+      ::close(fd);
+      throw std::runtime_error(
+          std::format("Failed to listen on {}: {}", port, std::strerror(error)));
+    }
+    return fd;
+  }
+
+  void accept(int fd, StreamTHandler &clb) {
+    const bool armed = reactor_.submit(
+        [fd](io_uring_sqe *sqe) { io_uring_prep_multishot_accept(sqe, fd, nullptr, nullptr, 0); },
+        [this, fd, &clb](CRef<io_uring_cqe> cqe) {
+          if (cqe.res >= 0) {
+            onAccept(cqe.res, clb);
+          } else if (cqe.res != -ECANCELED) {
+            LOG_ERROR("Failed to accept connection: {}", std::strerror(-cqe.res));
+          }
+          if ((cqe.flags & IORING_CQE_F_MORE) == 0 && running_.load()) {
+            accept(fd, clb);
+          }
+        });
+    if (!armed) {
+      throw std::runtime_error("Failed to start accepting connections");
+    }
+  }
+
+  void onAccept(int fd, StreamTHandler &clb) {
+    try {
+      configureTcpSocket(fd);
+    } catch (const std::exception &e) {
+      LOG_ERROR("{}", e.what());
+      ::close(fd);
+      return;
+    }
+    clb(UringTcpTransport{reactor_, fd});
+  }
+
+  void createDatagram() {
+    try {
+      const int fd = openSocket(SOCK_DGRAM);
+      UringUdpTransport transport{reactor_, fd};
+      setSocketOption(fd, SOL_SOCKET, SO_REUSEADDR, 1);
+      setSocketOption(fd, SOL_SOCKET, SO_BROADCAST, 1);
+
+      const sockaddr_in addr = makeAddress(INADDR_BROADCAST, ctx_.config.portUdp);
+      if (::connect(fd, reinterpret_cast<const sockaddr *>(&addr), sizeof(addr)) != 0) {
+        throw std::runtime_error(std::format("Failed to connect: {}", std::strerror(errno)));
+      }
+      LOG_INFO_SYSTEM("UDP initialized 255.255.255.255:{}", ctx_.config.portUdp);
+
+      datagramClb_(std::move(transport));
+    } catch (const std::exception &ex) {
+      LOG_ERROR_SYSTEM("Failed to create datagram transport: {}", ex.what());
+    }
+  }
+
+  void closeListeners() {
+    for (int fd : {upstreamFd_, downstreamFd_}) {
+      if (fd >= 0) {
+        ::close(fd);
+      }
+    }
+  }
+
+private:
+  Context &ctx_;
+
+  UringReactor reactor_;
+
+  StreamTHandler upstreamClb_;
+  StreamTHandler downstreamClb_;
+  DatagramTHandler datagramClb_;
+
+  int upstreamFd_{-1};
+  int downstreamFd_{-1};
+
+  AtomicBool running_{false};
+  std::jthread workerThread_;
+};
+
+} // namespace hft::server
+
+#endif // HFT_SERVER_URINGNETWORKSERVER_HPP
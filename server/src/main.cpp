@@ -13,6 +13,9 @@
 #ifdef COMM_SHM
 #include "ipc/shm/shm_server.hpp"
 #include "session/trusted_session_manager.hpp"
+#elif defined(COMM_URING)
+#include "ipc/uring/uring_network_server.hpp"
+#include "session/network_session_manager.hpp"
 #else
 #include "ipc/boost/boost_network_server.hpp"
 #include "session/network_session_manager.hpp"
@@ -14,6 +14,7 @@
 #include "constants.hpp"
 #include "containers/vyukov_mpmc.hpp"
 #include "events.hpp"
+#include "ipc/price_publisher.hpp"
 #include "ipc/session_channel.hpp"
 #include "logging.hpp"
 #include "traits.hpp"
@@ -26,11 +27,13 @@ namespace hft::server {
 
 /**
  * @brief Manages sessions, generates tokens, authenticates channels
+ * publishes prices and order book level updates over the datagram transport
  */
 class NetworkSessionManager {
   using SelfT = NetworkSessionManager;
   using UpstreamChan = SessionChannel<UpstreamBus>;
   using DownstreamChan = SessionChannel<DownstreamBus>;
+  using Publisher = PricePublisher<DatagramTransport>;
 
   static constexpr size_t DRAIN_CHUNK = 1024;
   /**
@@ -52,6 +55,8 @@ public:
 
     ctx_.bus.subscribe(CRefHandler<ServerOrderStatus>::bind<SelfT, &SelfT::post>(this));
     ctx_.bus.subscribe(CRefHandler<ServerLoginResponse>::bind<SelfT, &SelfT::post>(this));
+    ctx_.bus.subscribe(CRefHandler<TickerPrice>::bind<SelfT, &SelfT::post>(this));
+    ctx_.bus.subscribe(CRefHandler<LevelUpdateBurst>::bind<SelfT, &SelfT::post>(this));
     ctx_.bus.subscribe(CRefHandler<ChannelStatusEvent>::bind<SelfT, &SelfT::post>(this));
     ctx_.bus.subscribe(CRefHandler<ServerTokenBindRequest>::bind<SelfT, &SelfT::post>(this));
   }
@@ -91,8 +96,25 @@ public:
     unauthorizedDownstreamMap_.insert(std::make_pair(id, std::move(chan)));
   }
 
+  void acceptDatagram(DatagramTransport &&transport) {
+    if (ctx_.stopToken.stop_requested()) {
+      return;
+    }
+    if (publisher_ != nullptr) {
+      // flush may already be queued, replacing the publisher would lose its pending updates
+      LOG_ERROR_SYSTEM("Prices are already published, dropping the datagram transport");
+      transport.close();
+      return;
+    }
+    LOG_INFO_SYSTEM("Publishing prices");
+    publisher_ = std::make_unique<Publisher>(std::move(transport));
+  }
+
   void close() {
     LOG_DEBUG_SYSTEM("close");
+    if (publisher_ != nullptr) {
+      publisher_->close();
+    }
     for (auto iter = sessionsMap_.begin(); iter != sessionsMap_.end(); ++iter) {
       if (iter->second->upstreamChannel != nullptr) {
         iter->second->upstreamChannel->close();
@@ -245,6 +267,39 @@ private:
     }
   }
 
+  void post(CRef<TickerPrice> price) {
+    if (ctx_.stopToken.stop_requested() || publisher_ == nullptr) {
+      return;
+    }
+    if (publisher_->post(price)) {
+      scheduleFlush();
+    }
+  }
+
+  /**
+   * @brief Drained from a worker level queue on the system thread, goes out right away
+   */
+  void post(CRef<LevelUpdateBurst> burst) {
+    if (ctx_.stopToken.stop_requested() || publisher_ == nullptr) {
+      return;
+    }
+    for (const auto &level : burst.levels) {
+      static_cast<void>(publisher_->post(level));
+    }
+    publisher_->flush();
+  }
+
+  /**
+   * @brief Flush goes through the manager, which outlives any queued system bus task
+   */
+  void scheduleFlush() {
+    ctx_.bus.post([this]() {
+      if (publisher_ != nullptr) {
+        publisher_->flush();
+      }
+    });
+  }
+
   inline void printStats() const { LOG_INFO_SYSTEM("Active sessions: {}", sessionsMap_.size()); }
 
 private:
@@ -254,6 +309,7 @@ private:
   folly::AtomicHashMap<ConnectionId, SPtr<DownstreamChan>> unauthorizedDownstreamMap_;
 
   folly::AtomicHashMap<ClientId, SPtr<Session>> sessionsMap_;
+  UPtr<Publisher> publisher_;
 };
 
 } // namespace hft::server
@@ -14,6 +14,8 @@
 #include "traits.hpp"
 #include "transport/channel.hpp"
 #include "transport/connection_status.hpp"
+#include "transport/shm/shm_ptr.hpp"
+#include "transport/shm/shm_session_registry.hpp"
 #include "utils/handler.hpp"
 #include "utils/string_utils.hpp"
 
@@ -21,43 +23,74 @@ namespace hft::server {
 
 /**
  * @brief Session manager for shared memory communciation
- * Maintains single up/downstream channels, no auth needed, no channel, transport is used directly
+ * Maintains up/downstream pair per shm session, no auth needed, no channel, transport is used
+ * directly, streams come in slot by slot, client stamps its orders with the ClientId of its claim,
+ * orders and statuses of a ClientId that no longer owns its slot are dropped, so a client that
+ * reclaims the slot of a dead one never gets its leftover orders or fills, failed channel
+ * closes only its own session, prices go to every client through a single broadcast
+ * transport along with level updates, both are plain structs behind a one byte type tag
  */
 class TrustedSessionManager {
   using UpstreamChan = StreamTransport;
   using DownstreamChan = StreamTransport;
+  using DatagramChan = DatagramTransport;
 
   using SelfT = TrustedSessionManager;
 
+  struct Session {
+    using SelfT = Session;
+
+    Session(TrustedSessionManager &manager, uint32_t slot) : manager{manager}, slot{slot} {}
+
+    void post(CRef<IoResult> res) { manager.post(*this, res); }
+
+    TrustedSessionManager &manager;
+    const uint32_t slot;
+
+    UPtr<UpstreamChan> upChannel;
+    UPtr<DownstreamChan> downChannel;
+    ShmOrder record;
+  };
+
 public:
-  explicit TrustedSessionManager(Context &ctx) : ctx_{ctx} {
+  explicit TrustedSessionManager(Context &ctx)
+      : ctx_{ctx}, registry_{ctx_.config.data.get<String>("shm.shm_registry")} {
     LOG_INFO_SYSTEM("TrustedSessionManager initialized");
 
     ctx_.bus.subscribe(CRefHandler<ServerOrderStatus>::bind<SelfT, &SelfT::post>(this));
+    ctx_.bus.subscribe(CRefHandler<TickerPrice>::bind<SelfT, &SelfT::post>(this));
+    ctx_.bus.subscribe(CRefHandler<LevelUpdateBurst>::bind<SelfT, &SelfT::post>(this));
     ctx_.bus.subscribe(CRefHandler<ChannelStatusEvent>::bind<SelfT, &SelfT::post>(this));
   }
 
   ~TrustedSessionManager() { LOG_DEBUG_SYSTEM("~TrustedSessionManager"); }
 
   void acceptUpstream(StreamTransport &&t) {
-    LOG_DEBUG_SYSTEM("acceptUpstream");
-    upChannel_ = std::make_unique<UpstreamChan>(std::move(t));
-    ByteSpan span(reinterpret_cast<uint8_t *>(&order_), sizeof(Order));
-    upChannel_->asyncRx(span, CRefHandler<IoResult>::bind<SelfT, &SelfT::post>(this));
+    LOG_DEBUG_SYSTEM("acceptUpstream {}", upstreamCount_);
+    auto &session = getSession(upstreamCount_++);
+    session.upChannel = std::make_unique<UpstreamChan>(std::move(t));
+    ByteSpan span(reinterpret_cast<uint8_t *>(&session.record), sizeof(ShmOrder));
+    session.upChannel->asyncRx(span,
+                               CRefHandler<IoResult>::bind<Session, &Session::post>(&session));
   }
 
   void acceptDownstream(StreamTransport &&t) {
-    LOG_DEBUG_SYSTEM("acceptDownstream");
-    downChannel_ = std::make_unique<DownstreamChan>(std::move(t));
+    LOG_DEBUG_SYSTEM("acceptDownstream {}", downstreamCount_);
+    getSession(downstreamCount_++).downChannel = std::make_unique<DownstreamChan>(std::move(t));
+  }
+
+  void acceptDatagram(DatagramTransport &&t) {
+    LOG_DEBUG_SYSTEM("acceptDatagram");
+    datagramChannel_ = std::make_unique<DatagramChan>(std::move(t));
   }
 
   void close() {
     LOG_DEBUG_SYSTEM("TrustedSessionManager close");
-    if (upChannel_) {
-      upChannel_->close();
+    if (datagramChannel_) {
+      datagramChannel_->close();
     }
-    if (downChannel_) {
-      downChannel_->close();
+    for (auto &session : sessions_) {
+      close(*session);
     }
   }
 
@@ -71,24 +104,35 @@ private:
     case ConnectionStatus::Connected:
       break;
     case ConnectionStatus::Disconnected:
-    case ConnectionStatus::Error:
+    case ConnectionStatus::Error: {
       LOG_DEBUG("Channel {} disconnected", event.event.connectionId);
-      close();
+      const auto slot = ShmSessionRegistry::slotOf(event.clientId.value_or(0));
+      if (!event.clientId || slot >= sessions_.size()) {
+        LOG_ERROR("No shm session for {}", toString(event));
+        break;
+      }
+      close(*sessions_[slot]);
       break;
+    }
     default:
       break;
     }
   }
 
-  void post(CRef<IoResult> res) {
+  void post(CRef<Session> session, CRef<IoResult> res) {
     if (ctx_.stopToken.stop_requested()) {
       return;
     }
     if (!res) {
-      LOG_ERROR("Failed to read from shm");
+      LOG_ERROR("Failed to read from shm session {}", session.slot);
       ctx_.bus.post(InternalError{StatusCode::Error, "Failed to read from shm"});
+    } else if (UNLIKELY(ShmSessionRegistry::slotOf(session.record.clientId) != session.slot ||
+                        !registry_->owns(session.record.clientId))) {
+      // left in the queue by a client that is gone, the slot is someone else's now
+      LOG_WARN("Client {} left shm session {}, dropping {}", session.record.clientId,
+               session.slot, toString(session.record.order));
     } else {
-      ctx_.bus.post(ServerOrder{0, order_});
+      ctx_.bus.post(ServerOrder{session.record.clientId, session.record.order});
     }
   }
 
@@ -97,22 +141,82 @@ private:
       return;
     }
     LOG_DEBUG("{}", toString(status.orderStatus));
+    const auto slot = ShmSessionRegistry::slotOf(status.clientId);
+    if (UNLIKELY(slot >= sessions_.size() || !sessions_[slot]->downChannel)) {
+      LOG_ERROR("No shm session {} for {}", status.clientId, toString(status.orderStatus));
+      return;
+    }
+    if (UNLIKELY(!registry_->owns(status.clientId))) {
+      // slot has been reclaimed, client the status belongs to is gone
+      LOG_WARN("Client {} left shm session {}, dropping {}", status.clientId, slot,
+               toString(status.orderStatus));
+      return;
+    }
     auto *ptr = reinterpret_cast<const uint8_t *>(&status.orderStatus);
     CByteSpan span(ptr, sizeof(OrderStatus));
-    auto res = downChannel_->syncTx(span);
-    if (!res) {
+    const auto res = sessions_[slot]->downChannel->syncTx(span);
+    if (res.code == IoStatus::Closed) {
+      // client of the session is gone, its statuses are dropped
+      LOG_WARN("Shm session {} has no reader", slot);
+    } else if (!res) {
       LOG_ERROR("Failed to write ServerOrderStatus to shm");
       ctx_.bus.post(InternalError{StatusCode::Error, "Failed to write ServerOrderStatus to shm"});
     }
   }
 
-private:
-  Context &ctx_;
+  void post(CRef<TickerPrice> price) {
+    if (ctx_.stopToken.stop_requested() || !datagramChannel_) {
+      return;
+    }
+    LOG_TRACE("{}", toString(price));
+    const auto res = datagramChannel_->syncTx(feed_.pack(price));
+    if (!res) {
+      LOG_ERROR("Failed to broadcast {}", toString(price));
+    }
+  }
+
+  /**
+   * @brief Drained from a worker level queue on the system thread,
+   * the one the prices are written from, broadcast ring has a single writer
+   */
+  void post(CRef<LevelUpdateBurst> burst) {
+    if (ctx_.stopToken.stop_requested() || !datagramChannel_) {
+      return;
+    }
+    for (const auto &level : burst.levels) {
+      const auto res = datagramChannel_->syncTx(feed_.pack(level));
+      if (!res) {
+        LOG_ERROR("Failed to broadcast {}", toString(level));
+      }
+    }
+  }
 
-  Order order_;
+  static void close(Session &session) {
+    if (session.upChannel) {
+      session.upChannel->close();
+    }
+    if (session.downChannel) {
+      session.downChannel->close();
+    }
+  }
+
+  auto getSession(uint32_t slot) -> Session & {
+    while (sessions_.size() <= slot) {
+      sessions_.push_back(std::make_unique<Session>(*this, sessions_.size()));
+    }
+    return *sessions_[slot];
+  }
 
-  UPtr<UpstreamChan> upChannel_;
-  UPtr<DownstreamChan> downChannel_;
+private:
+  Context &ctx_;
+  ShmUPtr<ShmSessionRegistry> registry_;
+
+  Vector<UPtr<Session>> sessions_;
+  UPtr<DatagramChan> datagramChannel_;
+  // broadcast is written from the system thread only
+  ShmFeedRecord feed_;
+  uint32_t upstreamCount_{0};
+  uint32_t downstreamCount_{0};
 };
 
 } // namespace hft::server
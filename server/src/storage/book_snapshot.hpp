@@ -0,0 +1,239 @@
+/**
+ * @author Vladimir Pavliv
+ * @date 2026-02-09
+ */
+
+#ifndef HFT_SERVER_BOOKSNAPSHOT_HPP
+#define HFT_SERVER_BOOKSNAPSHOT_HPP
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "constants.hpp"
+#include "container_types.hpp"
+#include "execution/market_data.hpp"
+#include "execution/orderbook/node_pool.hpp"
+#include "gateway/order_record.hpp"
+#include "logging.hpp"
+#include "primitive_types.hpp"
+#include "ptr_types.hpp"
+#include "ticker.hpp"
+#include "utils/memory_utils.hpp"
+
+namespace hft::server {
+
+/**
+ * @brief File-backed huge page image of the books and node pools for a fast restart
+ * file has a region per worker for its pool and a slot per book at the ticker index,
+ * worker writes its region and the slots of books it owns at a safe point between messages,
+ * so workers never synchronize, a slot is restorable only if it was written in the same pass
+ * as the region of its worker, so books moved between passes invalidate the snapshot
+ * region also keeps client metadata of the gateway record for every resting node,
+ * so the gateway rebuilds records of restored orders and reports their fills to the clients
+ * @note record metadata is immutable while the order rests and is published to the worker
+ * with the order itself, so worker reads it without synchronizing with the gateway
+ */
+class BookSnapshot {
+  static constexpr uint64_t MAGIC = 0x5053424b4f4f42ULL;
+  static constexpr uint32_t VERSION = 3;
+
+  enum class RegionState : uint32_t { Empty, Writing, Valid };
+
+  struct FileHeader {
+    uint64_t magic;
+    uint32_t version;
+    uint32_t workerCount;
+    uint32_t bookCount;
+    uint32_t maxTicks;
+    uint64_t poolImageSize;
+    uint64_t poolSlots;
+    uint64_t bookImageSize;
+    bool operator==(const FileHeader &) const = default;
+  };
+
+  struct ALIGN_CL RegionHeader {
+    std::atomic<RegionState> state;
+    uint32_t epoch;
+  };
+
+  struct BookHeader {
+    Ticker ticker;
+    uint32_t worker;
+    uint32_t epoch;
+  };
+
+public:
+  struct BookEntry {
+    Ticker ticker;
+    ThreadId worker;
+    const uint8_t *image;
+  };
+
+  /**
+   * @brief Gateway record metadata of a resting node, stored at the node index
+   */
+  struct RecordImage {
+    OrderId externalOId;
+    ClientId clientId;
+    TickerIdx tickerIdx;
+  };
+
+  BookSnapshot(CRef<String> path, ThreadId workerCount, uint32_t bookCount, CRef<NodePool> pool)
+      : header_{MAGIC,     VERSION,          workerCount,  bookCount,
+                MAX_TICKS, pool.imageSize(), pool.slots(), OrderBook::IMAGE_SIZE},
+        bookSlotSize_{alignCl(sizeof(BookHeader) + OrderBook::IMAGE_SIZE)},
+        regionSize_{alignCl(sizeof(RegionHeader) + pool.imageSize() +
+                            pool.slots() * sizeof(RecordImage))},
+        booksOffset_{alignCl(sizeof(FileHeader)) + regionSize_ * workerCount},
+        size_{utils::alignHuge(booksOffset_ + bookSlotSize_ * bookCount)} {
+    dropMismatched(path);
+    // anonymous in ci, so there is never anything to restore
+    const auto res = utils::mapSharedMemory(path, size_);
+    base_ = static_cast<uint8_t *>(res.ptr);
+
+    auto *fileHeader = reinterpret_cast<FileHeader *>(base_);
+    if (res.own || *fileHeader != header_) {
+      LOG_INFO_SYSTEM("No book snapshot in {}", path);
+      std::memset(base_, 0, booksOffset_ + bookSlotSize_ * bookCount);
+      *fileHeader = header_;
+      return;
+    }
+    restorable_ = true;
+    for (ThreadId worker = 0; worker < workerCount; ++worker) {
+      if (region(worker)->state.load(std::memory_order_acquire) != RegionState::Valid) {
+        LOG_WARN_SYSTEM("Book snapshot region of worker {} is incomplete", worker);
+        restorable_ = false;
+      }
+    }
+    for (uint32_t idx = 0; restorable_ && idx < bookCount; ++idx) {
+      const auto *book = reinterpret_cast<const BookHeader *>(bookSlot(idx));
+      if (book->worker >= workerCount || book->epoch != region(book->worker)->epoch) {
+        LOG_WARN_SYSTEM("Book snapshot slot {} is stale", idx);
+        restorable_ = false;
+      }
+    }
+  }
+
+  ~BookSnapshot() { munmap(base_, size_); }
+
+  [[nodiscard]] bool restorable() const { return restorable_; }
+
+  /**
+   * @brief Books in the ticker index order
+   */
+  auto books() const -> Vector<BookEntry> {
+    Vector<BookEntry> entries;
+    entries.reserve(header_.bookCount);
+    for (uint32_t idx = 0; idx < header_.bookCount; ++idx) {
+      const uint8_t *slot = bookSlot(idx);
+      const auto *book = reinterpret_cast<const BookHeader *>(slot);
+      entries.push_back(BookEntry{book->ticker, static_cast<ThreadId>(book->worker),
+                                  slot + sizeof(BookHeader)});
+    }
+    return entries;
+  }
+
+  void loadPool(ThreadId worker, NodePool &pool) const {
+    pool.loadImage(reinterpret_cast<const uint8_t *>(region(worker)) + sizeof(RegionHeader));
+  }
+
+  /**
+   * @brief Record metadata of the resting node restored into the pool of the worker
+   */
+  auto record(ThreadId worker, uint32_t nodeIdx) const -> CRef<RecordImage> {
+    return records(worker)[nodeIdx];
+  }
+
+  /**
+   * @brief Gateway records to take metadata of resting orders from, set before workers start
+   */
+  void track(CRef<OrderRecords> records) { records_ = &records; }
+
+  /**
+   * @brief Drops restored images, so a crash later on would not bring back stale books
+   */
+  void invalidate() {
+    for (ThreadId worker = 0; worker < header_.workerCount; ++worker) {
+      region(worker)->state.store(RegionState::Empty, std::memory_order_release);
+    }
+    restorable_ = false;
+  }
+
+  /**
+   * @brief Writes the pool and the books owned by the worker, called from the worker thread
+   * or after the worker is stopped
+   */
+  void write(ThreadId worker, CRef<NodePool> pool, CRef<MarketData> data) {
+    auto *hdr = region(worker);
+    hdr->state.store(RegionState::Writing, std::memory_order_release);
+    const uint32_t epoch = ++hdr->epoch;
+
+    pool.saveImage(reinterpret_cast<uint8_t *>(hdr) + sizeof(RegionHeader));
+    if (records_ != nullptr) {
+      RecordImage *images = records(worker);
+      pool.forEachUsed([this, images](uint32_t idx, CRef<BookNode> node) {
+        const auto &r = (*records_)[node.systemId.index()];
+        images[idx] = RecordImage{r.externalOId, r.clientId, r.tickerIdx};
+      });
+    }
+    uint32_t count = 0;
+    for (const auto &tickerData : data) {
+      if (tickerData.owner.load(std::memory_order_acquire) != worker) {
+        continue;
+      }
+      uint8_t *slot = bookSlot(tickerData.index);
+      *reinterpret_cast<BookHeader *>(slot) = BookHeader{tickerData.ticker, worker, epoch};
+      tickerData.orderBook.saveImage(slot + sizeof(BookHeader));
+      ++count;
+    }
+    hdr->state.store(RegionState::Valid, std::memory_order_release);
+    LOG_INFO_SYSTEM("Worker {} snapshot: {} books {} orders", worker, count, pool.used());
+  }
+
+  BookSnapshot(const BookSnapshot &) = delete;
+  BookSnapshot &operator=(const BookSnapshot &) = delete;
+
+private:
+  static constexpr size_t alignCl(size_t size) {
+    return (size + CACHE_LINE_SIZE - 1) & ~(CACHE_LINE_SIZE - 1);
+  }
+
+  /**
+   * @brief Mapping an existing file of a different size would fault past its end
+   */
+  void dropMismatched(CRef<String> path) const {
+    struct stat st;
+    if (stat(path.c_str(), &st) == 0 && static_cast<size_t>(st.st_size) != size_) {
+      LOG_WARN_SYSTEM("Book snapshot {} layout changed, dropping it", path);
+      unlink(path.c_str());
+    }
+  }
+
+  RegionHeader *region(ThreadId worker) const {
+    return reinterpret_cast<RegionHeader *>(base_ + alignCl(sizeof(FileHeader)) +
+                                            regionSize_ * worker);
+  }
+
+  RecordImage *records(ThreadId worker) const {
+    return reinterpret_cast<RecordImage *>(reinterpret_cast<uint8_t *>(region(worker)) +
+                                           sizeof(RegionHeader) + header_.poolImageSize);
+  }
+
+  uint8_t *bookSlot(uint32_t idx) const { return base_ + booksOffset_ + bookSlotSize_ * idx; }
+
+private:
+  const FileHeader header_;
+  const size_t bookSlotSize_;
+  const size_t regionSize_;
+  const size_t booksOffset_;
+  const size_t size_;
+
+  uint8_t *base_{nullptr};
+  bool restorable_{false};
+  const OrderRecords *records_{nullptr};
+};
+
+} // namespace hft::server
+
+#endif // HFT_SERVER_BOOKSNAPSHOT_HPP
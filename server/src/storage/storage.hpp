@@ -12,17 +12,25 @@
 #include "logging.hpp"
 #include "primitive_types.hpp"
 #include "ptr_types.hpp"
+#include "storage/book_snapshot.hpp"
 #include "ticker.hpp"
 #include "traits.hpp"
 
 namespace hft::server {
 
+/**
+ * @brief Loads tickers from the db and distributes them among workers,
+ * books are restored from the snapshot if there is a complete one for the same tickers
+ */
 class Storage {
 public:
   explicit Storage(const ServerConfig &cfg, DbAdapter &dbAdapter)
       : config_{cfg}, dbAdapter_{dbAdapter}, marketData_{loadMarketData()} {}
 
   auto marketData() const -> CRef<MarketData> { return marketData_; }
+  auto nodePools() const -> CRef<NodePools> { return nodePools_; }
+  auto snapshot() const -> BookSnapshot * { return snapshot_.get(); }
+  bool restored() const { return restored_; }
 
 private:
   auto loadMarketData() -> MarketData {
@@ -41,25 +49,83 @@ private:
     MarketData data;
     data.reserve(prices.size());
 
+    nodePools_.reserve(workerCount);
+    for (ThreadId idx = 0; idx < workerCount; ++idx) {
+      nodePools_.emplace_back(std::make_unique<NodePool>(config_.orderBookLimit));
+    }
+
     const size_t perWorker = prices.size() / workerCount;
     const size_t leftOver = prices.size() % workerCount;
 
+    if (!config_.snapshotPath.empty()) {
+      snapshot_ = std::make_unique<BookSnapshot>(config_.snapshotPath, workerCount, prices.size(),
+                                                 *nodePools_[0]);
+      if (snapshot_->restorable() && restoreMarketData(data, prices)) {
+        restored_ = true;
+        return data;
+      }
+    }
+
     auto iter = prices.begin();
     for (ThreadId idx = 0; idx < workerCount; ++idx) {
       const size_t currWorkerTickers = perWorker + (idx < leftOver ? 1 : 0);
       for (size_t i = 0; i < currWorkerTickers && iter != prices.end(); ++i, ++iter) {
         LOG_TRACE("{}: ${}", toString(iter->ticker), iter->price);
-        data.emplace(iter->ticker, idx);
+        if (data.emplace(iter->ticker, idx, *nodePools_[idx], iter->price) == nullptr) {
+          LOG_WARN_SYSTEM("Duplicate ticker {}", toString(iter->ticker));
+        }
       }
     }
     LOG_INFO("Data loaded for {} tickers", prices.size());
     return data;
   }
 
+  bool restoreMarketData(MarketData &data, Span<const TickerPrice> prices) {
+    boost::unordered_flat_map<Ticker, Price, TickerHash> refPrices;
+    for (const auto &price : prices) {
+      refPrices.emplace(price.ticker, price.price);
+    }
+    const auto books = snapshot_->books();
+    if (books.size() != prices.size()) {
+      LOG_WARN_SYSTEM("Snapshot has {} books, db {} tickers, starting empty", books.size(),
+                      prices.size());
+      return false;
+    }
+    for (uint32_t idx = 0; idx < books.size(); ++idx) {
+      const auto &entry = books[idx];
+      const auto priceIt = refPrices.find(entry.ticker);
+      if (priceIt == refPrices.end()) {
+        LOG_WARN_SYSTEM("Snapshot ticker {} is not in the db, starting empty",
+                        toString(entry.ticker));
+        data.clear();
+        return false;
+      }
+      auto *tickerData =
+          data.emplace(entry.ticker, entry.worker, *nodePools_[entry.worker], priceIt->second);
+      if (tickerData == nullptr || tickerData->index != idx) {
+        LOG_WARN_SYSTEM("Snapshot slot {} is out of order, starting empty", idx);
+        data.clear();
+        return false;
+      }
+      tickerData->orderBook.loadImage(entry.image);
+    }
+    size_t orders = 0;
+    for (ThreadId idx = 0; idx < nodePools_.size(); ++idx) {
+      snapshot_->loadPool(idx, *nodePools_[idx]);
+      orders += nodePools_[idx]->used();
+    }
+    snapshot_->invalidate();
+    LOG_INFO_SYSTEM("Restored {} books with {} orders from the snapshot", data.size(), orders);
+    return true;
+  }
+
 private:
   const ServerConfig &config_;
   DbAdapter &dbAdapter_;
 
+  NodePools nodePools_;
+  UPtr<BookSnapshot> snapshot_;
+  bool restored_{false};
   const MarketData marketData_;
 };
 
@@ -30,6 +30,8 @@ class ConsoleReader;
 class ShmTransport;
 class BoostTcpTransport;
 class BoostUdpTransport;
+class UringTcpTransport;
+class UringUdpTransport;
 
 template <typename SerializerType>
 class FixedSizeFramer;
@@ -48,10 +50,16 @@ class FbsDomainSerializer;
 namespace sbe {
 class SbeDomainSerializer;
 }
+namespace raw {
+class RawDomainSerializer;
+}
 
 #ifdef SERIALIZATION_SBE
 using DomainSerializer = serialization::sbe::SbeDomainSerializer;
 using Framer = DummyFramer<DomainSerializer>;
+#elif defined(SERIALIZATION_RAW)
+using DomainSerializer = serialization::raw::RawDomainSerializer;
+using Framer = DummyFramer<DomainSerializer>;
 #else
 using DomainSerializer = serialization::fbs::FbsDomainSerializer;
 using Framer = FixedSizeFramer<DomainSerializer>;
@@ -72,11 +80,15 @@ namespace hft::server {
 class ShmServer;
 class CommandParser;
 class BoostIpcServer;
+class UringIpcServer;
 class NetworkSessionManager;
 class TrustedSessionManager;
 struct InternalOrderEvent;
+struct InternalOrderBurst;
+struct LevelUpdateBurst;
 struct InternalOrder;
 struct InternalOrderStatus;
+struct InternalFillBatch;
 class PriceLevelOrderBook;
 
 class FlatOrderBook;
@@ -91,6 +103,11 @@ using StreamTransport = ShmTransport;
 using DatagramTransport = ShmTransport;
 using IpcServer = ShmServer;
 using SessionManager = TrustedSessionManager;
+#elif defined(COMM_URING)
+using StreamTransport = UringTcpTransport;
+using DatagramTransport = UringUdpTransport;
+using IpcServer = UringIpcServer;
+using SessionManager = NetworkSessionManager;
 #else
 using StreamTransport = BoostTcpTransport;
 using DatagramTransport = BoostUdpTransport;
@@ -100,14 +117,16 @@ using SessionManager = NetworkSessionManager;
 
 using ServerMessageBus = MessageBus<
     // directly routed messages
-    ServerOrder, ServerOrderStatus, TickerPrice, InternalOrderEvent, InternalOrderStatus>;
+    ServerOrder, ServerOrderBatch, ServerOrderStatus, TickerPrice, LevelUpdateBurst,
+    InternalOrderEvent, InternalOrderBurst, InternalOrderStatus, InternalFillBatch>;
 
 using ServerBus = BusHub<ServerMessageBus>;
 using UpstreamBus = BusRestrictor<
     // bus
     ServerBus,
     // events
-    ServerOrder, ServerLoginRequest, ChannelStatusEvent, ConnectionStatusEvent>;
+    ServerOrder, ServerOrderBatch, ServerLoginRequest, ChannelStatusEvent,
+    ConnectionStatusEvent>;
 using DownstreamBus = BusRestrictor<
     // bus
     ServerBus,
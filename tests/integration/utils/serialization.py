@@ -9,6 +9,7 @@ from hft.serialization.gen.fbs.domain import (
     Order,
     OrderStatus,
     TickerPrice,
+    TickerCode,
     MessageUnion,
 )
 
@@ -57,11 +58,11 @@ def create_order_message(
 ) -> bytes:
     builder = flatbuffers.Builder(1024)
 
-    ticker_offset = builder.CreateString(ticker)
+    ticker_code = list(ticker.encode()[:4].ljust(4, b'\0'))
 
     Order.OrderStart(builder)
     Order.OrderAddId(builder, order_id)
-    Order.OrderAddTicker(builder, ticker_offset)
+    Order.OrderAddTicker(builder, TickerCode.CreateTickerCode(builder, ticker_code))
     Order.OrderAddQuantity(builder, quantity)
     Order.OrderAddPrice(builder, price)
     Order.OrderAddAction(builder, action)
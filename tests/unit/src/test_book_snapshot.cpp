@@ -0,0 +1,168 @@
+/**
+ * @author Vladimir Pavliv
+ * @date 2026-10-17
+ */
+
+#include <filesystem>
+
+#include <gtest/gtest.h>
+
+#include "config/server_config.hpp"
+#include "gateway/order_gateway.hpp"
+#include "storage/book_snapshot.hpp"
+#include "traits.hpp"
+#include "utils/data_generator.hpp"
+#include "utils/handler.hpp"
+
+namespace hft::tests {
+
+using namespace server;
+using namespace utils;
+
+namespace {
+/**
+ * @brief Collects what the book sends to the gateway
+ */
+struct BookEvents {
+  template <typename EventT>
+  void post(CRef<EventT> event) {
+    if constexpr (std::is_constructible_v<InternalGatewayEvent, EventT>) {
+      events.emplace_back(event);
+    }
+  }
+
+  Vector<InternalGatewayEvent> events;
+};
+} // namespace
+
+/**
+ * @brief Books are written to the snapshot and loaded into fresh pools and books,
+ * the way Storage does on restart, then a new gateway rebuilds its records from them
+ */
+class BookSnapshotFixture : public ::testing::Test {
+public:
+  using SelfT = BookSnapshotFixture;
+
+  static constexpr auto PATH = "utest_book_snapshot.bin";
+  static constexpr ClientId CLIENT = 7;
+
+  const ServerConfig cfg;
+  ServerBus bus;
+  std::stop_source stopSrc;
+  Context ctx;
+
+  GenTickerData tickers;
+  GenMarketData live;
+  GenMarketData restored;
+
+  UPtr<BookSnapshot> snapshot;
+  UPtr<OrderGateway> gateway;
+
+  Vector<InternalOrderEvent> routed;
+  Vector<ServerOrderStatus> statuses;
+
+  BookSnapshotFixture()
+      : cfg{"utest_server_config.ini"}, bus{cfg.data}, ctx{bus, cfg, stopSrc.get_token()},
+        tickers{1}, live{tickers, 1}, restored{tickers} {}
+
+  void SetUp() override {
+    LOG_INIT(cfg.data);
+    std::filesystem::remove(PATH);
+    snapshot = std::make_unique<BookSnapshot>(PATH, 1, 1, *live.nodePools[0]);
+    startGateway();
+  }
+
+  void TearDown() override {
+    gateway.reset();
+    snapshot.reset();
+    std::filesystem::remove(PATH);
+  }
+
+  void startGateway() {
+    gateway.reset();
+    gateway = std::make_unique<OrderGateway>(ctx, live.marketData);
+    bus.subscribe(CRefHandler<InternalOrderEvent>::bind<SelfT, &SelfT::post>(this));
+    bus.subscribe(CRefHandler<ServerOrderStatus>::bind<SelfT, &SelfT::post>(this));
+  }
+
+  void post(CRef<InternalOrderEvent> ioe) { routed.push_back(ioe); }
+  void post(CRef<ServerOrderStatus> status) { statuses.push_back(status); }
+
+  /**
+   * @brief Sends the order through the gateway into the book and the book reply back
+   */
+  void send(MarketData &data, Order order) {
+    routed.clear();
+    bus.post(ServerOrder{CLIENT, order});
+    ASSERT_EQ(routed.size(), 1);
+    BookEvents reply;
+    data[0].orderBook.add(routed[0], reply);
+    for (const auto &event : reply.events) {
+      gateway->post(event);
+    }
+  }
+
+  void restart() {
+    snapshot->write(0, *live.nodePools[0], live.marketData);
+
+    restored.gen(1);
+    restored.marketData[0].orderBook.loadImage(snapshot->books()[0].image);
+    snapshot->loadPool(0, *restored.nodePools[0]);
+
+    startGateway();
+    gateway->restore(restored.nodePools, *snapshot);
+  }
+};
+
+TEST_F(BookSnapshotFixture, RestoredOrderFillReachesItsClient) {
+  snapshot->track(gateway->records());
+  const Ticker ticker = tickers.tickers[0];
+  send(live.marketData, Order{11, ticker, 10, 100, OrderAction::Sell, OrderType::Limit});
+  ASSERT_EQ(statuses.size(), 1);
+  ASSERT_EQ(statuses[0].orderStatus.state, OrderState::Accepted);
+  const auto restingId = statuses[0].orderStatus.systemOrderId;
+
+  restart();
+  statuses.clear();
+
+  // new order gets a fresh id, the crossing fills the restored one
+  send(restored.marketData, Order{12, ticker, 10, 100, OrderAction::Buy, OrderType::Limit});
+  ASSERT_EQ(statuses.size(), 2);
+  const auto &taker = statuses[0].orderStatus.orderId == 12 ? statuses[0] : statuses[1];
+  const auto &maker = statuses[0].orderStatus.orderId == 11 ? statuses[0] : statuses[1];
+  EXPECT_NE(taker.orderStatus.systemOrderId, restingId);
+  EXPECT_EQ(taker.orderStatus.state, OrderState::Full);
+
+  EXPECT_EQ(maker.clientId, CLIENT);
+  EXPECT_EQ(maker.orderStatus.orderId, 11);
+  EXPECT_EQ(maker.orderStatus.systemOrderId, restingId);
+  EXPECT_EQ(maker.orderStatus.quantity, 10);
+  EXPECT_EQ(maker.orderStatus.state, OrderState::Full);
+}
+
+TEST_F(BookSnapshotFixture, StaleStatusIsDropped) {
+  snapshot->track(gateway->records());
+  send(live.marketData,
+       Order{21, tickers.tickers[0], 10, 100, OrderAction::Sell, OrderType::Limit});
+  ASSERT_EQ(statuses.size(), 1);
+  const SystemOrderId id{statuses[0].orderStatus.systemOrderId};
+  statuses.clear();
+
+  // next generation of the live id and an id that was never issued
+  SystemOrderId stale = id;
+  stale.nextGen();
+  gateway->post(InternalOrderStatus{stale, BookOrderId{}, 0, 0, OrderState::Cancelled});
+  gateway->post(InternalOrderStatus{SystemOrderId::make(id.index() + 1, 1), BookOrderId{}, 0, 0,
+                                    OrderState::Full});
+  InternalFillBatch fills{100, 1, false, {{stale, 10}}};
+  gateway->post(fills);
+  EXPECT_TRUE(statuses.empty());
+
+  // the live record is still open
+  gateway->post(InternalOrderStatus{id, BookOrderId{}, 0, 0, OrderState::Cancelled});
+  ASSERT_EQ(statuses.size(), 1);
+  EXPECT_EQ(statuses[0].clientId, CLIENT);
+  EXPECT_EQ(statuses[0].orderStatus.state, OrderState::Cancelled);
+}
+
+} // namespace hft::tests
@@ -0,0 +1,142 @@
+/**
+ * @author Vladimir Pavliv
+ * @date 2026-10-17
+ */
+
+#include <functional>
+
+#include <gtest/gtest.h>
+
+#include "domain_types.hpp"
+#include "network_traits.hpp"
+#include "transport/channel.hpp"
+#include "utils/post_spy.hpp"
+
+namespace hft::tests {
+
+namespace {
+/**
+ * @brief Keeps every write and its completion, the test completes them by hand
+ */
+struct HeldWrites {
+  Vector<ByteBuffer> sent;
+  Vector<std::function<void(IoResult)>> completions;
+
+  void complete(size_t idx) {
+    completions[idx](IoResult{static_cast<uint32_t>(sent[idx].size()), IoStatus::Ok});
+  }
+};
+
+struct StubTransport {
+  HeldWrites *writes;
+
+  IoResult syncRx(ByteSpan) { return {0, IoStatus::Error}; }
+  IoResult syncTx(CByteSpan) { return {0, IoStatus::Error}; }
+  void close() {}
+
+  template <typename Callback>
+  void asyncRx(ByteSpan, Callback &&) {}
+
+  template <typename Callback>
+  void asyncTx(CByteSpan data, Callback &&clb) {
+    writes->sent.emplace_back(data.begin(), data.end());
+    writes->completions.emplace_back(std::forward<Callback>(clb));
+  }
+};
+
+using TestChannel = Channel<StubTransport, PostSpy>;
+
+auto makePrice(size_t idx) -> TickerPrice {
+  return TickerPrice{makeTicker("ABCD"), static_cast<Price>(idx + 1)};
+}
+
+/**
+ * @brief Unframes everything that went out, in the order it was written
+ */
+auto received(CRef<HeldWrites> writes) -> PostSpy {
+  PostSpy spy;
+  ByteBuffer stream;
+  for (const auto &chunk : writes.sent) {
+    stream.insert(stream.end(), chunk.begin(), chunk.end());
+  }
+  const auto res = Framer::unframe(ByteSpan{stream.data(), stream.size()}, spy);
+  EXPECT_TRUE(res);
+  EXPECT_EQ(*res, stream.size());
+  return spy;
+}
+} // namespace
+
+TEST(ChannelTest, WritesInFlightAreCoalesced) {
+  HeldWrites writes;
+  auto channel = std::make_shared<TestChannel>(StubTransport{&writes}, 1, PostSpy{});
+
+  channel->write(makePrice(0));
+  ASSERT_EQ(writes.sent.size(), 1);
+
+  // first write is not completed yet, these wait for it
+  for (size_t idx = 1; idx < 5; ++idx) {
+    channel->write(makePrice(idx));
+  }
+  ASSERT_EQ(writes.sent.size(), 1);
+
+  writes.complete(0);
+  ASSERT_EQ(writes.sent.size(), 2);
+  EXPECT_EQ(writes.sent[1].size(), 4 * writes.sent[0].size());
+
+  // nothing is pending, next write goes only after the batch completes
+  channel->write(makePrice(5));
+  ASSERT_EQ(writes.sent.size(), 2);
+  writes.complete(1);
+  ASSERT_EQ(writes.sent.size(), 3);
+  writes.complete(2);
+  ASSERT_EQ(writes.sent.size(), 3);
+
+  // idle again, written right away
+  channel->write(makePrice(6));
+  ASSERT_EQ(writes.sent.size(), 4);
+  writes.complete(3);
+
+  auto spy = received(writes);
+  ASSERT_EQ(spy.size(), 7);
+  for (size_t idx = 0; idx < spy.size(); ++idx) {
+    ASSERT_TRUE(spy.checkValue(idx, makePrice(idx)));
+  }
+  EXPECT_TRUE(channel->bus().data.empty());
+}
+
+TEST(ChannelTest, BacklogOverflowIsDropped) {
+  constexpr size_t MAX_PENDING_SIZE = 1024 * 1024;
+
+  HeldWrites writes;
+  auto channel = std::make_shared<TestChannel>(StubTransport{&writes}, 1, PostSpy{});
+
+  channel->write(makePrice(0));
+  ASSERT_EQ(writes.sent.size(), 1);
+  const size_t frameSize = writes.sent[0].size();
+  const size_t fits = MAX_PENDING_SIZE / frameSize;
+
+  for (size_t idx = 1; idx <= fits + 10; ++idx) {
+    channel->write(makePrice(idx));
+  }
+  ASSERT_EQ(writes.sent.size(), 1);
+
+  writes.complete(0);
+  ASSERT_EQ(writes.sent.size(), 2);
+  EXPECT_EQ(writes.sent[1].size(), fits * frameSize);
+  writes.complete(1);
+
+  // backlog is drained, the channel keeps writing
+  channel->write(makePrice(fits + 1));
+  ASSERT_EQ(writes.sent.size(), 3);
+  writes.complete(2);
+
+  auto spy = received(writes);
+  ASSERT_EQ(spy.size(), fits + 2);
+  for (size_t idx = 0; idx <= fits; ++idx) {
+    ASSERT_TRUE(spy.checkValue(idx, makePrice(idx)));
+  }
+  // overflowing ones are gone, not reordered
+  ASSERT_TRUE(spy.checkValue(fits + 1, makePrice(fits + 1)));
+}
+
+} // namespace hft::tests
@@ -4,11 +4,18 @@
  */
 
 #include <iostream>
+#include <numeric>
+#include <set>
 #include <thread>
 
 #include <gtest/gtest.h>
 
 #include "container_types.hpp"
+#include "containers/broadcast_ring.hpp"
+#include "containers/buffer_pool.hpp"
+#include "containers/hierarchical_bitmap.hpp"
+#include "containers/mirrored_buffer.hpp"
+#include "containers/packed_spsc.hpp"
 #include "containers/sequenced_spsc.hpp"
 #include "domain_types.hpp"
 #include "ptr_types.hpp"
@@ -55,4 +62,314 @@ TEST(SequencedSPSCTest, Basic) {
   }
 }
 
+TEST(SequencedSPSCTest, Batch) {
+  constexpr size_t SLOTS = 1024;
+  constexpr uint64_t COUNT = 100'000;
+  auto queue = std::make_unique<SequencedSPSC<SLOTS>>();
+
+  std::jthread T{[&]() {
+    uint64_t expected = 0;
+    uint64_t watchdog = 0;
+    std::array<uint64_t, 64> batch;
+    while (expected < COUNT) {
+      const size_t size = RNG::generate<size_t>(1, batch.size());
+      const size_t count = queue->readBatch(Span<uint64_t>{batch.data(), size});
+      if (count == 0) {
+        if (++watchdog > 100'000'000) {
+          FAIL() << "Timeout: Consumer stuck waiting for data";
+        }
+        asm volatile("pause" ::: "memory");
+        continue;
+      }
+      for (size_t idx = 0; idx < count; ++idx) {
+        ASSERT_EQ(batch[idx], expected++);
+      }
+    }
+  }};
+
+  Vector<uint64_t> values(COUNT);
+  std::iota(values.begin(), values.end(), 0);
+  size_t written = 0;
+  while (written < COUNT) {
+    const size_t size = std::min<size_t>(RNG::generate<size_t>(1, SLOTS * 2), COUNT - written);
+    written += queue->writeBatch(Span<const uint64_t>{values.data() + written, size});
+  }
+}
+
+TEST(SequencedSPSCTest, BatchBytes) {
+  auto queue = std::make_unique<SequencedSPSC<16>>();
+  const std::array<uint32_t, 4> values{1, 2, 3, 4};
+
+  ASSERT_EQ(queue->writeBatch(Span<const uint32_t>{values}), values.size());
+  // only whole messages are read, the third one does not fit
+  std::array<uint32_t, 4> out{};
+  const auto bytes = queue->readBatch(reinterpret_cast<uint8_t *>(out.data()), 11);
+  ASSERT_EQ(bytes, 2 * sizeof(uint32_t));
+  ASSERT_EQ(out[0], 1);
+  ASSERT_EQ(out[1], 2);
+
+  ASSERT_EQ(queue->readBatch(reinterpret_cast<uint8_t *>(out.data()), sizeof(out)),
+            2 * sizeof(uint32_t));
+  ASSERT_EQ(out[0], 3);
+  ASSERT_EQ(out[1], 4);
+
+  // run is cut to the ring size, then nothing fits until the reader frees slots
+  Vector<uint32_t> many(20, 7);
+  ASSERT_EQ(queue->writeBatch(Span<const uint32_t>{many}), 16);
+  ASSERT_EQ(queue->writeBatch(Span<const uint32_t>{many}), 0);
+}
+
+TEST(PackedSPSCTest, VariableSizeWrapAround) {
+  constexpr size_t CAPACITY = 64 * 1024;
+  constexpr uint32_t COUNT = 100'000;
+  auto queue = std::make_unique<PackedSPSC<CAPACITY>>();
+
+  // record is its size followed by the running counter bytes
+  auto makeRecord = [](uint32_t counter, Vector<uint8_t> &record) {
+    record.resize(1 + counter % 200);
+    for (size_t idx = 0; idx < record.size(); ++idx) {
+      record[idx] = static_cast<uint8_t>(counter + idx);
+    }
+  };
+
+  std::jthread T{[&]() {
+    Vector<uint8_t> expected;
+    std::array<uint8_t, 1024> buffer;
+    uint32_t counter = 0;
+    uint64_t watchdog = 0;
+    while (counter < COUNT) {
+      // sizes are known to the reader only through the counter, so read one by one
+      const uint32_t bytes = queue->read(buffer.data(), buffer.size());
+      if (bytes == 0) {
+        if (++watchdog > 100'000'000) {
+          FAIL() << "Timeout: Consumer stuck waiting for data";
+        }
+        asm volatile("pause" ::: "memory");
+        continue;
+      }
+      makeRecord(counter++, expected);
+      ASSERT_EQ(bytes, expected.size());
+      ASSERT_EQ(std::memcmp(buffer.data(), expected.data(), bytes), 0);
+    }
+  }};
+
+  Vector<uint8_t> record;
+  for (uint32_t counter = 0; counter < COUNT; ++counter) {
+    makeRecord(counter, record);
+    while (!queue->write(record.data(), record.size())) {
+      asm volatile("pause" ::: "memory");
+    }
+  }
+}
+
+TEST(PackedSPSCTest, BatchAndLimits) {
+  auto queue = std::make_unique<PackedSPSC<16 * 1024>>();
+  const std::array<uint32_t, 4> values{1, 2, 3, 4};
+
+  ASSERT_FALSE(queue->write(reinterpret_cast<const uint8_t *>(values.data()), 0));
+  for (const auto value : values) {
+    ASSERT_TRUE(queue->write(value));
+  }
+  // only whole records are read, the third one does not fit
+  std::array<uint32_t, 4> out{};
+  ASSERT_EQ(queue->readBatch(reinterpret_cast<uint8_t *>(out.data()), 11), 2 * sizeof(uint32_t));
+  ASSERT_EQ(out[0], 1);
+  ASSERT_EQ(out[1], 2);
+  ASSERT_EQ(queue->readBatch(reinterpret_cast<uint8_t *>(out.data()), sizeof(out)),
+            2 * sizeof(uint32_t));
+  ASSERT_EQ(out[0], 3);
+  ASSERT_EQ(out[1], 4);
+  ASSERT_EQ(queue->readBatch(reinterpret_cast<uint8_t *>(out.data()), sizeof(out)), 0);
+
+  // 8 byte records, the ring takes exactly capacity / 8 of them
+  size_t written = 0;
+  while (queue->write(values[0])) {
+    ++written;
+  }
+  ASSERT_EQ(written, 16 * 1024 / 8);
+}
+
+TEST(BroadcastRingTest, IndependentReaders) {
+  auto ring = std::make_unique<BroadcastRing<1024>>();
+  auto early = ring->attach();
+  ASSERT_TRUE(ring->empty(early));
+
+  for (uint64_t value = 0; value < 10; ++value) {
+    ASSERT_TRUE(ring->write(value));
+  }
+  // late reader does not see the history
+  auto late = ring->attach();
+  ASSERT_TRUE(ring->empty(late));
+  ASSERT_TRUE(ring->write(uint64_t{10}));
+
+  uint64_t value = 0;
+  for (uint64_t expected = 0; expected <= 10; ++expected) {
+    ASSERT_EQ(ring->read(early, value), sizeof(uint64_t));
+    ASSERT_EQ(value, expected);
+  }
+  ASSERT_EQ(ring->read(early, value), 0);
+  ASSERT_EQ(ring->read(late, value), sizeof(uint64_t));
+  ASSERT_EQ(value, 10);
+  ASSERT_EQ(early.lapped, 0);
+  ASSERT_EQ(late.lapped, 0);
+}
+
+TEST(BroadcastRingTest, LappedReaderSkipsAhead) {
+  constexpr uint64_t SLOTS = 64;
+  auto ring = std::make_unique<BroadcastRing<SLOTS>>();
+  auto cursor = ring->attach();
+
+  for (uint64_t value = 0; value < SLOTS + 10; ++value) {
+    ASSERT_TRUE(ring->write(value));
+  }
+  // reader is put at the newest message
+  uint64_t value = 0;
+  ASSERT_EQ(ring->read(cursor, value), 0);
+  ASSERT_EQ(cursor.lapped, SLOTS + 9);
+  ASSERT_EQ(ring->read(cursor, value), sizeof(uint64_t));
+  ASSERT_EQ(value, SLOTS + 9);
+  ASSERT_EQ(ring->read(cursor, value), 0);
+}
+
+TEST(BroadcastRingTest, ConcurrentReaders) {
+  constexpr uint64_t COUNT = 200'000;
+  auto ring = std::make_unique<BroadcastRing<1024>>();
+
+  // readers check that whatever they get is in order and never torn
+  auto readerFunc = [&](BroadcastRing<1024>::Cursor cursor) {
+    std::array<uint64_t, 4> msg{};
+    uint64_t last = 0;
+    uint64_t watchdog = 0;
+    while (last + 1 < COUNT) {
+      if (ring->read(cursor, msg) == 0) {
+        if (++watchdog > 100'000'000) {
+          FAIL() << "Timeout: Reader stuck waiting for data";
+        }
+        asm volatile("pause" ::: "memory");
+        continue;
+      }
+      ASSERT_TRUE(msg[0] > last || last == 0);
+      ASSERT_EQ(msg[1], msg[0] * 2);
+      ASSERT_EQ(msg[3], msg[0] * 4);
+      last = msg[0];
+    }
+  };
+  std::jthread first{readerFunc, ring->attach()};
+  std::jthread second{readerFunc, ring->attach()};
+
+  for (uint64_t value = 1; value < COUNT; ++value) {
+    ASSERT_TRUE(ring->write(std::array<uint64_t, 4>{value, value * 2, value * 3, value * 4}));
+  }
+}
+
+TEST(HierarchicalBitmapTest, FindNextPrev) {
+  constexpr uint32_t BITS = 64 * 64 * 3 + 5;
+  auto bitmap = std::make_unique<HierarchicalBitmap<BITS>>();
+  std::set<uint32_t> reference;
+
+  ASSERT_TRUE(bitmap->empty());
+  ASSERT_EQ(bitmap->findNext(0), HierarchicalBitmap<BITS>::NPOS);
+  ASSERT_EQ(bitmap->findPrev(BITS - 1), HierarchicalBitmap<BITS>::NPOS);
+
+  for (int i = 0; i < 20000; ++i) {
+    const uint32_t idx = RNG::generate<uint32_t>(0, BITS - 1);
+    if (RNG::generate<uint32_t>(0, 2) == 0) {
+      bitmap->clear(idx);
+      reference.erase(idx);
+    } else {
+      bitmap->set(idx);
+      reference.insert(idx);
+    }
+
+    const uint32_t probe = RNG::generate<uint32_t>(0, BITS - 1);
+    const auto next = reference.lower_bound(probe);
+    const auto prev = reference.upper_bound(probe);
+
+    ASSERT_EQ(bitmap->test(probe), reference.contains(probe));
+    ASSERT_EQ(bitmap->findNext(probe),
+              next == reference.end() ? HierarchicalBitmap<BITS>::NPOS : *next);
+    ASSERT_EQ(bitmap->findPrev(probe),
+              prev == reference.begin() ? HierarchicalBitmap<BITS>::NPOS : *std::prev(prev));
+  }
+}
+
+TEST(MirroredBufferTest, WrapAroundStaysContiguous) {
+  MirroredBuffer buffer{4096};
+  const size_t capacity = buffer.capacity();
+  ASSERT_EQ(buffer.buffer().size(), capacity);
+
+  uint8_t next = 0;
+  uint8_t expected = 0;
+  for (int round = 0; round < 1000; ++round) {
+    auto free = buffer.buffer();
+    const size_t written = std::min<size_t>(free.size(), RNG::generate<size_t>(1, 1500));
+    for (size_t i = 0; i < written; ++i) {
+      free[i] = next++;
+    }
+    ASSERT_TRUE(buffer.commitWrite(written));
+
+    auto data = buffer.data();
+    ASSERT_EQ(data.size() + buffer.buffer().size(), capacity);
+    const size_t consumed = RNG::generate<size_t>(0, data.size());
+    for (size_t i = 0; i < consumed; ++i) {
+      ASSERT_EQ(data[i], expected++);
+    }
+    buffer.commitRead(consumed);
+  }
+  ASSERT_FALSE(buffer.commitWrite(buffer.buffer().size() + 1));
+}
+
+TEST(BufferPoolTest, GrowsBySlabsUpToLimit) {
+  using Pool = BufferPool<64, 64, 4>;
+  auto &pool = Pool::instance();
+
+  std::vector<BufferPtr> buffers;
+  std::set<uint8_t *> addresses;
+  for (uint32_t i = 0; i < Pool::POOL_SIZE * Pool::MAX_SLABS; ++i) {
+    auto buffer = pool.acquire();
+    ASSERT_TRUE(buffer);
+    ASSERT_TRUE(addresses.insert(buffer.data).second);
+    buffers.push_back(std::move(buffer));
+  }
+  ASSERT_FALSE(pool.acquire());
+
+  for (auto &buffer : buffers) {
+    pool.release(buffer.index);
+  }
+  ASSERT_TRUE(pool.acquire());
+}
+
+TEST(BufferPoolTest, CrossThreadRelease) {
+  using Pool = BufferPool<64, 1024, 2>;
+  constexpr size_t COUNT = 100'000;
+  constexpr size_t IN_FLIGHT = 1024;
+  auto &pool = Pool::instance();
+  auto queue = std::make_unique<SequencedSPSC<>>();
+  AtomicSizeT released{0};
+
+  // jthread requests stop before joining, so a failed assert below does not hang the test
+  std::jthread releaser{[&](std::stop_token stop) {
+    while (!stop.stop_requested() && released.load(std::memory_order_relaxed) < COUNT) {
+      uint32_t index;
+      if (queue->read(reinterpret_cast<uint8_t *>(&index), sizeof(index)) == 0) {
+        asm volatile("pause" ::: "memory");
+        continue;
+      }
+      pool.release(index);
+      released.fetch_add(1, std::memory_order_release);
+    }
+  }};
+
+  for (size_t i = 0; i < COUNT; ++i) {
+    while (i - released.load(std::memory_order_acquire) >= IN_FLIGHT) {
+      asm volatile("pause" ::: "memory");
+    }
+    auto buffer = pool.acquire();
+    ASSERT_TRUE(buffer);
+    while (!queue->write(reinterpret_cast<const uint8_t *>(&buffer.index), sizeof(uint32_t))) {
+      asm volatile("pause" ::: "memory");
+    }
+  }
+}
+
 } // namespace hft::tests
@@ -32,4 +32,73 @@ TEST(FbsSerializerTest, serializeDeserialize) {
   spy.printAll();
 }
 
-} // namespace hft::tests
\ No newline at end of file
+TEST(FbsSerializerTest, OrderTypeRoundTrip) {
+  PostSpy spy;
+
+  const Order order{42, makeTicker("ABCD"), 10, 500, OrderAction::Cancel, OrderType::Fok};
+  ByteBuffer buffer(128);
+
+  const size_t serSize = FbsDomainSerializer::serialize(order, buffer.data());
+  ASSERT_TRUE(serSize != 0);
+
+  const auto deserSize = FbsDomainSerializer::deserialize<PostSpy>(buffer.data(), serSize, spy);
+  ASSERT_TRUE(deserSize);
+  ASSERT_TRUE(spy.checkValue(0, order));
+  spy.printAll();
+}
+
+TEST(FbsSerializerTest, BuilderReusedAcrossMessages) {
+  PostSpy spy;
+
+  const TickerPrice price{makeTicker("EFGH"), 1234};
+  const OrderStatus status{42, 7, 10, 505, OrderState::Partial};
+  const LoginResponse response{99, false, String(100, 'e')};
+  ByteBuffer buffer(256);
+
+  for (int i = 0; i < 3; ++i) {
+    size_t serSize = FbsDomainSerializer::serialize(price, buffer.data());
+    ASSERT_TRUE(FbsDomainSerializer::deserialize<PostSpy>(buffer.data(), serSize, spy));
+
+    // does not fit the builder storage, goes through the heap and fails the write
+    serSize = FbsDomainSerializer::serialize(response, buffer.data());
+    ASSERT_EQ(serSize, 0);
+
+    serSize = FbsDomainSerializer::serialize(status, buffer.data());
+    ASSERT_TRUE(FbsDomainSerializer::deserialize<PostSpy>(buffer.data(), serSize, spy));
+  }
+  ASSERT_EQ(spy.size(), 6);
+  ASSERT_TRUE(spy.checkValue(4, price));
+  ASSERT_TRUE(spy.checkValue(5, status));
+}
+
+TEST(FbsSerializerTest, OversizedMessageLeavesBufferIntact) {
+  const LoginRequest request{String(FbsDomainSerializer::MAX_MESSAGE_SIZE, 'n'), "password"};
+  ByteBuffer buffer(FbsDomainSerializer::MAX_MESSAGE_SIZE + 8, 0xAB);
+
+  ASSERT_EQ(FbsDomainSerializer::serialize(request, buffer.data()), 0);
+  for (size_t idx = FbsDomainSerializer::MAX_MESSAGE_SIZE; idx < buffer.size(); ++idx) {
+    ASSERT_EQ(buffer[idx], 0xAB);
+  }
+}
+
+TEST(FbsSerializerTest, OrderBatchRoundTrip) {
+  PostSpy spy;
+
+  OrderBatch batch;
+  for (uint32_t idx = 0; idx < ORDER_BATCH_CAPACITY; ++idx) {
+    batch.orders[batch.count++] =
+        Order{idx + 1, makeTicker("ABCD"), 10 + idx, 500 + idx, OrderAction::Sell, OrderType::Ioc};
+  }
+  ByteBuffer buffer(4096);
+
+  const size_t serSize = FbsDomainSerializer::serialize(batch, buffer.data());
+  ASSERT_LE(serSize, FbsDomainSerializer::MAX_BATCH_MESSAGE_SIZE);
+
+  const auto deserSize = FbsDomainSerializer::deserialize<PostSpy>(buffer.data(), serSize, spy);
+  ASSERT_TRUE(deserSize);
+  ASSERT_EQ(*deserSize, serSize);
+  ASSERT_EQ(spy.size(), 1);
+  ASSERT_TRUE(spy.checkValue(0, batch));
+}
+
+} // namespace hft::tests
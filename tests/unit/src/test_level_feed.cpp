@@ -0,0 +1,130 @@
+/**
+ * @author Vladimir Pavliv
+ * @date 2026-10-17
+ */
+
+#include <future>
+#include <mutex>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "config/server_config.hpp"
+#include "execution/coordinator.hpp"
+#include "traits.hpp"
+#include "utils/data_generator.hpp"
+#include "utils/handler.hpp"
+
+namespace hft::tests {
+
+using namespace server;
+using namespace utils;
+
+/**
+ * @brief Running worker publishes level updates into its queue,
+ * system thread drains them and posts them as bursts
+ */
+class LevelFeedFixture : public ::testing::Test {
+public:
+  using SelfT = LevelFeedFixture;
+
+  static constexpr auto TIMEOUT = std::chrono::seconds{5};
+
+  ServerConfig cfg;
+  ServerBus bus;
+  std::stop_source stopSrc;
+  Context ctx;
+
+  GenTickerData tickers;
+  GenMarketData marketData;
+
+  UPtr<Coordinator> coordinator;
+  std::jthread systemThread;
+  std::promise<void> ready;
+
+  std::mutex lock;
+  Vector<LevelUpdate> levels;
+  Vector<std::thread::id> drainedOn;
+  AtomicUInt64 statuses{0};
+
+  LevelFeedFixture()
+      : cfg{"utest_server_config.ini"}, bus{cfg.data}, ctx{bus, cfg, stopSrc.get_token()},
+        tickers{1}, marketData{tickers, 1} {}
+
+  void SetUp() override {
+    LOG_INIT(cfg.data);
+    // single worker without pinning
+    cfg.coresApp.clear();
+
+    bus.subscribe(CRefHandler<ComponentReady>::bind<SelfT, &SelfT::post>(this));
+    bus.subscribe(CRefHandler<LevelUpdateBurst>::bind<SelfT, &SelfT::post>(this));
+    bus.subscribe(CRefHandler<InternalOrderStatus>::bind<SelfT, &SelfT::post>(this));
+    bus.subscribe(CRefHandler<InternalFillBatch>::bind<SelfT, &SelfT::post>(this));
+    systemThread = std::jthread{[this]() { bus.run(); }};
+
+    coordinator = std::make_unique<Coordinator>(ctx, marketData.marketData, marketData.nodePools);
+    coordinator->start();
+    ASSERT_EQ(ready.get_future().wait_for(TIMEOUT), std::future_status::ready);
+  }
+
+  void TearDown() override {
+    stopSrc.request_stop();
+    coordinator->stop();
+    bus.stop();
+  }
+
+  void post(CRef<ComponentReady> event) {
+    if (event.id == Component::Coordinator) {
+      ready.set_value();
+    }
+  }
+
+  void post(CRef<LevelUpdateBurst> burst) {
+    std::lock_guard guard{lock};
+    levels.insert(levels.end(), burst.levels.begin(), burst.levels.end());
+    drainedOn.push_back(std::this_thread::get_id());
+  }
+
+  void post(CRef<InternalOrderStatus>) { statuses.fetch_add(1, std::memory_order_relaxed); }
+  void post(CRef<InternalFillBatch>) {}
+
+  auto received() -> size_t {
+    std::lock_guard guard{lock};
+    return levels.size();
+  }
+
+  bool waitFor(size_t count) {
+    const auto deadline = std::chrono::steady_clock::now() + TIMEOUT;
+    while (received() < count) {
+      if (std::chrono::steady_clock::now() > deadline) {
+        return false;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    }
+    return true;
+  }
+};
+
+TEST_F(LevelFeedFixture, LevelsAreDrainedOnTheSystemThread) {
+  constexpr size_t COUNT = 3;
+  for (uint32_t idx = 0; idx < COUNT; ++idx) {
+    const InternalOrder order{SystemOrderId::make(idx + 1, 1), BookOrderId{}, 10, 100 - idx};
+    bus.post(InternalOrderEvent{order, nullptr, 0, OrderAction::Buy});
+  }
+  ASSERT_TRUE(waitFor(COUNT));
+  EXPECT_EQ(statuses.load(), COUNT);
+
+  std::lock_guard guard{lock};
+  ASSERT_EQ(levels.size(), COUNT);
+  for (const auto &id : drainedOn) {
+    EXPECT_EQ(id, systemThread.get_id());
+  }
+  // one book, so its sequence runs through all the bursts
+  for (uint32_t idx = 0; idx < COUNT; ++idx) {
+    EXPECT_EQ(levels[idx].seq, idx + 1);
+    EXPECT_EQ(levels[idx].volume, 10);
+    EXPECT_EQ(levels[idx].side, OrderAction::Buy);
+  }
+}
+
+} // namespace hft::tests
@@ -37,19 +37,24 @@ SystemOrderId syoId() {
 const OrderAction BUY = OrderAction::Buy;
 const OrderAction SELL = OrderAction::Sell;
 const Ticker tkr = genTicker();
+const TickerIdx tkrIdx = 0;
 } // namespace
 
 class OrderBookFixture : public ::testing::Test {
 public:
   const ServerConfig cfg;
+  UPtr<NodePool> pool;
   UPtr<OrderBook> book;
   Vector<InternalOrderStatus> statusq;
+  Vector<InternalFillBatch> fillq;
+  Vector<LevelUpdate> levelq;
 
   OrderBookFixture() : cfg{"utest_server_config.ini"} {}
 
   void SetUp() override {
     LOG_INIT(cfg.data);
-    book = std::make_unique<OrderBook>();
+    pool = std::make_unique<NodePool>(cfg.orderBookLimit);
+    book = std::make_unique<OrderBook>(*pool);
   }
 
   void TearDown() override {}
@@ -75,8 +80,24 @@ void OrderBookFixture::post<InternalOrderStatus>(CRef<InternalOrderStatus> event
   statusq.push_back(event);
 }
 
-auto makeOrder(uint32_t qty, uint32_t price, OrderAction action) -> InternalOrderEvent {
-  return {{syoId(), booId(), qty, price}, nullptr, tkr, action};
+template <>
+void OrderBookFixture::post<InternalFillBatch>(CRef<InternalFillBatch> event) {
+  fillq.push_back(event);
+}
+
+template <>
+void OrderBookFixture::post<LevelUpdate>(CRef<LevelUpdate> event) {
+  levelq.push_back(event);
+}
+
+auto makeOrder(uint32_t qty, uint32_t price, OrderAction action,
+               OrderType type = OrderType::Limit) -> InternalOrderEvent {
+  return {{syoId(), booId(), qty, price, type}, nullptr, tkrIdx, action};
+}
+
+auto makeAmend(CRef<InternalOrderStatus> s, uint32_t qty, uint32_t price, OrderAction action)
+    -> InternalOrderEvent {
+  return {{s.id, s.bookOId, qty, price}, nullptr, tkrIdx, action};
 }
 
 TEST_F(OrderBookFixture, OrdersWontMatch) {
@@ -129,4 +150,387 @@ TEST_F(OrderBookFixture, 10Buy1SellMatch) {
   ASSERT_EQ(statusq.size(), 10);
 }
 
+TEST_F(OrderBookFixture, ModifyQuantityDownKeepsPriority) {
+  statusq.clear();
+
+  addOrder(makeOrder(5, 50, SELL));
+  const auto first = statusq.back();
+  addOrder(makeOrder(5, 50, SELL));
+  const auto second = statusq.back();
+
+  addOrder(makeAmend(first, 3, 50, OrderAction::Modify));
+  ASSERT_EQ(statusq.back().state, OrderState::Accepted);
+  ASSERT_EQ(statusq.back().bookOId, first.bookOId);
+
+  // amended order is still first in the queue
+  addOrder(makeOrder(3, 50, BUY));
+  ASSERT_EQ(statusq.back().state, OrderState::Full);
+
+  addOrder(makeAmend(first, 0, 0, OrderAction::Cancel));
+  ASSERT_EQ(statusq.back().state, OrderState::Rejected);
+  addOrder(makeAmend(second, 0, 0, OrderAction::Cancel));
+  ASSERT_EQ(statusq.back().state, OrderState::Cancelled);
+
+  printStatusQ();
+}
+
+TEST_F(OrderBookFixture, ModifyPriceCancelReplace) {
+  statusq.clear();
+
+  addOrder(makeOrder(5, 50, SELL));
+  const auto first = statusq.back();
+  addOrder(makeOrder(5, 50, SELL));
+  const auto second = statusq.back();
+
+  // moving away and back puts the order to the end of the queue
+  addOrder(makeAmend(first, 5, 51, OrderAction::Modify));
+  ASSERT_EQ(statusq.back().state, OrderState::Accepted);
+  addOrder(makeAmend(first, 5, 50, OrderAction::Modify));
+  ASSERT_EQ(statusq.back().state, OrderState::Accepted);
+  ASSERT_EQ(statusq.back().bookOId, first.bookOId);
+
+  addOrder(makeOrder(5, 50, BUY));
+  ASSERT_EQ(statusq.back().state, OrderState::Full);
+
+  addOrder(makeAmend(second, 0, 0, OrderAction::Cancel));
+  ASSERT_EQ(statusq.back().state, OrderState::Rejected);
+  addOrder(makeAmend(first, 0, 0, OrderAction::Cancel));
+  ASSERT_EQ(statusq.back().state, OrderState::Cancelled);
+
+  printStatusQ();
+}
+
+TEST_F(OrderBookFixture, ModifyPriceCrosses) {
+  statusq.clear();
+
+  addOrder(makeOrder(2, 40, BUY));
+  addOrder(makeOrder(5, 50, SELL));
+  const auto sell = statusq.back();
+
+  addOrder(makeAmend(sell, 5, 40, OrderAction::Modify));
+  ASSERT_EQ(statusq.back().state, OrderState::Partial);
+  ASSERT_EQ(statusq.back().fillQty, 2);
+  ASSERT_EQ(statusq.back().bookOId, sell.bookOId);
+
+  addOrder(makeOrder(3, 40, BUY));
+  ASSERT_EQ(statusq.back().state, OrderState::Full);
+
+  addOrder(makeAmend(sell, 1, 40, OrderAction::Modify));
+  ASSERT_EQ(statusq.back().state, OrderState::Rejected);
+
+  printStatusQ();
+}
+
+TEST_F(OrderBookFixture, FarPriceRecentersWindow) {
+  statusq.clear();
+
+  const Price far = 1'000'000;
+  addOrder(makeOrder(5, far, SELL));
+  ASSERT_EQ(statusq.back().state, OrderState::Accepted);
+  addOrder(makeOrder(5, far + 10, SELL));
+  ASSERT_EQ(statusq.back().state, OrderState::Accepted);
+
+  // market drifts down, window follows
+  addOrder(makeOrder(5, far - MAX_TICKS / 2 - 20, BUY));
+  ASSERT_EQ(statusq.back().state, OrderState::Accepted);
+
+  addOrder(makeOrder(10, far + 10, BUY));
+  ASSERT_EQ(statusq.back().state, OrderState::Full);
+
+  addOrder(makeOrder(5, far - MAX_TICKS / 2 - 20, SELL));
+  ASSERT_EQ(statusq.back().state, OrderState::Full);
+
+  printStatusQ();
+}
+
+TEST_F(OrderBookFixture, OverflowOrdersMatchAndCancel) {
+  statusq.clear();
+
+  const Price far = 1'000'000;
+  addOrder(makeOrder(5, far, SELL));
+  const auto ask = statusq.back();
+
+  // too far from resting asks to fit the window
+  addOrder(makeOrder(5, 100, BUY));
+  ASSERT_EQ(statusq.back().state, OrderState::Accepted);
+  addOrder(makeOrder(5, 200, BUY));
+  const auto bid = statusq.back();
+  ASSERT_EQ(statusq.back().state, OrderState::Accepted);
+
+  addOrder(makeAmend(bid, 0, 0, OrderAction::Cancel));
+  ASSERT_EQ(statusq.back().state, OrderState::Cancelled);
+
+  addOrder(makeOrder(5, 90, SELL));
+  ASSERT_EQ(statusq.back().state, OrderState::Full);
+  addOrder(makeOrder(5, 90, SELL));
+  ASSERT_EQ(statusq.back().state, OrderState::Accepted);
+
+  addOrder(makeAmend(ask, 0, 0, OrderAction::Cancel));
+  ASSERT_EQ(statusq.back().state, OrderState::Cancelled);
+
+  printStatusQ();
+}
+
+TEST_F(OrderBookFixture, BooksShareWorkerNodePool) {
+  statusq.clear();
+
+  OrderBook other{*pool};
+  addOrder(makeOrder(5, 50, SELL));
+  const auto ask = statusq.back();
+  other.add(makeOrder(5, 40, BUY), *this);
+  const auto bid = statusq.back();
+
+  ASSERT_EQ(pool->used(), 2);
+  ASSERT_NE(ask.bookOId.index(), bid.bookOId.index());
+
+  addOrder(makeOrder(5, 50, BUY));
+  ASSERT_EQ(statusq.back().state, OrderState::Full);
+  ASSERT_EQ(pool->used(), 1);
+
+  other.add(makeAmend(bid, 0, 0, OrderAction::Cancel), *this);
+  ASSERT_EQ(statusq.back().state, OrderState::Cancelled);
+  ASSERT_EQ(pool->used(), 0);
+
+  printStatusQ();
+}
+
+TEST_F(OrderBookFixture, MakerFillsBatchedPerLevel) {
+  statusq.clear();
+  fillq.clear();
+
+  Vector<InternalOrderStatus> asks;
+  for (uint32_t idx = 0; idx < 7; ++idx) {
+    addOrder(makeOrder(2, 50, SELL));
+    asks.push_back(statusq.back());
+  }
+  addOrder(makeOrder(5, 51, SELL));
+  const auto lastAsk = statusq.back();
+
+  addOrder(makeOrder(17, 51, BUY));
+  ASSERT_EQ(statusq.back().state, OrderState::Full);
+
+  // 7 makers at 50 take two batches, partial maker at 51 goes separately
+  ASSERT_EQ(fillq.size(), 3);
+  ASSERT_EQ(fillq[0].count, InternalFillBatch::CAPACITY);
+  ASSERT_EQ(fillq[0].fillPrice, 50);
+  ASSERT_EQ(fillq[0].fills[0].id, asks[0].id);
+  ASSERT_FALSE(fillq[0].lastPartial);
+  ASSERT_EQ(fillq[1].count, 2);
+  ASSERT_EQ(fillq[1].fills[1].id, asks[6].id);
+  ASSERT_FALSE(fillq[1].lastPartial);
+  ASSERT_EQ(fillq[2].count, 1);
+  ASSERT_EQ(fillq[2].fillPrice, 51);
+  ASSERT_EQ(fillq[2].fills[0].id, lastAsk.id);
+  ASSERT_EQ(fillq[2].fills[0].fillQty, 3);
+  ASSERT_TRUE(fillq[2].lastPartial);
+
+  printStatusQ();
+}
+
+TEST_F(OrderBookFixture, IocAndMarketNeverRest) {
+  statusq.clear();
+
+  addOrder(makeOrder(3, 50, SELL));
+  addOrder(makeOrder(3, 52, SELL));
+  ASSERT_EQ(pool->used(), 2);
+
+  addOrder(makeOrder(5, 51, BUY, OrderType::Ioc));
+  ASSERT_EQ(statusq.back().state, OrderState::Cancelled);
+  ASSERT_EQ(statusq.back().fillQty, 3);
+  ASSERT_EQ(pool->used(), 1);
+
+  addOrder(makeOrder(5, 0, BUY, OrderType::Market));
+  ASSERT_EQ(statusq.back().state, OrderState::Cancelled);
+  ASSERT_EQ(statusq.back().fillQty, 3);
+  ASSERT_EQ(statusq.back().fillPrice, 52);
+  ASSERT_EQ(pool->used(), 0);
+
+  printStatusQ();
+}
+
+TEST_F(OrderBookFixture, FokFillsFullyOrNothing) {
+  statusq.clear();
+  fillq.clear();
+
+  addOrder(makeOrder(3, 50, SELL));
+  addOrder(makeOrder(3, 51, SELL));
+  addOrder(makeOrder(3, 53, SELL));
+
+  addOrder(makeOrder(7, 52, BUY, OrderType::Fok));
+  ASSERT_EQ(statusq.back().state, OrderState::Cancelled);
+  ASSERT_EQ(statusq.back().fillQty, 0);
+  ASSERT_TRUE(fillq.empty());
+  ASSERT_EQ(pool->used(), 3);
+
+  addOrder(makeOrder(7, 53, BUY, OrderType::Fok));
+  ASSERT_EQ(statusq.back().state, OrderState::Full);
+  ASSERT_EQ(pool->used(), 1);
+
+  printStatusQ();
+}
+
+TEST_F(OrderBookFixture, PostOnlyRejectedIfCrosses) {
+  statusq.clear();
+
+  addOrder(makeOrder(3, 50, SELL));
+
+  addOrder(makeOrder(3, 50, BUY, OrderType::PostOnly));
+  ASSERT_EQ(statusq.back().state, OrderState::Rejected);
+  ASSERT_EQ(pool->used(), 1);
+
+  addOrder(makeOrder(3, 49, BUY, OrderType::PostOnly));
+  ASSERT_EQ(statusq.back().state, OrderState::Accepted);
+  ASSERT_EQ(pool->used(), 2);
+
+  printStatusQ();
+}
+
+TEST_F(OrderBookFixture, ModifyPostOnlyCrossRejected) {
+  statusq.clear();
+  fillq.clear();
+
+  addOrder(makeOrder(3, 50, SELL));
+  addOrder(makeOrder(3, 49, BUY, OrderType::PostOnly));
+  const auto postOnly = statusq.back();
+  ASSERT_EQ(postOnly.state, OrderState::Accepted);
+
+  // amend carries no type, the resting one still applies
+  addOrder(makeAmend(postOnly, 3, 48, OrderAction::Modify));
+  ASSERT_EQ(statusq.back().state, OrderState::Accepted);
+  ASSERT_EQ(pool->used(), 2);
+
+  addOrder(makeAmend(postOnly, 3, 50, OrderAction::Modify));
+  ASSERT_EQ(statusq.back().state, OrderState::Rejected);
+  ASSERT_TRUE(fillq.empty());
+  ASSERT_EQ(pool->used(), 1);
+
+  // resting sell is untouched
+  addOrder(makeOrder(3, 50, BUY));
+  ASSERT_EQ(statusq.back().state, OrderState::Full);
+
+  printStatusQ();
+}
+
+TEST_F(OrderBookFixture, LevelUpdatesConflated) {
+  levelq.clear();
+
+  addOrder(makeOrder(3, 50, SELL));
+  addOrder(makeOrder(2, 50, SELL));
+  addOrder(makeOrder(4, 48, BUY));
+  ASSERT_TRUE(book->hasLevelUpdates());
+
+  book->publishLevels(tkr, *this);
+  ASSERT_FALSE(book->hasLevelUpdates());
+  ASSERT_EQ(levelq.size(), 2);
+  ASSERT_EQ(levelq[0], (LevelUpdate{tkr, 50, 1, 5, SELL}));
+  ASSERT_EQ(levelq[1], (LevelUpdate{tkr, 48, 2, 4, BUY}));
+
+  addOrder(makeOrder(1, 50, BUY));
+  addOrder(makeOrder(4, 50, BUY));
+  book->publishLevels(tkr, *this);
+  ASSERT_EQ(levelq.size(), 3);
+  ASSERT_EQ(levelq[2], (LevelUpdate{tkr, 50, 3, 0, SELL}));
+
+  book->publishLevels(tkr, *this);
+  ASSERT_EQ(levelq.size(), 3);
+}
+
+TEST_F(OrderBookFixture, RecenterKeepsLevelUpdatesUnique) {
+  levelq.clear();
+
+  const Price far = 1'000'000;
+  const Price low = far - MAX_TICKS / 2 - 20;
+  addOrder(makeOrder(5, far, SELL));
+  // window moves down, level at far is still pending
+  addOrder(makeOrder(5, low, BUY));
+  addOrder(makeOrder(2, far, SELL));
+  addOrder(makeOrder(3, low, BUY));
+
+  book->publishLevels(tkr, *this);
+  ASSERT_EQ(levelq.size(), 2);
+  ASSERT_EQ(levelq[0], (LevelUpdate{tkr, far, 1, 7, SELL}));
+  ASSERT_EQ(levelq[1], (LevelUpdate{tkr, low, 2, 8, BUY}));
+
+  // book is emptied, levels stay pending
+  addOrder(makeOrder(8, low, SELL));
+  addOrder(makeOrder(1, far - 1, BUY));
+  addOrder(makeOrder(1, far - 1, SELL));
+  addOrder(makeOrder(7, far, BUY));
+  // window moves away from far - 1, the new level takes its slot
+  const Price lower = far - 1 - MAX_TICKS;
+  addOrder(makeOrder(4, lower, BUY));
+  addOrder(makeOrder(1, lower, BUY));
+  addOrder(makeOrder(2, low, BUY));
+
+  book->publishLevels(tkr, *this);
+  ASSERT_EQ(levelq.size(), 6);
+  ASSERT_EQ(levelq[2], (LevelUpdate{tkr, low, 3, 2, BUY}));
+  ASSERT_EQ(levelq[3], (LevelUpdate{tkr, far - 1, 4, 0, BUY}));
+  ASSERT_EQ(levelq[4], (LevelUpdate{tkr, far, 5, 0, SELL}));
+  ASSERT_EQ(levelq[5], (LevelUpdate{tkr, lower, 6, 5, BUY}));
+  ASSERT_FALSE(book->hasLevelUpdates());
+}
+
+TEST_F(OrderBookFixture, ImageRestoresBookAndPool) {
+  statusq.clear();
+
+  addOrder(makeOrder(3, 50, SELL));
+  addOrder(makeOrder(2, 51, SELL));
+  addOrder(makeOrder(4, 48, BUY));
+
+  Vector<uint8_t> poolImage(pool->imageSize());
+  Vector<uint8_t> bookImage(OrderBook::IMAGE_SIZE);
+  pool->saveImage(poolImage.data());
+  book->saveImage(bookImage.data());
+
+  auto restoredPool = std::make_unique<NodePool>(cfg.orderBookLimit);
+  auto restoredBook = std::make_unique<OrderBook>(*restoredPool);
+  restoredPool->loadImage(poolImage.data());
+  restoredBook->loadImage(bookImage.data());
+  ASSERT_EQ(restoredPool->used(), 3);
+
+  pool = std::move(restoredPool);
+  book = std::move(restoredBook);
+
+  addOrder(makeOrder(5, 51, BUY));
+  ASSERT_EQ(statusq.back().state, OrderState::Full);
+  ASSERT_EQ(statusq.back().fillQty, 5);
+  ASSERT_EQ(pool->used(), 1);
+
+  printStatusQ();
+}
+
+TEST_F(OrderBookFixture, TakeOverKeepsPriorityAndOldIds) {
+  statusq.clear();
+  fillq.clear();
+
+  addOrder(makeOrder(3, 50, SELL));
+  addOrder(makeOrder(2, 50, SELL));
+  addOrder(makeOrder(4, 48, BUY));
+  const auto restingBuy = statusq.back();
+
+  auto otherPool = std::make_unique<NodePool>(cfg.orderBookLimit);
+  OrderBook otherBook{*otherPool};
+  otherBook.add(makeOrder(1, 60, SELL), *this);
+
+  book->handOff();
+  ASSERT_EQ(pool->used(), 0);
+  ASSERT_TRUE(book->takeOver(*otherPool, *this));
+  ASSERT_EQ(otherPool->used(), 4);
+
+  addOrder(makeAmend(restingBuy, 0, 48, OrderAction::Cancel));
+  ASSERT_EQ(statusq.back().state, OrderState::Cancelled);
+  ASSERT_EQ(otherPool->used(), 3);
+
+  addOrder(makeOrder(4, 50, BUY));
+  ASSERT_EQ(statusq.back().state, OrderState::Full);
+  ASSERT_EQ(fillq.size(), 1);
+  ASSERT_EQ(fillq[0].count, 2);
+  ASSERT_EQ(fillq[0].fills[0].fillQty, 3);
+  ASSERT_EQ(fillq[0].fills[1].fillQty, 1);
+  ASSERT_TRUE(fillq[0].lastPartial);
+
+  printStatusQ();
+}
+
 } // namespace hft::tests
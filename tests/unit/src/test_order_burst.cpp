@@ -0,0 +1,119 @@
+/**
+ * @author Vladimir Pavliv
+ * @date 2026-10-17
+ */
+
+#include <gtest/gtest.h>
+
+#include "config/server_config.hpp"
+#include "execution/coordinator.hpp"
+#include "gateway/order_gateway.hpp"
+#include "traits.hpp"
+#include "utils/data_generator.hpp"
+#include "utils/handler.hpp"
+
+namespace hft::tests {
+
+using namespace server;
+using namespace utils;
+
+/**
+ * @brief Order batch goes through the gateway, its burst is staged by the coordinator
+ * without running the workers, so per worker order can be checked directly
+ */
+class OrderBurstFixture : public ::testing::Test {
+public:
+  using SelfT = OrderBurstFixture;
+
+  static constexpr size_t WORKERS = 2;
+  static constexpr size_t TICKERS = 3;
+
+  const ServerConfig cfg;
+  ServerBus bus;
+  std::stop_source stopSrc;
+  Context ctx;
+
+  GenTickerData tickers;
+  GenMarketData marketData;
+
+  UPtr<OrderGateway> gateway;
+  UPtr<Coordinator> coordinator;
+
+  Vector<Vector<InternalOrderEvent>> staged;
+  Vector<ServerOrderStatus> statuses;
+
+  OrderBurstFixture()
+      : cfg{"utest_server_config.ini"}, bus{cfg.data}, ctx{bus, cfg, stopSrc.get_token()},
+        tickers{TICKERS}, marketData{tickers, WORKERS} {}
+
+  void SetUp() override {
+    LOG_INIT(cfg.data);
+    gateway = std::make_unique<OrderGateway>(ctx, marketData.marketData);
+    coordinator = std::make_unique<Coordinator>(ctx, marketData.marketData, marketData.nodePools);
+    // bus keeps one handler per type, so the burst is taken over from the coordinator here
+    bus.subscribe(CRefHandler<InternalOrderBurst>::bind<SelfT, &SelfT::post>(this));
+    bus.subscribe(CRefHandler<ServerOrderStatus>::bind<SelfT, &SelfT::post>(this));
+  }
+
+  void post(CRef<InternalOrderBurst> burst) { staged = coordinator->stageBurst(burst); }
+  void post(CRef<ServerOrderStatus> status) { statuses.push_back(status); }
+
+  auto order(TickerIdx idx, Quantity quantity) const -> Order {
+    return Order{genId(), tickers.tickers[idx], quantity, 100, OrderAction::Buy, OrderType::Limit};
+  }
+};
+
+TEST_F(OrderBurstFixture, MixedBatchIsStagedPerWorkerInOrder) {
+  // tickers are spread round robin, 0 and 2 belong to worker 0, 1 to worker 1
+  const auto &moving = marketData.marketData[2];
+  ASSERT_EQ(moving.workerId, 0);
+  moving.moveTo.store(1, std::memory_order_release);
+
+  const Vector<Order> orders{order(0, 1), order(1, 2), order(2, 3),
+                             order(0, 4), order(2, 5), order(1, 6)};
+  bus.post(ServerOrderBatch{1, orders});
+
+  ASSERT_TRUE(statuses.empty());
+  ASSERT_EQ(staged.size(), WORKERS);
+
+  // marker goes to the old owner right where the first order of the moving book was
+  const auto &zero = staged[0];
+  ASSERT_EQ(zero.size(), 3);
+  EXPECT_EQ(zero[0].order.quantity, 1);
+  EXPECT_TRUE(zero[1].isHandoff());
+  EXPECT_EQ(zero[1].tickerIdx, 2);
+  EXPECT_EQ(zero[1].data, &moving);
+  EXPECT_EQ(zero[2].order.quantity, 4);
+
+  const auto &one = staged[1];
+  ASSERT_EQ(one.size(), 4);
+  for (size_t idx = 0; idx < one.size(); ++idx) {
+    EXPECT_FALSE(one[idx].isHandoff());
+  }
+  EXPECT_EQ(one[0].order.quantity, 2);
+  EXPECT_EQ(one[1].order.quantity, 3);
+  EXPECT_EQ(one[2].order.quantity, 5);
+  EXPECT_EQ(one[3].order.quantity, 6);
+
+  EXPECT_EQ(moving.workerId, 1);
+}
+
+TEST_F(OrderBurstFixture, NextBatchSkipsTheMarker) {
+  const auto &moving = marketData.marketData[2];
+  moving.moveTo.store(1, std::memory_order_release);
+
+  const Vector<Order> first{order(2, 1)};
+  bus.post(ServerOrderBatch{1, first});
+  ASSERT_EQ(staged[0].size(), 1);
+  ASSERT_TRUE(staged[0][0].isHandoff());
+
+  // workers are not running, so moveTo is still set, but routing already follows the new worker
+  const Vector<Order> second{order(2, 2), order(0, 3)};
+  bus.post(ServerOrderBatch{1, second});
+  ASSERT_EQ(staged[0].size(), 1);
+  EXPECT_EQ(staged[0][0].order.quantity, 3);
+  ASSERT_EQ(staged[1].size(), 1);
+  EXPECT_EQ(staged[1][0].order.quantity, 2);
+}
+
+} // namespace hft::tests
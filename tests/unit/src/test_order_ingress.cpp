@@ -0,0 +1,177 @@
+/**
+ * @author Vladimir Pavliv
+ * @date 2026-10-17
+ */
+
+#include <future>
+#include <mutex>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "config/server_config.hpp"
+#include "gateway/order_gateway.hpp"
+#include "traits.hpp"
+#include "utils/data_generator.hpp"
+#include "utils/handler.hpp"
+
+namespace hft::tests {
+
+using namespace server;
+using namespace utils;
+
+/**
+ * @brief Several network threads post orders and batches at once, the gateway thread routes
+ * them, coordinator is replaced by the fixture, so routed events are checked directly
+ */
+class OrderIngressFixture : public ::testing::Test {
+public:
+  using SelfT = OrderIngressFixture;
+
+  static constexpr auto TIMEOUT = std::chrono::seconds{5};
+  static constexpr size_t NETWORK_THREADS = 3;
+  static constexpr size_t ORDERS = 3000;
+  static constexpr size_t BATCH = 4;
+  static constexpr Price BASE_PRICE = 100;
+
+  ServerConfig cfg;
+  ServerBus bus;
+  std::stop_source stopSrc;
+  Context ctx;
+
+  GenTickerData tickers;
+  GenMarketData marketData;
+
+  UPtr<OrderGateway> gateway;
+  std::jthread systemThread;
+  std::promise<void> ready;
+
+  std::mutex lock;
+  // routed quantities per network thread, every thread sends its own price
+  Vector<Vector<Quantity>> routed = Vector<Vector<Quantity>>(NETWORK_THREADS);
+  Vector<size_t> bursts;
+  Vector<std::thread::id> routedOn;
+  size_t mixedBursts{0};
+  size_t total{0};
+
+  OrderIngressFixture()
+      : cfg{"utest_server_config.ini"}, bus{cfg.data}, ctx{bus, cfg, stopSrc.get_token()},
+        tickers{1}, marketData{tickers, 1} {}
+
+  void SetUp() override {
+    LOG_INIT(cfg.data);
+    cfg.coreGateway.reset();
+    // one network thread of its own and two extra ones
+    cfg.coresNetwork = {0, 0};
+
+    bus.subscribe(CRefHandler<ComponentReady>::bind<SelfT, &SelfT::post>(this));
+    bus.subscribe(CRefHandler<InternalOrderEvent>::bind<SelfT, &SelfT::post>(this));
+    bus.subscribe(CRefHandler<InternalOrderBurst>::bind<SelfT, &SelfT::post>(this));
+    bus.subscribe(CRefHandler<ServerOrderStatus>::bind<SelfT, &SelfT::post>(this));
+    systemThread = std::jthread{[this]() { bus.run(); }};
+
+    gateway = std::make_unique<OrderGateway>(ctx, marketData.marketData);
+    gateway->start();
+    ASSERT_EQ(ready.get_future().wait_for(TIMEOUT), std::future_status::ready);
+  }
+
+  void TearDown() override {
+    stopSrc.request_stop();
+    gateway->stop();
+    bus.stop();
+  }
+
+  void post(CRef<ComponentReady> event) {
+    if (event.id == Component::Gateway) {
+      ready.set_value();
+    }
+  }
+
+  void post(CRef<InternalOrderEvent> ioe) {
+    std::lock_guard guard{lock};
+    record(ioe);
+  }
+
+  void post(CRef<InternalOrderBurst> burst) {
+    std::lock_guard guard{lock};
+    bursts.push_back(burst.events.size());
+    for (const auto &ioe : burst.events) {
+      mixedBursts += ioe.order.price != burst.events.front().order.price;
+      record(ioe);
+    }
+  }
+
+  void post(CRef<ServerOrderStatus>) { FAIL() << "No order should be rejected"; }
+
+  void record(CRef<InternalOrderEvent> ioe) {
+    routed[ioe.order.price - BASE_PRICE].push_back(ioe.order.quantity);
+    routedOn.push_back(std::this_thread::get_id());
+    ++total;
+  }
+
+  /**
+   * @brief Network thread, single orders and batches in turns, quantity is the sequence number
+   */
+  void send(size_t thread) {
+    const Price price = BASE_PRICE + thread;
+    Quantity seq = 0;
+    const auto next = [&]() {
+      return Order{genId(), tickers.tickers[0], ++seq, price, OrderAction::Buy, OrderType::Limit};
+    };
+    while (seq < ORDERS) {
+      bus.post(ServerOrder{static_cast<ClientId>(thread), next()});
+      Vector<Order> batch;
+      while (batch.size() < BATCH && seq < ORDERS) {
+        batch.push_back(next());
+      }
+      bus.post(ServerOrderBatch{static_cast<ClientId>(thread), batch});
+    }
+  }
+
+  bool waitFor(size_t count) {
+    const auto deadline = std::chrono::steady_clock::now() + TIMEOUT;
+    while (true) {
+      {
+        std::lock_guard guard{lock};
+        if (total >= count) {
+          return true;
+        }
+      }
+      if (std::chrono::steady_clock::now() > deadline) {
+        return false;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    }
+  }
+};
+
+TEST_F(OrderIngressFixture, NetworkThreadsAreRoutedByTheGatewayThread) {
+  Vector<std::jthread> threads;
+  for (size_t thread = 0; thread < NETWORK_THREADS; ++thread) {
+    threads.emplace_back([this, thread]() { send(thread); });
+  }
+  threads.clear();
+  ASSERT_TRUE(waitFor(NETWORK_THREADS * ORDERS));
+
+  std::lock_guard guard{lock};
+  EXPECT_EQ(total, NETWORK_THREADS * ORDERS);
+  // orders of every thread keep their order
+  for (const auto &quantities : routed) {
+    ASSERT_EQ(quantities.size(), ORDERS);
+    for (size_t idx = 0; idx < quantities.size(); ++idx) {
+      ASSERT_EQ(quantities[idx], idx + 1);
+    }
+  }
+  // batches stay whole and never mix with another thread
+  EXPECT_EQ(mixedBursts, 0);
+  for (const auto size : bursts) {
+    EXPECT_EQ(size, BATCH);
+  }
+  EXPECT_FALSE(bursts.empty());
+  const auto gatewayThread = routedOn.front();
+  for (const auto &id : routedOn) {
+    ASSERT_EQ(id, gatewayThread);
+  }
+}
+
+} // namespace hft::tests
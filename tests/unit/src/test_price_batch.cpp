@@ -0,0 +1,127 @@
+/**
+ * @author Vladimir Pavliv
+ * @date 2026-02-16
+ */
+
+#include <gtest/gtest.h>
+
+#include "ipc/price_publisher.hpp"
+#include "transport/boost/boost_udp_transport.hpp"
+#include "transport/price_batch.hpp"
+#include "utils/data_generator.hpp"
+#include "utils/test_utils.hpp"
+
+namespace hft::tests {
+
+using namespace utils;
+
+TEST(PriceBatchTest, SequencerCountsGaps) {
+  PriceSequencer sequencer;
+  ASSERT_TRUE(sequencer.accept(5));
+  ASSERT_TRUE(sequencer.accept(6));
+  ASSERT_EQ(sequencer.lost(), 0);
+
+  ASSERT_TRUE(sequencer.accept(9));
+  ASSERT_EQ(sequencer.lost(), 2);
+  ASSERT_FALSE(sequencer.accept(8));
+  ASSERT_TRUE(sequencer.accept(10));
+
+  // restarted publisher
+  ASSERT_TRUE(sequencer.accept(0));
+  ASSERT_TRUE(sequencer.accept(1));
+  ASSERT_EQ(sequencer.lost(), 2);
+}
+
+TEST(PriceBatchTest, Loopback) {
+  using namespace boost::asio;
+  io_context ioCtx;
+
+  UdpSocket rxSocket(ioCtx, UdpEndpoint(ip::address_v4::loopback(), 0));
+  UdpSocket txSocket(ioCtx, Udp::v4());
+  txSocket.connect(rxSocket.local_endpoint());
+  BoostUdpTransport rx{std::move(rxSocket)};
+  BoostUdpTransport tx{std::move(txSocket)};
+
+  // two full batches and a partial one, the second one is lost on the way
+  constexpr size_t COUNT = 2 * PriceBatch::CAPACITY + 10;
+  Vector<TickerPrice> sent;
+  PriceBatch batch;
+  uint64_t dropped = 0;
+  for (size_t idx = 0; idx < COUNT; ++idx) {
+    sent.push_back(TickerPrice{genTicker(), static_cast<Price>(idx)});
+    batch.add(sent.back());
+    if (batch.full() || idx == COUNT - 1) {
+      if (batch.header.seq != 1) {
+        ASSERT_EQ(tx.syncTx(batch.bytes()).bytes, batch.size());
+      } else {
+        dropped = batch.header.count;
+      }
+      ++batch.header.seq;
+      batch.header.count = 0;
+    }
+  }
+
+  PriceSequencer sequencer;
+  Vector<TickerPrice> received;
+  PriceBatch in;
+  for (size_t datagram = 0; datagram < 2; ++datagram) {
+    const auto res = rx.syncRx(ByteSpan{reinterpret_cast<uint8_t *>(&in), sizeof(PriceBatch)});
+    ASSERT_TRUE(res);
+    ASSERT_TRUE(in.valid(res.bytes));
+    ASSERT_TRUE(sequencer.accept(in.header.seq));
+    received.insert(received.end(), in.items, in.items + in.header.count);
+  }
+  ASSERT_EQ(sequencer.lost(), 1);
+  ASSERT_EQ(received.size(), COUNT - dropped);
+  ASSERT_EQ(received.front(), sent.front());
+  ASSERT_EQ(received.back(), sent.back());
+}
+
+TEST(PriceBatchTest, PublisherSendsLevelsInTheSameSequence) {
+  using namespace boost::asio;
+  using namespace server;
+  io_context ioCtx;
+  UdpSocket rxSocket(ioCtx, UdpEndpoint(ip::address_v4::loopback(), 0));
+  UdpSocket txSocket(ioCtx, Udp::v4());
+  txSocket.connect(rxSocket.local_endpoint());
+  BoostUdpTransport rx{std::move(rxSocket)};
+  PricePublisher<BoostUdpTransport> publisher{BoostUdpTransport{std::move(txSocket)}};
+
+  const Ticker ticker = genTicker();
+  const TickerPrice price{ticker, 100};
+  const LevelUpdate level{ticker, 99, 1, 500, OrderAction::Buy};
+  // only the first update since the flush asks for one
+  ASSERT_TRUE(publisher.post(price));
+  ASSERT_FALSE(publisher.post(level));
+  ASSERT_FALSE(publisher.post(level));
+  publisher.flush();
+  // nothing left to send
+  publisher.flush();
+
+  PriceSequencer sequencer;
+  FeedDatagram in;
+  auto res = rx.syncRx(ByteSpan{reinterpret_cast<uint8_t *>(&in), sizeof(FeedDatagram)});
+  ASSERT_TRUE(res);
+  ASSERT_EQ(in.kind(), FeedKind::Prices);
+  ASSERT_TRUE(in.prices.valid(res.bytes));
+  ASSERT_FALSE(in.levels.valid(res.bytes));
+  ASSERT_TRUE(sequencer.accept(in.prices.header.seq));
+  ASSERT_EQ(in.prices.header.count, 1);
+  ASSERT_EQ(in.prices.items[0], price);
+
+  res = rx.syncRx(ByteSpan{reinterpret_cast<uint8_t *>(&in), sizeof(FeedDatagram)});
+  ASSERT_TRUE(res);
+  ASSERT_EQ(in.kind(), FeedKind::Levels);
+  ASSERT_TRUE(in.levels.valid(res.bytes));
+  ASSERT_TRUE(sequencer.accept(in.levels.header.seq));
+  ASSERT_EQ(in.levels.header.count, 2);
+  ASSERT_EQ(in.levels.items[1], level);
+  ASSERT_EQ(sequencer.lost(), 0);
+
+  ASSERT_TRUE(publisher.post(price));
+  publisher.close();
+  publisher.flush();
+  ASSERT_TRUE(publisher.post(price));
+}
+
+} // namespace hft::tests
@@ -0,0 +1,124 @@
+/**
+ * @author Vladimir Pavliv
+ * @date 2026-02-23
+ */
+
+#include <gtest/gtest.h>
+
+#include "container_types.hpp"
+#include "domain_types.hpp"
+#include "serialization/raw/raw_domain_serializer.hpp"
+#include "transport/framing/dummy_framer.hpp"
+#include "utils/post_spy.hpp"
+
+namespace hft::tests {
+using namespace serialization::raw;
+
+TEST(RawSerializerTest, serializeDeserialize) {
+  PostSpy spy;
+
+  LoginRequest request{"name", "password"};
+  ByteBuffer buffer(128);
+
+  const size_t serSize = RawDomainSerializer::serialize(request, buffer.data());
+  ASSERT_EQ(serSize, sizeof(RawLoginRequest));
+
+  auto deserSize = RawDomainSerializer::deserialize<PostSpy>(buffer.data(), serSize, spy);
+
+  ASSERT_TRUE(deserSize);
+  ASSERT_EQ(*deserSize, serSize);
+  ASSERT_TRUE(spy.checkValue(0, request));
+}
+
+TEST(RawSerializerTest, SeveralMessagesInOneBuffer) {
+  PostSpy spy;
+
+  const Order order{42, makeTicker("ABCD"), 10, 500, OrderAction::Cancel, OrderType::Fok};
+  const OrderStatus status{42, 7, 10, 505, OrderState::Partial};
+  const TickerPrice price{makeTicker("EFGH"), 1234};
+  const LoginResponse response{99, true, "error"};
+
+  ByteBuffer buffer(256);
+  size_t size = RawDomainSerializer::serialize(order, buffer.data());
+  size += RawDomainSerializer::serialize(status, buffer.data() + size);
+  size += RawDomainSerializer::serialize(price, buffer.data() + size);
+  size += RawDomainSerializer::serialize(response, buffer.data() + size);
+
+  const auto res = DummyFramer<RawDomainSerializer>::unframe(ByteSpan{buffer.data(), size}, spy);
+  ASSERT_TRUE(res);
+  ASSERT_EQ(*res, size);
+
+  ASSERT_TRUE(spy.checkValue(0, order));
+  ASSERT_TRUE(spy.checkValue(1, status));
+  ASSERT_TRUE(spy.checkValue(2, price));
+  ASSERT_TRUE(spy.checkValue(3, response));
+}
+
+TEST(RawSerializerTest, PartialMessageWaitsForTheRest) {
+  PostSpy spy;
+
+  const Order order{1, makeTicker("ABCD"), 10, 500, OrderAction::Buy, OrderType::Limit};
+  ByteBuffer buffer(128);
+  const size_t size = RawDomainSerializer::serialize(order, buffer.data());
+  const size_t cut = size / 2;
+
+  auto res = DummyFramer<RawDomainSerializer>::unframe(ByteSpan{buffer.data(), cut}, spy);
+  ASSERT_TRUE(res);
+  ASSERT_EQ(*res, 0);
+  ASSERT_TRUE(spy.data.empty());
+
+  res = DummyFramer<RawDomainSerializer>::unframe(ByteSpan{buffer.data(), size}, spy);
+  ASSERT_TRUE(res);
+  ASSERT_EQ(*res, size);
+  ASSERT_TRUE(spy.checkValue(0, order));
+}
+
+TEST(RawSerializerTest, OrderBatchRoundTrip) {
+  PostSpy spy;
+
+  OrderBatch batch;
+  for (uint32_t idx = 0; idx < ORDER_BATCH_CAPACITY; ++idx) {
+    batch.orders[batch.count++] =
+        Order{idx + 1, makeTicker("ABCD"), 10 + idx, 500 + idx, OrderAction::Buy, OrderType::Ioc};
+  }
+  ByteBuffer buffer(4096);
+  const size_t size = RawDomainSerializer::serialize(batch, buffer.data());
+  ASSERT_EQ(size, sizeof(RawBatchHeader) + ORDER_BATCH_CAPACITY * sizeof(RawOrderEntry));
+
+  auto res = DummyFramer<RawDomainSerializer>::unframe(ByteSpan{buffer.data(), size - 1}, spy);
+  ASSERT_TRUE(res);
+  ASSERT_EQ(*res, 0);
+  ASSERT_TRUE(spy.data.empty());
+
+  res = DummyFramer<RawDomainSerializer>::unframe(ByteSpan{buffer.data(), size}, spy);
+  ASSERT_TRUE(res);
+  ASSERT_EQ(*res, size);
+  ASSERT_TRUE(spy.checkValue(0, batch));
+}
+
+TEST(RawSerializerTest, StatusBatchIsUnpacked) {
+  PostSpy spy;
+
+  OrderStatusBatch batch;
+  batch.statuses[batch.count++] = OrderStatus{1, 11, 10, 500, OrderState::Accepted};
+  batch.statuses[batch.count++] = OrderStatus{2, 12, 20, 505, OrderState::Full};
+  ByteBuffer buffer(128);
+  const size_t size = RawDomainSerializer::serialize(batch, buffer.data());
+
+  const auto res = RawDomainSerializer::deserialize<PostSpy>(buffer.data(), size, spy);
+  ASSERT_TRUE(res);
+  ASSERT_EQ(*res, size);
+  ASSERT_TRUE(spy.checkValue(0, batch.statuses[0]));
+  ASSERT_TRUE(spy.checkValue(1, batch.statuses[1]));
+}
+
+TEST(RawSerializerTest, UnknownTypeFails) {
+  PostSpy spy;
+
+  ByteBuffer buffer(32, 0xff);
+  const auto res = RawDomainSerializer::deserialize<PostSpy>(buffer.data(), buffer.size(), spy);
+  ASSERT_FALSE(res);
+  ASSERT_TRUE(spy.data.empty());
+}
+
+} // namespace hft::tests
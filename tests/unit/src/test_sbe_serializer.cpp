@@ -8,6 +8,7 @@
 #include "container_types.hpp"
 #include "domain_types.hpp"
 #include "serialization/sbe/sbe_domain_serializer.hpp"
+#include "transport/framing/dummy_framer.hpp"
 #include "utils/post_spy.hpp"
 
 namespace hft::tests {
@@ -71,4 +72,93 @@ TEST(SbeSerializerTest, SeveralMessagesInOneBuffer) {
   spy.printAll();
 }
 
-} // namespace hft::tests
\ No newline at end of file
+TEST(SbeSerializerTest, OrderTypeRoundTrip) {
+  PostSpy spy;
+
+  const Order order{42, makeTicker("ABCD"), 10, 500, OrderAction::Cancel, OrderType::Fok};
+  ByteBuffer buffer(128);
+
+  const size_t serSize = SbeDomainSerializer::serialize(order, buffer.data());
+  ASSERT_TRUE(serSize != 0);
+
+  const auto deserSize = SbeDomainSerializer::deserialize<PostSpy>(buffer.data(), serSize, spy);
+  ASSERT_TRUE(deserSize);
+  ASSERT_TRUE(spy.checkValue(0, order));
+  spy.printAll();
+}
+
+TEST(SbeSerializerTest, OrderBatchRoundTrip) {
+  PostSpy spy;
+
+  OrderBatch batch;
+  for (uint32_t idx = 0; idx < ORDER_BATCH_CAPACITY; ++idx) {
+    batch.orders[batch.count++] =
+        Order{idx + 1, makeTicker("ABCD"), 10 + idx, 500 + idx, OrderAction::Sell, OrderType::Ioc};
+  }
+  ByteBuffer buffer(4096);
+
+  const size_t serSize = SbeDomainSerializer::serialize(batch, buffer.data());
+  ASSERT_EQ(serSize, domain::OrderBatch::sbeBlockAndHeaderLength() +
+                         domain::OrderBatch::Orders::sbeHeaderSize() +
+                         ORDER_BATCH_CAPACITY * domain::OrderBatch::Orders::sbeBlockLength());
+
+  auto deserSize = SbeDomainSerializer::deserialize<PostSpy>(buffer.data(), serSize - 1, spy);
+  ASSERT_TRUE(deserSize);
+  ASSERT_EQ(*deserSize, 0);
+  ASSERT_TRUE(spy.data.empty());
+
+  deserSize = SbeDomainSerializer::deserialize<PostSpy>(buffer.data(), serSize, spy);
+  ASSERT_TRUE(deserSize);
+  ASSERT_EQ(*deserSize, serSize);
+  ASSERT_TRUE(spy.checkValue(0, batch));
+}
+
+TEST(SbeSerializerTest, PartialMessageWaitsForTheRest) {
+  PostSpy spy;
+
+  const Order order{1, makeTicker("ABCD"), 10, 500, OrderAction::Buy, OrderType::Limit};
+  OrderBatch batch;
+  batch.orders[batch.count++] = order;
+  batch.orders[batch.count++] = order;
+  ByteBuffer buffer(256);
+  size_t size = SbeDomainSerializer::serialize(batch, buffer.data());
+  const size_t batchSize = size;
+  size += SbeDomainSerializer::serialize(order, buffer.data() + size);
+
+  // batch followed by a part of the next header, then a part of the order body
+  for (const size_t cut : {batchSize + 3, size - 5}) {
+    spy.data.clear();
+    const auto res =
+        DummyFramer<SbeDomainSerializer>::unframe(ByteSpan{buffer.data(), cut}, spy);
+    ASSERT_TRUE(res);
+    ASSERT_EQ(*res, batchSize);
+    ASSERT_EQ(spy.size(), 1);
+    ASSERT_TRUE(spy.checkValue(0, batch));
+  }
+
+  spy.data.clear();
+  const auto res = DummyFramer<SbeDomainSerializer>::unframe(
+      ByteSpan{buffer.data() + batchSize, size - batchSize}, spy);
+  ASSERT_TRUE(res);
+  ASSERT_EQ(*res, size - batchSize);
+  ASSERT_TRUE(spy.checkValue(0, order));
+}
+
+TEST(SbeSerializerTest, StatusBatchIsUnpacked) {
+  PostSpy spy;
+
+  OrderStatusBatch batch;
+  batch.statuses[batch.count++] = OrderStatus{1, 11, 10, 500, OrderState::Accepted};
+  batch.statuses[batch.count++] = OrderStatus{2, 12, 20, 505, OrderState::Full};
+  ByteBuffer buffer(128);
+
+  const size_t serSize = SbeDomainSerializer::serialize(batch, buffer.data());
+  const auto deserSize = SbeDomainSerializer::deserialize<PostSpy>(buffer.data(), serSize, spy);
+  ASSERT_TRUE(deserSize);
+  ASSERT_EQ(*deserSize, serSize);
+  ASSERT_EQ(spy.size(), 2);
+  ASSERT_TRUE(spy.checkValue(0, batch.statuses[0]));
+  ASSERT_TRUE(spy.checkValue(1, batch.statuses[1]));
+}
+
+} // namespace hft::tests
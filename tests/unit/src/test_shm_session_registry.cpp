@@ -0,0 +1,117 @@
+/**
+ * @author Vladimir Pavliv
+ * @date 2026-10-17
+ */
+
+#include <cstring>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+#include "transport/shm/shm_session_registry.hpp"
+
+namespace hft::tests {
+
+namespace {
+/**
+ * @brief Pid of a process that has already exited and been reaped
+ */
+auto deadPid() -> uint32_t {
+  const pid_t pid = ::fork();
+  if (pid == 0) {
+    ::_exit(0);
+  }
+  ::waitpid(pid, nullptr, 0);
+  return static_cast<uint32_t>(pid);
+}
+} // namespace
+
+class ShmSessionRegistryFixture : public ::testing::Test {
+public:
+  UPtr<ShmSessionRegistry> registry = std::make_unique<ShmSessionRegistry>();
+};
+
+TEST_F(ShmSessionRegistryFixture, ClaimTakesFreeSlots) {
+  ASSERT_FALSE(registry->claim().has_value());
+  registry->open(2);
+
+  const auto first = registry->claim();
+  const auto second = registry->claim();
+  ASSERT_TRUE(first.has_value());
+  ASSERT_TRUE(second.has_value());
+  EXPECT_EQ(ShmSessionRegistry::slotOf(*first), 0);
+  EXPECT_EQ(ShmSessionRegistry::slotOf(*second), 1);
+  EXPECT_TRUE(registry->owns(*first));
+  EXPECT_TRUE(registry->owns(*second));
+
+  // both owners are alive
+  EXPECT_FALSE(registry->claim().has_value());
+}
+
+TEST_F(ShmSessionRegistryFixture, ReleasedSlotIsClaimedUnderNewClientId) {
+  registry->open(1);
+  const auto first = registry->claim();
+  ASSERT_TRUE(first.has_value());
+
+  registry->release(ShmSessionRegistry::slotOf(*first));
+  const auto second = registry->claim();
+  ASSERT_TRUE(second.has_value());
+  EXPECT_EQ(ShmSessionRegistry::slotOf(*second), 0);
+  EXPECT_NE(*second, *first);
+  EXPECT_TRUE(registry->owns(*second));
+  EXPECT_FALSE(registry->owns(*first));
+}
+
+TEST_F(ShmSessionRegistryFixture, DeadProcessSlotIsReclaimed) {
+  registry->open(1);
+  const auto dead = registry->claim();
+  ASSERT_TRUE(dead.has_value());
+  registry->slots[0].pid.store(deadPid());
+
+  const auto reclaimed = registry->claim();
+  ASSERT_TRUE(reclaimed.has_value());
+  EXPECT_EQ(ShmSessionRegistry::slotOf(*reclaimed), 0);
+  EXPECT_EQ(registry->slots[0].generation.load(), 2);
+  EXPECT_EQ(registry->slots[0].pid.load(), static_cast<uint32_t>(::getpid()));
+  EXPECT_EQ(registry->owner(0), *reclaimed);
+}
+
+TEST_F(ShmSessionRegistryFixture, StaleClientIdIsNotRouted) {
+  registry->open(1);
+  const auto dead = registry->claim();
+  ASSERT_TRUE(dead.has_value());
+  registry->slots[0].pid.store(deadPid());
+  const auto reclaimed = registry->claim();
+  ASSERT_TRUE(reclaimed.has_value());
+
+  // statuses and leftover orders of the dead client are dropped, the newcomer ones go through
+  EXPECT_FALSE(registry->owns(*dead));
+  EXPECT_TRUE(registry->owns(*reclaimed));
+  // slot index out of the registry
+  EXPECT_FALSE(registry->owns(ShmSessionRegistry::clientId(ShmSessionRegistry::SLOT_MASK, 1)));
+}
+
+TEST(ShmFeedRecordTest, TagTellsMessagesApart) {
+  const TickerPrice price{makeTicker("ABCD"), 42};
+  const LevelUpdate level{makeTicker("ABCD"), 42, 7, 100, OrderAction::Sell};
+
+  ShmFeedRecord writer;
+  ShmFeedRecord reader;
+
+  auto record = writer.pack(price);
+  std::memcpy(reader.data.data(), record.data(), record.size());
+  EXPECT_EQ(reader.type(), ShmFeedType::Price);
+  EXPECT_EQ(reader.unpack<TickerPrice>(record.size()), price);
+  EXPECT_FALSE(reader.unpack<LevelUpdate>(record.size()).has_value());
+
+  record = writer.pack(level);
+  std::memcpy(reader.data.data(), record.data(), record.size());
+  EXPECT_EQ(reader.type(), ShmFeedType::Level);
+  EXPECT_EQ(reader.unpack<LevelUpdate>(record.size()), level);
+  EXPECT_FALSE(reader.unpack<TickerPrice>(record.size()).has_value());
+  // truncated record is malformed
+  EXPECT_FALSE(reader.unpack<LevelUpdate>(record.size() - 1).has_value());
+}
+
+} // namespace hft::tests
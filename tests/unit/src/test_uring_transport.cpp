@@ -0,0 +1,203 @@
+/**
+ * @author Vladimir Pavliv
+ * @date 2026-10-17
+ */
+
+#ifdef COMM_URING
+
+#include <chrono>
+#include <future>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "transport/uring/uring_network_utils.hpp"
+#include "transport/uring/uring_reactor.hpp"
+#include "transport/uring/uring_tcp_transport.hpp"
+
+namespace hft::tests {
+
+namespace {
+constexpr auto TIMEOUT = std::chrono::seconds{5};
+
+auto pattern(size_t size) -> ByteBuffer {
+  ByteBuffer buffer(size);
+  for (size_t idx = 0; idx < size; ++idx) {
+    buffer[idx] = static_cast<uint8_t>(idx % 251);
+  }
+  return buffer;
+}
+} // namespace
+
+/**
+ * @brief Tcp pair over loopback, one end is on the running reactor, the other one is plain
+ */
+class UringTransportFixture : public ::testing::Test {
+public:
+  static constexpr size_t CHUNK = 100;
+
+  UringReactor reactor;
+  std::thread reactorThread;
+
+  UPtr<UringTcpTransport> transport;
+  int peer{-1};
+
+  ByteBuffer chunk = ByteBuffer(CHUNK);
+  ByteBuffer received;
+  Vector<uint32_t> reads;
+  std::promise<IoStatus> ended;
+
+  void SetUp() override {
+    const int listener = openSocket(SOCK_STREAM);
+    sockaddr_in addr = makeAddress(htonl(INADDR_LOOPBACK), 0);
+    socklen_t len = sizeof(addr);
+    ASSERT_EQ(::bind(listener, reinterpret_cast<const sockaddr *>(&addr), len), 0);
+    ASSERT_EQ(::listen(listener, 1), 0);
+    ASSERT_EQ(::getsockname(listener, reinterpret_cast<sockaddr *>(&addr), &len), 0);
+
+    peer = openSocket(SOCK_STREAM);
+    ASSERT_EQ(::connect(peer, reinterpret_cast<const sockaddr *>(&addr), len), 0);
+    const int fd = ::accept(listener, nullptr, nullptr);
+    ::close(listener);
+    ASSERT_GE(fd, 0);
+    configureTcpSocket(fd);
+
+    transport = std::make_unique<UringTcpTransport>(reactor, fd);
+    reactorThread = std::thread{[this]() { reactor.run(); }};
+  }
+
+  void TearDown() override {
+    if (peer >= 0) {
+      ::close(peer);
+    }
+    if (transport != nullptr) {
+      transport->close();
+    }
+    reactor.stop();
+    if (reactorThread.joinable()) {
+      reactorThread.join();
+    }
+  }
+
+  /**
+   * @brief Reads and completions belong to the reactor thread
+   */
+  template <typename Fn>
+  void dispatch(Fn &&fn) {
+    reactor.submit([](io_uring_sqe *sqe) { io_uring_prep_nop(sqe); },
+                   [fn = std::forward<Fn>(fn)](CRef<io_uring_cqe>) mutable { fn(); });
+  }
+
+  /**
+   * @brief Keeps reading in small chunks until the stream ends
+   */
+  void read() {
+    transport->asyncRx(ByteSpan{chunk.data(), chunk.size()}, [this](IoResult res) {
+      if (!res) {
+        ended.set_value(res.code);
+        return;
+      }
+      reads.push_back(res.bytes);
+      received.insert(received.end(), chunk.data(), chunk.data() + res.bytes);
+      read();
+    });
+  }
+
+  void closePeer() {
+    ::close(peer);
+    peer = -1;
+  }
+};
+
+TEST_F(UringTransportFixture, MultishotRecvStagesOverflow) {
+  // single send lands in one provided buffer, far more than a single read takes
+  const auto sent = pattern(3000);
+  const long bytes = ::send(peer, sent.data(), sent.size(), MSG_NOSIGNAL);
+  ASSERT_EQ(bytes, static_cast<long>(sent.size()));
+  closePeer();
+
+  auto status = ended.get_future();
+  dispatch([this]() { read(); });
+  ASSERT_EQ(status.wait_for(TIMEOUT), std::future_status::ready);
+
+  // staged bytes go out before the close
+  EXPECT_EQ(status.get(), IoStatus::Closed);
+  EXPECT_EQ(received, sent);
+  ASSERT_GE(reads.size(), sent.size() / CHUNK);
+  for (const auto bytes : reads) {
+    EXPECT_LE(bytes, CHUNK);
+  }
+}
+
+TEST_F(UringTransportFixture, PeerCloseEndsPendingRead) {
+  auto status = ended.get_future();
+  std::promise<void> armed;
+  dispatch([this, &armed]() {
+    read();
+    armed.set_value();
+  });
+  ASSERT_EQ(armed.get_future().wait_for(TIMEOUT), std::future_status::ready);
+  closePeer();
+
+  ASSERT_EQ(status.wait_for(TIMEOUT), std::future_status::ready);
+  EXPECT_EQ(status.get(), IoStatus::Closed);
+  EXPECT_TRUE(received.empty());
+}
+
+TEST_F(UringTransportFixture, ShortWritesAreResubmitted) {
+  // far more than both socket buffers hold, peer drains it in small reads,
+  // so sends come back short and the rest is resubmitted
+  const auto sent = pattern(64 * 1024 * 1024);
+  std::promise<IoResult> written;
+  transport->asyncTx(CByteSpan{sent.data(), sent.size()},
+                     [&written](IoResult res) { written.set_value(res); });
+
+  ByteBuffer drained;
+  drained.reserve(sent.size());
+  uint8_t buffer[16 * 1024];
+  while (drained.size() < sent.size()) {
+    const long bytes = ::recv(peer, buffer, sizeof(buffer), 0);
+    ASSERT_GT(bytes, 0);
+    drained.insert(drained.end(), buffer, buffer + bytes);
+  }
+
+  auto result = written.get_future();
+  ASSERT_EQ(result.wait_for(TIMEOUT), std::future_status::ready);
+  const auto res = result.get();
+  EXPECT_TRUE(res);
+  EXPECT_EQ(res.bytes, sent.size());
+  EXPECT_EQ(drained, sent);
+}
+
+TEST_F(UringTransportFixture, OffThreadSubmissionsComplete) {
+  // other threads only prepare sqes and wake the reactor, which submits them in batches
+  constexpr size_t COUNT = 2000;
+  constexpr size_t THREADS = 4;
+  std::atomic_size_t completed{0};
+  std::promise<void> done;
+
+  Vector<std::thread> threads;
+  for (size_t thread = 0; thread < THREADS; ++thread) {
+    threads.emplace_back([this, &completed, &done]() {
+      for (size_t idx = 0; idx < COUNT; ++idx) {
+        while (!reactor.submit([](io_uring_sqe *sqe) { io_uring_prep_nop(sqe); },
+                               [&completed, &done](CRef<io_uring_cqe>) {
+                                 if (completed.fetch_add(1) + 1 == COUNT * THREADS) {
+                                   done.set_value();
+                                 }
+                               })) {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  ASSERT_EQ(done.get_future().wait_for(TIMEOUT), std::future_status::ready);
+  EXPECT_EQ(completed.load(), COUNT * THREADS);
+}
+
+} // namespace hft::tests
+
+#endif // COMM_URING
@@ -6,6 +6,8 @@
 #ifndef HFT_TESTS_DATAGENERATOR_HPP
 #define HFT_TESTS_DATAGENERATOR_HPP
 
+#include <boost/unordered/unordered_flat_set.hpp>
+
 #include "constants.hpp"
 #include "container_types.hpp"
 #include "execution/market_data.hpp"
@@ -49,17 +51,24 @@ inline Order genOrder() { return genOrder(genTicker()); }
 inline InternalOrderEvent genInternalOrder() {
   Order o = genOrder();
   return InternalOrderEvent{
-      {SystemOrderId{o.id}, genBookOId(), o.quantity, o.price}, nullptr, o.ticker, o.action};
+      {SystemOrderId{o.id}, genBookOId(), o.quantity, o.price}, nullptr, 0, o.action};
 }
 
 struct GenTickerData {
   explicit GenTickerData(size_t count = 0) { gen(count); }
 
+  /**
+   * @brief Unique tickers, position in the vector is the ticker index
+   */
   void gen(size_t count) {
     tickers.clear();
     tickers.reserve(count);
-    for (size_t i = 0; i < count; ++i) {
-      tickers.emplace_back(genTicker());
+    boost::unordered_flat_set<Ticker, TickerHash> unique;
+    while (tickers.size() < count) {
+      const auto ticker = genTicker();
+      if (unique.insert(ticker).second) {
+        tickers.emplace_back(ticker);
+      }
     }
   }
   Vector<Ticker> tickers;
@@ -76,14 +85,15 @@ struct GenOrderData {
     orders.clear();
     orders.reserve(orderCount);
 
-    auto dataIt = tickers.tickers.begin();
+    TickerIdx tickerIdx = 0;
     for (size_t i = 0; i < orderCount; ++i) {
-      if (dataIt == tickers.tickers.end()) {
-        dataIt = tickers.tickers.begin();
+      if (tickerIdx == tickers.tickers.size()) {
+        tickerIdx = 0;
       }
-      auto o = genOrder(*dataIt++);
-      InternalOrder io{SlotId<>(i), genBookOId(), o.quantity, o.price};
-      orders.push_back(InternalOrderEvent{io, nullptr, o.ticker, o.action});
+      auto o = genOrder(tickers.tickers[tickerIdx]);
+      // generation 0 is the handoff marker
+      InternalOrder io{SlotId<>::make(i, 1), genBookOId(), o.quantity, o.price};
+      orders.push_back(InternalOrderEvent{io, nullptr, tickerIdx++, o.action});
     }
   }
 
@@ -103,9 +113,14 @@ struct GenMarketData {
     marketData.clear();
     marketData.reserve(tickers.tickers.size());
 
+    nodePools.clear();
+    for (size_t idx = 0; idx < workerCount; ++idx) {
+      nodePools.emplace_back(std::make_unique<NodePool>(MAX_BOOK_ORDERS));
+    }
+
     ThreadId workerId{0};
     for (auto &ticker : tickers.tickers) {
-      marketData.emplace(ticker, workerId);
+      marketData.emplace(ticker, workerId, *nodePools[workerId], MAX_TICKS / 2);
       if (++workerId == workerCount) {
         workerId = 0;
       }
@@ -114,11 +129,15 @@ struct GenMarketData {
 
   void cleanup() {
     for (auto &td : marketData) {
-      td.second.orderBook.clear();
+      td.orderBook.clear();
+    }
+    for (auto &pool : nodePools) {
+      pool->clear();
     }
   }
 
   GenTickerData &tickers;
+  NodePools nodePools;
   MarketData marketData;
 };
 